@@ -622,6 +622,41 @@ static VALUE GLFWimage_BPP(VALUE obj)
 	return INT2NUM(img->BytesPerPixel);
 }
 
+/* Returns number of bytes between the starts of two image rows */  
+static VALUE GLFWimage_RowStride(VALUE obj)
+{
+	GLFWimage *img;
+	Data_Get_Struct(obj,GLFWimage,img);
+	return INT2NUM(img->RowStride);
+}
+
+/* Returns number of used palette entries (GL_COLOR_INDEX images only) */  
+static VALUE GLFWimage_PaletteSize(VALUE obj)
+{
+	GLFWimage *img;
+	Data_Get_Struct(obj,GLFWimage,img);
+	return INT2NUM(img->PaletteSize);
+}
+
+/* Returns OpenGL format of the palette entries (GL_RGB or GL_RGBA) */  
+static VALUE GLFWimage_PaletteFormat(VALUE obj)
+{
+	GLFWimage *img;
+	Data_Get_Struct(obj,GLFWimage,img);
+	return INT2NUM(img->PaletteFormat);
+}
+
+/* Returns used palette entries as string, or nil */  
+static VALUE GLFWimage_Palette(VALUE obj)
+{
+	GLFWimage *img;
+	Data_Get_Struct(obj,GLFWimage,img);
+	if (img->Palette==NULL)
+		return Qnil;
+	return rb_str_new((const char *)img->Palette,
+		img->PaletteSize * (img->PaletteFormat==GL_RGBA ? 4 : 3));
+}
+
 /*
  * call-seq:
  *  glfwReadImage(filename, flags) => GLFWimage or nil
@@ -680,6 +715,45 @@ static VALUE glfw_FreeImage(VALUE obj,VALUE arg1)
 	return Qnil;
 }
 
+/*
+ * call-seq:
+ *  glfwResizeImage(GLFWimage,width,height,filter) => GLFWimage or nil
+ *
+ * Returns a resized copy of GLFWimage object
+ */
+static VALUE glfw_ResizeImage(obj,arg1,arg2,arg3,arg4)
+VALUE obj,arg1,arg2,arg3,arg4;
+{
+	GLFWimage *src, *img;
+	int ret;
+
+	Data_Get_Struct(arg1, GLFWimage, src);
+	img = ALLOC(GLFWimage);
+	ret = glfwResizeImage(src,img,NUM2INT(arg2),NUM2INT(arg3),NUM2INT(arg4));
+	if (ret==GL_FALSE) {
+		xfree(img);
+		return Qnil;
+	}
+	return Data_Wrap_Struct(GLFWimage_class,0,GLFWimage_free,img);
+}
+
+/*
+ * call-seq:
+ *  glfwWriteImage(filename,GLFWimage,flags) => true or false
+ *
+ * Writes GLFWimage object to TGA file
+ */
+static VALUE glfw_WriteImage(obj,arg1,arg2,arg3)
+VALUE obj,arg1,arg2,arg3;
+{
+	int ret;
+	GLFWimage *img;
+	Check_Type(arg1,T_STRING);
+	Data_Get_Struct(arg2, GLFWimage, img);
+	ret = glfwWriteImage(RSTRING_PTR(arg1),img,NUM2INT(arg3));
+	return GL_BOOL_TO_RUBY_BOOL(ret);
+}
+
 /*
  * call-seq:
  *  glfwLoadTexture2D(filename,flags) => true or false
@@ -726,6 +800,421 @@ VALUE obj,arg1,arg2;
 	return GL_BOOL_TO_RUBY_BOOL(ret);
 }
 
+/*
+ * call-seq:
+ *  glfwLoadPaletteTexture2D(GLFWimage) => true or false
+ *
+ * Loads palette of indexed GLFWimage object as 256x1 texture to current texturing unit
+ */
+static VALUE glfw_LoadPaletteTexture2D(VALUE obj,VALUE arg1)
+{
+	GLFWimage *img;
+	Data_Get_Struct(arg1, GLFWimage, img);
+	return GL_BOOL_TO_RUBY_BOOL(glfwLoadPaletteTexture2D(img));
+}
+
+/*
+ * call-seq:
+ *  glfwLoadTextureArray([GLFWimage,...],flags) => target or false
+ *
+ * Uploads equally sized GLFWimage objects as layers of one texture. Returns
+ * GL_TEXTURE_2D_ARRAY_EXT, or GL_TEXTURE_2D when layers were placed in an atlas
+ */
+static VALUE glfw_LoadTextureArray(obj,arg1,arg2)
+VALUE obj,arg1,arg2;
+{
+	int ret, i, count;
+	GLFWimage *layers, *img;
+	Check_Type(arg1,T_ARRAY);
+	count = (int) RARRAY_LEN(arg1);
+	layers = ALLOC_N(GLFWimage,count > 0 ? count : 1);
+	for (i=0;i<count;i++) {
+		Data_Get_Struct(rb_ary_entry(arg1,i), GLFWimage, img);
+		layers[i] = *img;
+	}
+	ret = glfwLoadTextureArray(layers,count,NUM2INT(arg2));
+	xfree(layers);
+	return ret ? INT2NUM(ret) : Qfalse;
+}
+
+/*
+ * call-seq:
+ *  glfwLoadTextureArrayFiles([filename,...],flags) => target or false
+ *
+ * Reads image files in parallel and uploads them as layers of one texture
+ */
+static VALUE glfw_LoadTextureArrayFiles(obj,arg1,arg2)
+VALUE obj,arg1,arg2;
+{
+	int ret, i, count;
+	const char **names;
+	VALUE name;
+	Check_Type(arg1,T_ARRAY);
+	count = (int) RARRAY_LEN(arg1);
+	names = ALLOC_N(const char *,count > 0 ? count : 1);
+	for (i=0;i<count;i++) {
+		name = rb_ary_entry(arg1,i);
+		Check_Type(name,T_STRING);
+		names[i] = RSTRING_PTR(name);
+	}
+	ret = glfwLoadTextureArrayFiles(names,count,NUM2INT(arg2));
+	xfree(names);
+	return ret ? INT2NUM(ret) : Qfalse;
+}
+
+/*
+ * call-seq:
+ *  glfwUpdateTextureRegion(GLFWimage,srcx,srcy,width,height,dstx,dsty,flags) => true or false
+ *
+ * Uploads a region of GLFWimage object to part of the texture bound to current texturing unit
+ */
+static VALUE glfw_UpdateTextureRegion(obj,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8)
+VALUE obj,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8;
+{
+	int ret;
+	GLFWimage *img;
+	Data_Get_Struct(arg1, GLFWimage, img);
+	ret = glfwUpdateTextureRegion(img,NUM2INT(arg2),NUM2INT(arg3),NUM2INT(arg4),NUM2INT(arg5),
+	                              NUM2INT(arg6),NUM2INT(arg7),NUM2INT(arg8));
+	return GL_BOOL_TO_RUBY_BOOL(ret);
+}
+
+/*
+ * call-seq:
+ *  glfwStreamTextureImage2D(GLFWimage,flags) => true or false
+ *
+ * Starts progressive upload of GLFWimage object to the texture bound to current texturing unit
+ */
+static VALUE glfw_StreamTextureImage2D(obj,arg1,arg2)
+VALUE obj,arg1,arg2;
+{
+	int ret;
+	GLFWimage *img;
+	Data_Get_Struct(arg1, GLFWimage, img);
+	ret = glfwStreamTextureImage2D(img,NUM2INT(arg2));
+	return GL_BOOL_TO_RUBY_BOOL(ret);
+}
+
+/*
+ * call-seq:
+ *  glfwUpdateTextureStreams(budget) => bytes uploaded
+ *
+ * Uploads pending texture data for at most budget microseconds
+ */
+static VALUE glfw_UpdateTextureStreams(VALUE obj,VALUE arg1)
+{
+	return LONG2NUM(glfwUpdateTextureStreams(NUM2INT(arg1)));
+}
+
+/*
+ * call-seq:
+ *  glfwGetTextureStreamProgress(texture) => 0.0..1.0
+ *
+ * Returns fraction of texture that has been uploaded
+ */
+static VALUE glfw_GetTextureStreamProgress(VALUE obj,VALUE arg1)
+{
+	return rb_float_new(glfwGetTextureStreamProgress(NUM2UINT(arg1)));
+}
+
+/*
+ * call-seq:
+ *  glfwCancelTextureStream(texture) => nil
+ *
+ * Stops progressive upload of texture
+ */
+static VALUE glfw_CancelTextureStream(VALUE obj,VALUE arg1)
+{
+	glfwCancelTextureStream(NUM2UINT(arg1));
+	return Qnil;
+}
+
+/*
+ * call-seq:
+ *  glfwSetTextureBudget(bytes)
+ *
+ * Sets texture memory budget (0 for no budget)
+ */
+static VALUE glfw_SetTextureBudget(VALUE obj,VALUE arg1)
+{
+	glfwSetTextureBudget(NUM2LONG(arg1));
+	return Qnil;
+}
+
+static VALUE TextureEvict_cb_ruby_func = Qnil;
+void GLFWCALL TextureEvict_cb(GLuint texture, long bytes)
+{
+	rb_funcall(TextureEvict_cb_ruby_func,call_id,2,UINT2NUM(texture),LONG2NUM(bytes));
+}
+GLFW_SET_CALLBACK_FUNC(TextureEvict)
+
+/*
+ * call-seq:
+ *  glfwTouchTexture(texture)
+ *
+ * Marks texture as most recently used
+ */
+static VALUE glfw_TouchTexture(VALUE obj,VALUE arg1)
+{
+	glfwTouchTexture(NUM2UINT(arg1));
+	return Qnil;
+}
+
+/*
+ * call-seq:
+ *  glfwForgetTexture(texture)
+ *
+ * Stops texture memory accounting for texture
+ */
+static VALUE glfw_ForgetTexture(VALUE obj,VALUE arg1)
+{
+	glfwForgetTexture(NUM2UINT(arg1));
+	return Qnil;
+}
+
+/*
+ * call-seq:
+ *  glfwGetTextureMemory(texture) => [bytes,format,compressed]
+ *
+ * Returns memory used by texture, its format and whether it is compressed
+ */
+static VALUE glfw_GetTextureMemory(VALUE obj,VALUE arg1)
+{
+	long bytes;
+	int format = 0;
+	int compressed = GL_FALSE;
+	bytes = glfwGetTextureMemory(NUM2UINT(arg1),&format,&compressed);
+	return rb_ary_new3(3,LONG2NUM(bytes),INT2NUM(format),GL_BOOL_TO_RUBY_BOOL(compressed));
+}
+
+/*
+ * call-seq:
+ *  glfwGetLeastRecentTextures(maxcount) => [texture,...]
+ *
+ * Returns least recently used textures, coldest first
+ */
+static VALUE glfw_GetLeastRecentTextures(VALUE obj,VALUE arg1)
+{
+	GLuint *list;
+	int i,count,maxcount;
+	VALUE ret;
+	maxcount = NUM2INT(arg1);
+	if (maxcount<=0)
+		return rb_ary_new();
+	list = ALLOC_N(GLuint,maxcount);
+	count = glfwGetLeastRecentTextures(list,maxcount);
+	ret = rb_ary_new2(count);
+	for(i=0;i<count;i++)
+		rb_ary_push(ret,UINT2NUM(list[i]));
+	xfree(list);
+	return ret;
+}
+
+/*
+ * call-seq:
+ *  glfwGetTextureMemoryStats() => [used,budget,count,evictions]
+ *
+ * Returns texture memory counters
+ */
+static VALUE glfw_GetTextureMemoryStats(VALUE obj)
+{
+	long used = 0;
+	long budget = 0;
+	int count = 0;
+	long evictions = 0;
+	glfwGetTextureMemoryStats(&used,&budget,&count,&evictions);
+	return rb_ary_new3(4,LONG2NUM(used),LONG2NUM(budget),INT2NUM(count),LONG2NUM(evictions));
+}
+
+/* procs of pending frame captures, in capture order */
+static VALUE Capture_cb_ruby_funcs = Qnil;
+void GLFWCALL Capture_cb(GLFWimage *img)
+{
+	VALUE func;
+	VALUE data;
+	func = rb_ary_shift(Capture_cb_ruby_funcs);
+	/* data is NULL if the frame could not be read back */
+	if (img->Data)
+		data = rb_str_new((const char *)img->Data,img->RowStride*img->Height);
+	else
+		data = Qnil;
+	rb_funcall(func,call_id,4,INT2NUM(img->Width),INT2NUM(img->Height),INT2NUM(img->Format),data);
+}
+
+/*
+ * call-seq:
+ *  glfwCaptureFrameAsync(filename) => true or false
+ *  glfwCaptureFrameAsync( Proc(width,height,format,data) ) => true or false
+ *
+ * Captures current frame without stalling, and writes it to TGA file or passes it to the supplied
+ * function a few frames later. The data rows are bottom to top. data is nil if the frame
+ * could not be read back
+ */
+static VALUE glfw_CaptureFrameAsync(VALUE obj,VALUE arg1)
+{
+	int ret;
+	if (rb_obj_is_kind_of(arg1,rb_cProc)) {
+		rb_ary_push(Capture_cb_ruby_funcs,arg1);
+		ret = glfwCaptureFrameAsync(NULL,Capture_cb);
+		if (ret!=GL_TRUE)
+			rb_ary_pop(Capture_cb_ruby_funcs);
+	} else {
+		Check_Type(arg1,T_STRING);
+		ret = glfwCaptureFrameAsync(RSTRING_PTR(arg1),NULL);
+	}
+	return GL_BOOL_TO_RUBY_BOOL(ret);
+}
+
+/*
+ * call-seq:
+ *  glfwWaitCaptures()
+ *
+ * Finishes all pending frame captures
+ */
+static VALUE glfw_WaitCaptures(VALUE obj)
+{
+	glfwWaitCaptures();
+	return Qnil;
+}
+
+/*
+ * call-seq:
+ *  glfwStartRecording(filename,flags) => true or false
+ *
+ * Starts recording every frame presented by glfwSwapBuffers to a file
+ */
+static VALUE glfw_StartRecording(obj,arg1,arg2)
+VALUE obj,arg1,arg2;
+{
+	Check_Type(arg1,T_STRING);
+	return GL_BOOL_TO_RUBY_BOOL(glfwStartRecording(RSTRING_PTR(arg1),NUM2INT(arg2)));
+}
+
+/*
+ * call-seq:
+ *  glfwStopRecording()
+ *
+ * Writes out all queued frames and closes the recording
+ */
+static VALUE glfw_StopRecording(VALUE obj)
+{
+	glfwStopRecording();
+	return Qnil;
+}
+
+/*
+ * call-seq:
+ *  glfwGetRecordingStats() => [recorded,written,dropped]
+ */
+static VALUE glfw_GetRecordingStats(VALUE obj)
+{
+	int recorded = 0, written = 0, dropped = 0;
+	glfwGetRecordingStats(&recorded,&written,&dropped);
+	return rb_ary_new3(3,INT2NUM(recorded),INT2NUM(written),INT2NUM(dropped));
+}
+
+/*
+ * call-seq:
+ *  glfwStartExport(name,slots) => true or false
+ *
+ * Starts publishing every frame presented by glfwSwapBuffers in a named shared memory ring
+ */
+static VALUE glfw_StartExport(obj,arg1,arg2)
+VALUE obj,arg1,arg2;
+{
+	Check_Type(arg1,T_STRING);
+	return GL_BOOL_TO_RUBY_BOOL(glfwStartExport(RSTRING_PTR(arg1),NUM2INT(arg2)));
+}
+
+/*
+ * call-seq:
+ *  glfwStopExport()
+ *
+ * Stops publishing frames and removes the shared memory ring
+ */
+static VALUE glfw_StopExport(VALUE obj)
+{
+	glfwStopExport();
+	return Qnil;
+}
+
+/*
+ * call-seq:
+ *  glfwGetExportStats() => [exported,skipped]
+ */
+static VALUE glfw_GetExportStats(VALUE obj)
+{
+	int exported = 0, skipped = 0;
+	glfwGetExportStats(&exported,&skipped);
+	return rb_ary_new3(2,INT2NUM(exported),INT2NUM(skipped));
+}
+
+/*
+ * call-seq:
+ *  glfwMountPack(filename) => true or false
+ *
+ * Mounts a pack file; glfwReadImage and glfwLoadTexture2D look up names in mounted packs first
+ */
+static VALUE glfw_MountPack(VALUE obj,VALUE arg1)
+{
+	Check_Type(arg1,T_STRING);
+	return GL_BOOL_TO_RUBY_BOOL(glfwMountPack(RSTRING_PTR(arg1)));
+}
+
+/*
+ * call-seq:
+ *  glfwUnmountPack(filename) => true or false
+ */
+static VALUE glfw_UnmountPack(VALUE obj,VALUE arg1)
+{
+	Check_Type(arg1,T_STRING);
+	return GL_BOOL_TO_RUBY_BOOL(glfwUnmountPack(RSTRING_PTR(arg1)));
+}
+
+/*
+ * call-seq:
+ *  glfwPollImageReload() => [GLFWimage, filename, texture] or nil
+ *
+ * Returns the next image reloaded after its file changed (needs GLFW_TEXTURE_HOT_RELOAD)
+ */
+static VALUE glfw_PollImageReload(VALUE obj)
+{
+	GLFWimage *img;
+	const char *name;
+	GLuint texture;
+	VALUE image;
+
+	img = ALLOC(GLFWimage);
+	if (glfwPollImageReload(img,&name,&texture)==GL_FALSE) {
+		xfree(img);
+		return Qnil;
+	}
+	image = Data_Wrap_Struct(GLFWimage_class,0,GLFWimage_free,img);
+	return rb_ary_new3(3,image,rb_str_new2(name),UINT2NUM(texture));
+}
+
+/*
+ * call-seq:
+ *  glfwReloadTextures() => number of updated textures
+ */
+static VALUE glfw_ReloadTextures(VALUE obj)
+{
+	return INT2NUM(glfwReloadTextures());
+}
+
+/*
+ * call-seq:
+ *  glfwUnwatchImage(filename) => nil
+ *
+ * Stops watching a file read with glfwReadImage
+ */
+static VALUE glfw_UnwatchImage(VALUE obj,VALUE arg1)
+{
+	Check_Type(arg1,T_STRING);
+	glfwUnwatchImage(RSTRING_PTR(arg1));
+	return Qnil;
+}
+
 /* API ref section 3.7 */
 
 /*
@@ -760,7 +1249,56 @@ static VALUE glfw_GetGLVersion(VALUE obj)
 }
 
 /* API ref section 3.8-3.10 
-   NOTE: GLFW Threads not implemented as ruby has its own threading */
+   NOTE: GLFW Threads not implemented as ruby has its own threading.
+   The same goes for the thread pool and task graph functions, whose jobs
+   and tasks would run on native threads without holding the GVL, and for
+   the ring buffers and synchronization objects, which Ruby's own Queue,
+   SizedQueue, Mutex and ConditionVariable cover. Only the functions that
+   inspect the threads GLFW knows about are wrapped */
+
+/*
+ * call-seq:
+ *  glfwGetThreadStats(id) => [creation_time,run_time,cpu_time,voluntary_switches,involuntary_switches] or nil
+ *
+ * Returns how long a GLFW thread has existed and how much processor time it has used.
+ * Values the system does not provide are -1
+ */
+static VALUE glfw_GetThreadStats(VALUE obj,VALUE arg1)
+{
+	GLFWthreadstats stats;
+	if (glfwGetThreadStats(NUM2INT(arg1),&stats)!=GL_TRUE)
+		return Qnil;
+	return rb_ary_new3(5,rb_float_new(stats.CreationTime),rb_float_new(stats.RunTime),
+		rb_float_new(stats.CPUTime),LONG2NUM(stats.VoluntarySwitches),
+		LONG2NUM(stats.InvoluntarySwitches));
+}
+
+/*
+ * call-seq:
+ *  glfwGetThreads() => [id,...]
+ *
+ * Returns the IDs of the threads GLFW knows about, including the main thread
+ */
+static VALUE glfw_GetThreads(VALUE obj)
+{
+	GLFWthread *list;
+	int i,count,maxcount = 16;
+	VALUE ret;
+	/* grow the list until every thread fits */
+	for(;;) {
+		list = ALLOC_N(GLFWthread,maxcount);
+		count = glfwGetThreads(list,maxcount);
+		if (count<maxcount)
+			break;
+		xfree(list);
+		maxcount *= 2;
+	}
+	ret = rb_ary_new2(count);
+	for(i=0;i<count;i++)
+		rb_ary_push(ret,INT2NUM(list[i]));
+	xfree(list);
+	return ret;
+}
 
 /* API ref section 3.11 */
 
@@ -800,6 +1338,38 @@ static VALUE glfw_GetNumberOfProcessors(VALUE obj)
 	return INT2NUM(ret);
 }
 
+/* returns the first count masks (at most GLFW_MAX_CPU_GROUPS) as an array */
+static VALUE CPU_masks_to_ruby(const unsigned int *masks,int count)
+{
+	int i;
+	VALUE ret;
+	if (count>GLFW_MAX_CPU_GROUPS)
+		count = GLFW_MAX_CPU_GROUPS;
+	ret = rb_ary_new2(count);
+	for(i=0;i<count;i++)
+		rb_ary_push(ret,UINT2NUM(masks[i]));
+	return ret;
+}
+
+/* call-seq:
+ *  glfwGetCPUTopology() => [online,usable,usable_mask,cores,core_masks,l2_masks,l3_masks] or nil
+ *
+ * Returns the processors this process may use and how they share cores and caches.
+ * Masks are bit masks as taken by glfwSetThreadAffinity, and mask arrays hold at
+ * most GLFW_MAX_CPU_GROUPS entries
+ */
+static VALUE glfw_GetCPUTopology(VALUE obj)
+{
+	GLFWcputopology topology;
+	if (glfwGetCPUTopology(&topology)!=GL_TRUE)
+		return Qnil;
+	return rb_ary_new3(7,INT2NUM(topology.OnlineCount),INT2NUM(topology.UsableCount),
+		UINT2NUM(topology.UsableMask),INT2NUM(topology.CoreCount),
+		CPU_masks_to_ruby(topology.CoreMasks,topology.CoreCount),
+		CPU_masks_to_ruby(topology.L2Masks,topology.L2GroupCount),
+		CPU_masks_to_ruby(topology.L3Masks,topology.L3GroupCount));
+}
+
 /* Hack for RDOC */
 #if 0
 /*
@@ -866,6 +1436,14 @@ VALUE glfw_SetMousePosCallback()
  * representing the new mouse wheel position
  */
 VALUE glfw_SetMouseWheelCallback()
+/*
+ * call-seq:
+ *  glfwSetTextureEvictCallback( Proc(texture,bytes) )
+ *
+ * Sets function to be executed when texture memory budget is exceeded. The supplied function takes
+ * two arguments, the least recently used texture and its size in bytes, and should free or downgrade it
+ */
+VALUE glfw_SetTextureEvictCallback()
 #endif
 
 DLLEXPORT void Init_glfw()
@@ -891,6 +1469,10 @@ DLLEXPORT void Init_glfw()
 	rb_define_method(GLFWimage_class, "Height", GLFWimage_height, 0);
 	rb_define_method(GLFWimage_class, "Format", GLFWimage_format, 0);
 	rb_define_method(GLFWimage_class, "BytesPerPixel", GLFWimage_BPP, 0);
+	rb_define_method(GLFWimage_class, "RowStride", GLFWimage_RowStride, 0);
+	rb_define_method(GLFWimage_class, "PaletteSize", GLFWimage_PaletteSize, 0);
+	rb_define_method(GLFWimage_class, "PaletteFormat", GLFWimage_PaletteFormat, 0);
+	rb_define_method(GLFWimage_class, "Palette", GLFWimage_Palette, 0);
 
 	/* register Vidmode struct class to garbage collector */
 	rb_gc_register_address(&Vidmode_class);
@@ -904,6 +1486,9 @@ DLLEXPORT void Init_glfw()
 	rb_gc_register_address(&MouseButton_cb_ruby_func);
 	rb_gc_register_address(&MousePos_cb_ruby_func);
 	rb_gc_register_address(&MouseWheel_cb_ruby_func);
+	rb_gc_register_address(&TextureEvict_cb_ruby_func);
+	Capture_cb_ruby_funcs = rb_ary_new();
+	rb_gc_register_address(&Capture_cb_ruby_funcs);
 
 	rb_global_variable(&window_title);
 
@@ -955,15 +1540,48 @@ DLLEXPORT void Init_glfw()
 	rb_define_module_function(module,"glfwReadImage", glfw_ReadImage, 2);
 	rb_define_module_function(module,"glfwReadMemoryImage", glfw_ReadMemoryImage, 2);
 	rb_define_module_function(module,"glfwFreeImage", glfw_FreeImage, 1);
+	rb_define_module_function(module,"glfwResizeImage", glfw_ResizeImage, 4);
+	rb_define_module_function(module,"glfwWriteImage", glfw_WriteImage, 3);
 	rb_define_module_function(module,"glfwLoadTexture2D", glfw_LoadTexture2D, 2);
 	rb_define_module_function(module,"glfwLoadMemoryTexture2D", glfw_LoadMemoryTexture2D, 2);
 	rb_define_module_function(module,"glfwLoadTextureImage2D", glfw_LoadTextureImage2D, 2);
+	rb_define_module_function(module,"glfwLoadPaletteTexture2D", glfw_LoadPaletteTexture2D, 1);
+	rb_define_module_function(module,"glfwLoadTextureArray", glfw_LoadTextureArray, 2);
+	rb_define_module_function(module,"glfwLoadTextureArrayFiles", glfw_LoadTextureArrayFiles, 2);
+	rb_define_module_function(module,"glfwUpdateTextureRegion", glfw_UpdateTextureRegion, 8);
+	rb_define_module_function(module,"glfwStreamTextureImage2D", glfw_StreamTextureImage2D, 2);
+	rb_define_module_function(module,"glfwUpdateTextureStreams", glfw_UpdateTextureStreams, 1);
+	rb_define_module_function(module,"glfwGetTextureStreamProgress", glfw_GetTextureStreamProgress, 1);
+	rb_define_module_function(module,"glfwCancelTextureStream", glfw_CancelTextureStream, 1);
+	rb_define_module_function(module,"glfwSetTextureBudget", glfw_SetTextureBudget, 1);
+	rb_define_module_function(module,"glfwSetTextureEvictCallback", glfw_SetTextureEvictCallback, 1);
+	rb_define_module_function(module,"glfwTouchTexture", glfw_TouchTexture, 1);
+	rb_define_module_function(module,"glfwForgetTexture", glfw_ForgetTexture, 1);
+	rb_define_module_function(module,"glfwGetTextureMemory", glfw_GetTextureMemory, 1);
+	rb_define_module_function(module,"glfwGetLeastRecentTextures", glfw_GetLeastRecentTextures, 1);
+	rb_define_module_function(module,"glfwGetTextureMemoryStats", glfw_GetTextureMemoryStats, 0);
+	rb_define_module_function(module,"glfwCaptureFrameAsync", glfw_CaptureFrameAsync, 1);
+	rb_define_module_function(module,"glfwWaitCaptures", glfw_WaitCaptures, 0);
+	rb_define_module_function(module,"glfwStartRecording", glfw_StartRecording, 2);
+	rb_define_module_function(module,"glfwStopRecording", glfw_StopRecording, 0);
+	rb_define_module_function(module,"glfwGetRecordingStats", glfw_GetRecordingStats, 0);
+	rb_define_module_function(module,"glfwStartExport", glfw_StartExport, 2);
+	rb_define_module_function(module,"glfwStopExport", glfw_StopExport, 0);
+	rb_define_module_function(module,"glfwGetExportStats", glfw_GetExportStats, 0);
+	rb_define_module_function(module,"glfwMountPack", glfw_MountPack, 1);
+	rb_define_module_function(module,"glfwUnmountPack", glfw_UnmountPack, 1);
+	rb_define_module_function(module,"glfwPollImageReload", glfw_PollImageReload, 0);
+	rb_define_module_function(module,"glfwReloadTextures", glfw_ReloadTextures, 0);
+	rb_define_module_function(module,"glfwUnwatchImage", glfw_UnwatchImage, 1);
 
 	rb_define_module_function(module,"glfwExtensionSupported", glfw_ExtensionSupported, 1);
 	rb_define_module_function(module,"glfwGetGLVersion", glfw_GetGLVersion, 0);
+	rb_define_module_function(module,"glfwGetThreadStats", glfw_GetThreadStats, 1);
+	rb_define_module_function(module,"glfwGetThreads", glfw_GetThreads, 0);
 	rb_define_module_function(module,"glfwEnable", glfw_Enable, 1);
 	rb_define_module_function(module,"glfwDisable", glfw_Disable, 1);
 	rb_define_module_function(module,"glfwGetNumberOfProcessors", glfw_GetNumberOfProcessors, 0);
+	rb_define_module_function(module,"glfwGetCPUTopology", glfw_GetCPUTopology, 0);
 
 	/* constants */
 
@@ -1096,8 +1714,15 @@ DLLEXPORT void Init_glfw()
 	rb_define_const(module, "GLFW_SYSTEM_KEYS", INT2NUM(GLFW_SYSTEM_KEYS));
 	rb_define_const(module, "GLFW_KEY_REPEAT", INT2NUM(GLFW_KEY_REPEAT));
 	rb_define_const(module, "GLFW_AUTO_POLL_EVENTS", INT2NUM(GLFW_AUTO_POLL_EVENTS));
+	rb_define_const(module, "GLFW_TEXTURE_ACCOUNTING", INT2NUM(GLFW_TEXTURE_ACCOUNTING));
+	rb_define_const(module, "GLFW_TEXTURE_HOT_RELOAD", INT2NUM(GLFW_TEXTURE_HOT_RELOAD));
+	rb_define_const(module, "GLFW_FUTEX_SYNC", INT2NUM(GLFW_FUTEX_SYNC));
 	rb_define_const(module, "GLFW_WAIT", INT2NUM(GLFW_WAIT));
 	rb_define_const(module, "GLFW_NOWAIT", INT2NUM(GLFW_NOWAIT));
+	rb_define_const(module, "GLFW_THREAD_PRIORITY_LOW", INT2NUM(GLFW_THREAD_PRIORITY_LOW));
+	rb_define_const(module, "GLFW_THREAD_PRIORITY_NORMAL", INT2NUM(GLFW_THREAD_PRIORITY_NORMAL));
+	rb_define_const(module, "GLFW_THREAD_PRIORITY_HIGH", INT2NUM(GLFW_THREAD_PRIORITY_HIGH));
+	rb_define_const(module, "GLFW_THREAD_PRIORITY_REALTIME", INT2NUM(GLFW_THREAD_PRIORITY_REALTIME));
 	rb_define_const(module, "GLFW_PRESENT", INT2NUM(GLFW_PRESENT));
 	rb_define_const(module, "GLFW_AXES", INT2NUM(GLFW_AXES));
 	rb_define_const(module, "GLFW_BUTTONS", INT2NUM(GLFW_BUTTONS));
@@ -1105,6 +1730,19 @@ DLLEXPORT void Init_glfw()
 	rb_define_const(module, "GLFW_ORIGIN_UL_BIT", INT2NUM(GLFW_ORIGIN_UL_BIT));
 	rb_define_const(module, "GLFW_BUILD_MIPMAPS_BIT", INT2NUM(GLFW_BUILD_MIPMAPS_BIT));
 	rb_define_const(module, "GLFW_ALPHA_MAP_BIT", INT2NUM(GLFW_ALPHA_MAP_BIT));
+	rb_define_const(module, "GLFW_PREMULTIPLY_ALPHA_BIT", INT2NUM(GLFW_PREMULTIPLY_ALPHA_BIT));
+	rb_define_const(module, "GLFW_EXPAND_RGBA_BIT", INT2NUM(GLFW_EXPAND_RGBA_BIT));
+	rb_define_const(module, "GLFW_ALIGN_ROWS_BIT", INT2NUM(GLFW_ALIGN_ROWS_BIT));
+	rb_define_const(module, "GLFW_RESCALE_NEAREST_POT_BIT", INT2NUM(GLFW_RESCALE_NEAREST_POT_BIT));
+	rb_define_const(module, "GLFW_INDEXED_BIT", INT2NUM(GLFW_INDEXED_BIT));
+	rb_define_const(module, "GLFW_INDEX_TEXTURE_BIT", INT2NUM(GLFW_INDEX_TEXTURE_BIT));
+	rb_define_const(module, "GLFW_TEXTURE_ATLAS_BIT", INT2NUM(GLFW_TEXTURE_ATLAS_BIT));
+	rb_define_const(module, "GLFW_BOX_FILTER", INT2NUM(GLFW_BOX_FILTER));
+	rb_define_const(module, "GLFW_TRIANGLE_FILTER", INT2NUM(GLFW_TRIANGLE_FILTER));
+	rb_define_const(module, "GLFW_LANCZOS_FILTER", INT2NUM(GLFW_LANCZOS_FILTER));
+	rb_define_const(module, "GLFW_RECORD_DELTA_BIT", INT2NUM(GLFW_RECORD_DELTA_BIT));
+	rb_define_const(module, "GLFW_RECORD_DROP_FRAMES_BIT", INT2NUM(GLFW_RECORD_DROP_FRAMES_BIT));
+	rb_define_const(module, "GLFW_MAX_CPU_GROUPS", INT2NUM(GLFW_MAX_CPU_GROUPS));
 	rb_define_const(module, "GLFW_INFINITY", INT2NUM(GLFW_INFINITY));
 
 	/* calls Glfw.glfwTerminate() at ruby exit */
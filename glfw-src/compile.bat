@@ -87,6 +87,8 @@ REM ----------------------------------------------------------------------
 :Cleanup
 
 REM Library object files
+IF EXIST .\lib\win32\capture.o            del .\lib\win32\capture.o
+IF EXIST .\lib\win32\export.o             del .\lib\win32\export.o
 IF EXIST .\lib\win32\enable.o             del .\lib\win32\enable.o
 IF EXIST .\lib\win32\fullscreen.o         del .\lib\win32\fullscreen.o
 IF EXIST .\lib\win32\glext.o              del .\lib\win32\glext.o
@@ -94,7 +96,16 @@ IF EXIST .\lib\win32\image.o              del .\lib\win32\image.o
 IF EXIST .\lib\win32\init.o               del .\lib\win32\init.o
 IF EXIST .\lib\win32\input.o              del .\lib\win32\input.o
 IF EXIST .\lib\win32\joystick.o           del .\lib\win32\joystick.o
+IF EXIST .\lib\win32\pack.o               del .\lib\win32\pack.o
+IF EXIST .\lib\win32\pool.o               del .\lib\win32\pool.o
+IF EXIST .\lib\win32\record.o             del .\lib\win32\record.o
+IF EXIST .\lib\win32\reload.o             del .\lib\win32\reload.o
+IF EXIST .\lib\win32\resample.o           del .\lib\win32\resample.o
+IF EXIST .\lib\win32\ring.o               del .\lib\win32\ring.o
 IF EXIST .\lib\win32\stream.o             del .\lib\win32\stream.o
+IF EXIST .\lib\win32\sync.o               del .\lib\win32\sync.o
+IF EXIST .\lib\win32\texarray.o           del .\lib\win32\texarray.o
+IF EXIST .\lib\win32\texture.o            del .\lib\win32\texture.o
 IF EXIST .\lib\win32\tga.o                del .\lib\win32\tga.o
 IF EXIST .\lib\win32\thread.o             del .\lib\win32\thread.o
 IF EXIST .\lib\win32\time.o               del .\lib\win32\time.o
@@ -104,10 +115,14 @@ IF EXIST .\lib\win32\win32_fullscreen.o   del .\lib\win32\win32_fullscreen.o
 IF EXIST .\lib\win32\win32_glext.o        del .\lib\win32\win32_glext.o
 IF EXIST .\lib\win32\win32_init.o         del .\lib\win32\win32_init.o
 IF EXIST .\lib\win32\win32_joystick.o     del .\lib\win32\win32_joystick.o
+IF EXIST .\lib\win32\win32_shm.o          del .\lib\win32\win32_shm.o
 IF EXIST .\lib\win32\win32_thread.o       del .\lib\win32\win32_thread.o
 IF EXIST .\lib\win32\win32_time.o         del .\lib\win32\win32_time.o
+IF EXIST .\lib\win32\win32_watch.o        del .\lib\win32\win32_watch.o
 IF EXIST .\lib\win32\win32_window.o       del .\lib\win32\win32_window.o
 
+IF EXIST .\lib\win32\capture_dll.o        del .\lib\win32\capture_dll.o
+IF EXIST .\lib\win32\export_dll.o         del .\lib\win32\export_dll.o
 IF EXIST .\lib\win32\enable_dll.o         del .\lib\win32\enable_dll.o
 IF EXIST .\lib\win32\fullscreen_dll.o     del .\lib\win32\fullscreen_dll.o
 IF EXIST .\lib\win32\glext_dll.o          del .\lib\win32\glext_dll.o
@@ -115,7 +130,16 @@ IF EXIST .\lib\win32\image_dll.o          del .\lib\win32\image_dll.o
 IF EXIST .\lib\win32\init_dll.o           del .\lib\win32\init_dll.o
 IF EXIST .\lib\win32\input_dll.o          del .\lib\win32\input_dll.o
 IF EXIST .\lib\win32\joystick_dll.o       del .\lib\win32\joystick_dll.o
+IF EXIST .\lib\win32\pack_dll.o           del .\lib\win32\pack_dll.o
+IF EXIST .\lib\win32\pool_dll.o           del .\lib\win32\pool_dll.o
+IF EXIST .\lib\win32\record_dll.o         del .\lib\win32\record_dll.o
+IF EXIST .\lib\win32\reload_dll.o         del .\lib\win32\reload_dll.o
+IF EXIST .\lib\win32\resample_dll.o       del .\lib\win32\resample_dll.o
+IF EXIST .\lib\win32\ring_dll.o           del .\lib\win32\ring_dll.o
 IF EXIST .\lib\win32\stream_dll.o         del .\lib\win32\stream_dll.o
+IF EXIST .\lib\win32\sync_dll.o           del .\lib\win32\sync_dll.o
+IF EXIST .\lib\win32\texarray_dll.o       del .\lib\win32\texarray_dll.o
+IF EXIST .\lib\win32\texture_dll.o        del .\lib\win32\texture_dll.o
 IF EXIST .\lib\win32\tga_dll.o            del .\lib\win32\tga_dll.o
 IF EXIST .\lib\win32\thread_dll.o         del .\lib\win32\thread_dll.o
 IF EXIST .\lib\win32\time_dll.o           del .\lib\win32\time_dll.o
@@ -126,10 +150,14 @@ IF EXIST .\lib\win32\win32_fullscreen_dll.o del .\lib\win32\win32_fullscreen_dll
 IF EXIST .\lib\win32\win32_glext_dll.o      del .\lib\win32\win32_glext_dll.o
 IF EXIST .\lib\win32\win32_init_dll.o       del .\lib\win32\win32_init_dll.o
 IF EXIST .\lib\win32\win32_joystick_dll.o   del .\lib\win32\win32_joystick_dll.o
+IF EXIST .\lib\win32\win32_shm_dll.o        del .\lib\win32\win32_shm_dll.o
 IF EXIST .\lib\win32\win32_thread_dll.o     del .\lib\win32\win32_thread_dll.o
 IF EXIST .\lib\win32\win32_time_dll.o       del .\lib\win32\win32_time_dll.o
+IF EXIST .\lib\win32\win32_watch_dll.o      del .\lib\win32\win32_watch_dll.o
 IF EXIST .\lib\win32\win32_window_dll.o     del .\lib\win32\win32_window_dll.o
 
+IF EXIST .\lib\win32\capture.obj          del .\lib\win32\capture.obj
+IF EXIST .\lib\win32\export.obj           del .\lib\win32\export.obj
 IF EXIST .\lib\win32\enable.obj           del .\lib\win32\enable.obj
 IF EXIST .\lib\win32\fullscreen.obj       del .\lib\win32\fullscreen.obj
 IF EXIST .\lib\win32\glext.obj            del .\lib\win32\glext.obj
@@ -137,7 +165,16 @@ IF EXIST .\lib\win32\image.obj            del .\lib\win32\image.obj
 IF EXIST .\lib\win32\init.obj             del .\lib\win32\init.obj
 IF EXIST .\lib\win32\input.obj            del .\lib\win32\input.obj
 IF EXIST .\lib\win32\joystick.obj         del .\lib\win32\joystick.obj
+IF EXIST .\lib\win32\pack.obj             del .\lib\win32\pack.obj
+IF EXIST .\lib\win32\pool.obj             del .\lib\win32\pool.obj
+IF EXIST .\lib\win32\record.obj           del .\lib\win32\record.obj
+IF EXIST .\lib\win32\reload.obj           del .\lib\win32\reload.obj
+IF EXIST .\lib\win32\resample.obj         del .\lib\win32\resample.obj
+IF EXIST .\lib\win32\ring.obj             del .\lib\win32\ring.obj
 IF EXIST .\lib\win32\stream.obj           del .\lib\win32\stream.obj
+IF EXIST .\lib\win32\sync.obj             del .\lib\win32\sync.obj
+IF EXIST .\lib\win32\texarray.obj         del .\lib\win32\texarray.obj
+IF EXIST .\lib\win32\texture.obj          del .\lib\win32\texture.obj
 IF EXIST .\lib\win32\tga.obj              del .\lib\win32\tga.obj
 IF EXIST .\lib\win32\thread.obj           del .\lib\win32\thread.obj
 IF EXIST .\lib\win32\time.obj             del .\lib\win32\time.obj
@@ -147,10 +184,14 @@ IF EXIST .\lib\win32\win32_fullscreen.obj del .\lib\win32\win32_fullscreen.obj
 IF EXIST .\lib\win32\win32_glext.obj      del .\lib\win32\win32_glext.obj
 IF EXIST .\lib\win32\win32_init.obj       del .\lib\win32\win32_init.obj
 IF EXIST .\lib\win32\win32_joystick.obj   del .\lib\win32\win32_joystick.obj
+IF EXIST .\lib\win32\win32_shm.obj        del .\lib\win32\win32_shm.obj
 IF EXIST .\lib\win32\win32_thread.obj     del .\lib\win32\win32_thread.obj
 IF EXIST .\lib\win32\win32_time.obj       del .\lib\win32\win32_time.obj
+IF EXIST .\lib\win32\win32_watch.obj      del .\lib\win32\win32_watch.obj
 IF EXIST .\lib\win32\win32_window.obj     del .\lib\win32\win32_window.obj
 
+IF EXIST .\lib\win32\capture_dll.obj      del .\lib\win32\capture_dll.obj
+IF EXIST .\lib\win32\export_dll.obj       del .\lib\win32\export_dll.obj
 IF EXIST .\lib\win32\enable_dll.obj       del .\lib\win32\enable_dll.obj
 IF EXIST .\lib\win32\fullscreen_dll.obj   del .\lib\win32\fullscreen_dll.obj
 IF EXIST .\lib\win32\glext_dll.obj        del .\lib\win32\glext_dll.obj
@@ -158,7 +199,16 @@ IF EXIST .\lib\win32\image_dll.obj        del .\lib\win32\image_dll.obj
 IF EXIST .\lib\win32\init_dll.obj         del .\lib\win32\init_dll.obj
 IF EXIST .\lib\win32\input_dll.obj        del .\lib\win32\input_dll.obj
 IF EXIST .\lib\win32\joystick_dll.obj     del .\lib\win32\joystick_dll.obj
+IF EXIST .\lib\win32\pack_dll.obj         del .\lib\win32\pack_dll.obj
+IF EXIST .\lib\win32\pool_dll.obj         del .\lib\win32\pool_dll.obj
+IF EXIST .\lib\win32\record_dll.obj       del .\lib\win32\record_dll.obj
+IF EXIST .\lib\win32\reload_dll.obj       del .\lib\win32\reload_dll.obj
+IF EXIST .\lib\win32\resample_dll.obj     del .\lib\win32\resample_dll.obj
+IF EXIST .\lib\win32\ring_dll.obj         del .\lib\win32\ring_dll.obj
 IF EXIST .\lib\win32\stream_dll.obj       del .\lib\win32\stream_dll.obj
+IF EXIST .\lib\win32\sync_dll.obj         del .\lib\win32\sync_dll.obj
+IF EXIST .\lib\win32\texarray_dll.obj     del .\lib\win32\texarray_dll.obj
+IF EXIST .\lib\win32\texture_dll.obj      del .\lib\win32\texture_dll.obj
 IF EXIST .\lib\win32\tga_dll.obj          del .\lib\win32\tga_dll.obj
 IF EXIST .\lib\win32\thread_dll.obj       del .\lib\win32\thread_dll.obj
 IF EXIST .\lib\win32\time_dll.obj         del .\lib\win32\time_dll.obj
@@ -169,8 +219,10 @@ IF EXIST .\lib\win32\win32_fullscreen_dll.obj del .\lib\win32\win32_fullscreen_d
 IF EXIST .\lib\win32\win32_glext_dll.obj      del .\lib\win32\win32_glext_dll.obj
 IF EXIST .\lib\win32\win32_init_dll.obj       del .\lib\win32\win32_init_dll.obj
 IF EXIST .\lib\win32\win32_joystick_dll.obj   del .\lib\win32\win32_joystick_dll.obj
+IF EXIST .\lib\win32\win32_shm_dll.obj        del .\lib\win32\win32_shm_dll.obj
 IF EXIST .\lib\win32\win32_thread_dll.obj     del .\lib\win32\win32_thread_dll.obj
 IF EXIST .\lib\win32\win32_time_dll.obj       del .\lib\win32\win32_time_dll.obj
+IF EXIST .\lib\win32\win32_watch_dll.obj      del .\lib\win32\win32_watch_dll.obj
 IF EXIST .\lib\win32\win32_window_dll.obj     del .\lib\win32\win32_window_dll.obj
 
 REM Library files
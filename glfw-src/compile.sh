@@ -411,6 +411,220 @@ if [ "x$has_clock_gettime" = xyes ]; then
 fi
 
 
+##########################################################################
+# Check for shm_open support
+##########################################################################
+echo -n "Checking for shm_open... " 1>&6
+echo "$self: Checking for shm_open" >&5
+has_shm_open=no
+
+cat > conftest.c <<EOF
+#include <sys/mman.h>
+#include <fcntl.h>
+int main() {shm_unlink("/conftest"); return 0;}
+EOF
+
+LFLAGS_OLD="$GLFW_LFLAGS"
+LFLAGS_SHM=
+
+if { (eval echo $self: \"$link\") 1>&5; (eval $link) 2>&5; }; then
+  rm -f conftest*
+  has_shm_open=yes
+else
+  echo "$self: failed program was:" >&5
+  cat conftest.c >&5
+fi
+
+if [ "x$has_shm_open" = xno ]; then
+  LFLAGS_SHM="-lrt"
+  GLFW_LFLAGS="$LFLAGS_OLD $LFLAGS_SHM"
+  if { (eval echo $self: \"$link\") 1>&5; (eval $link) 2>&5; }; then
+    rm -f conftest*
+    has_shm_open=yes
+  else
+    echo "$self: failed program was:" >&5
+    cat conftest.c >&5
+  fi
+fi
+
+GLFW_LFLAGS="$LFLAGS_OLD"
+
+echo "$has_shm_open" 1>&6
+
+if [ "x$has_shm_open" = xyes ]; then
+  GLFW_LIB_CFLAGS="$GLFW_LIB_CFLAGS -D_GLFW_HAS_SHM_OPEN"
+  if [ "x$LFLAGS_SHM" != "x$LFLAGS_CLOCK" ]; then
+    GLFW_LIB_LFLAGS="$GLFW_LIB_LFLAGS $LFLAGS_SHM"
+  fi
+fi
+
+
+##########################################################################
+# Check for inotify support
+##########################################################################
+echo -n "Checking for inotify... " 1>&6
+echo "$self: Checking for inotify" >&5
+has_inotify=no
+
+cat > conftest.c <<EOF
+#include <sys/inotify.h>
+int main() {int fd=inotify_init(); return inotify_add_watch(fd,".",IN_MODIFY);}
+EOF
+
+if { (eval echo $self: \"$link\") 1>&5; (eval $link) 2>&5; }; then
+  rm -f conftest*
+  has_inotify=yes
+else
+  echo "$self: failed program was:" >&5
+  cat conftest.c >&5
+fi
+
+echo "$has_inotify" 1>&6
+
+if [ "x$has_inotify" = xyes ]; then
+  GLFW_LIB_CFLAGS="$GLFW_LIB_CFLAGS -D_GLFW_HAS_INOTIFY"
+fi
+
+
+##########################################################################
+# Check for futex support
+##########################################################################
+echo -n "Checking for futex... " 1>&6
+echo "$self: Checking for futex" >&5
+has_futex=no
+
+cat > conftest.c <<EOF
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+int main() {int word=0; return syscall(SYS_futex,&word,FUTEX_WAKE,1,0,0,0) < 0;}
+EOF
+
+if { (eval echo $self: \"$link\") 1>&5; (eval $link) 2>&5; }; then
+  rm -f conftest*
+  has_futex=yes
+else
+  echo "$self: failed program was:" >&5
+  cat conftest.c >&5
+fi
+
+echo "$has_futex" 1>&6
+
+if [ "x$has_futex" = xyes ]; then
+  GLFW_LIB_CFLAGS="$GLFW_LIB_CFLAGS -D_GLFW_HAS_FUTEX"
+fi
+
+
+##########################################################################
+# Check for thread affinity, thread name and thread CPU clock support
+##########################################################################
+if [ "x$has_pthread" = xyes ]; then
+
+  echo -n "Checking for pthread_setaffinity_np... " 1>&6
+  echo "$self: Checking for pthread_setaffinity_np" >&5
+  has_setaffinity=no
+
+  cat > conftest.c <<EOF
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+int main() {cpu_set_t set; CPU_ZERO(&set); CPU_SET(0, &set); return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);}
+EOF
+
+  if { (eval echo $self: \"$link\") 1>&5; (eval $link) 2>&5; }; then
+    rm -f conftest*
+    has_setaffinity=yes
+  else
+    echo "$self: failed program was:" >&5
+    cat conftest.c >&5
+  fi
+
+  echo "$has_setaffinity" 1>&6
+
+  if [ "x$has_setaffinity" = xyes ]; then
+    GLFW_LIB_CFLAGS="$GLFW_LIB_CFLAGS -D_GLFW_HAS_PTHREAD_SETAFFINITY"
+  fi
+
+  echo -n "Checking for pthread_setname_np... " 1>&6
+  echo "$self: Checking for pthread_setname_np" >&5
+  has_setname=no
+
+  cat > conftest.c <<EOF
+#define _GNU_SOURCE
+#include <pthread.h>
+int main() {return pthread_setname_np(pthread_self(), "glfw");}
+EOF
+
+  if { (eval echo $self: \"$link\") 1>&5; (eval $link) 2>&5; }; then
+    rm -f conftest*
+    has_setname=yes
+  else
+    echo "$self: failed program was:" >&5
+    cat conftest.c >&5
+  fi
+
+  echo "$has_setname" 1>&6
+
+  if [ "x$has_setname" = xyes ]; then
+    GLFW_LIB_CFLAGS="$GLFW_LIB_CFLAGS -D_GLFW_HAS_PTHREAD_SETNAME"
+  fi
+
+  echo -n "Checking for pthread_getcpuclockid... " 1>&6
+  echo "$self: Checking for pthread_getcpuclockid" >&5
+  has_getcpuclockid=no
+
+  cat > conftest.c <<EOF
+#include <pthread.h>
+#include <time.h>
+int main() {clockid_t clock; struct timespec ts; return pthread_getcpuclockid(pthread_self(), &clock) || clock_gettime(clock, &ts);}
+EOF
+
+  if { (eval echo $self: \"$link\") 1>&5; (eval $link) 2>&5; }; then
+    rm -f conftest*
+    has_getcpuclockid=yes
+  else
+    echo "$self: failed program was:" >&5
+    cat conftest.c >&5
+  fi
+
+  echo "$has_getcpuclockid" 1>&6
+
+  if [ "x$has_getcpuclockid" = xyes ]; then
+    GLFW_LIB_CFLAGS="$GLFW_LIB_CFLAGS -D_GLFW_HAS_PTHREAD_GETCPUCLOCKID"
+  fi
+
+fi
+
+
+##########################################################################
+# Check for gettid support (per-thread nice values on Linux)
+##########################################################################
+echo -n "Checking for gettid... " 1>&6
+echo "$self: Checking for gettid" >&5
+has_gettid=no
+
+cat > conftest.c <<EOF
+#include <sys/syscall.h>
+#include <sys/resource.h>
+#include <unistd.h>
+int main() {return setpriority(PRIO_PROCESS, (int) syscall(SYS_gettid), 0);}
+EOF
+
+if { (eval echo $self: \"$link\") 1>&5; (eval $link) 2>&5; }; then
+  rm -f conftest*
+  has_gettid=yes
+else
+  echo "$self: failed program was:" >&5
+  cat conftest.c >&5
+fi
+
+echo "$has_gettid" 1>&6
+
+if [ "x$has_gettid" = xyes ]; then
+  GLFW_LIB_CFLAGS="$GLFW_LIB_CFLAGS -D_GLFW_HAS_GETTID"
+fi
+
+
 ##########################################################################
 # Check for glXGetProcAddressXXX availability
 ##########################################################################
@@ -8,6 +8,18 @@
 // As a "bonus", this program demonstrates how to create a signal
 // primitive using the GLFW mutex and condition variable primitives.
 //
+// The synchronization test is run twice, first with the default mutexes
+// and condition variables and then with GLFW_FUTEX_SYNC enabled, which on
+// Linux selects spinning futex based ones instead of POSIX ones (on other
+// systems both runs use the same objects).
+//
+// The remaining tests measure the barrier, reader-writer lock, semaphore
+// and event objects: the ping-pong is repeated with events and with
+// semaphores in place of the home-made signal, a group of threads meets
+// at a barrier over and over, and a group of threads mostly reads and
+// sometimes writes a counter under a reader-writer lock, and then under
+// a plain mutex for comparison.
+//
 // Here are some benchmark results:
 // (Note: these are not exact measurments, since they are subject to
 // varying CPU-loads etc. Some tested systems are multi-user systems
@@ -64,6 +76,23 @@ int        gotoACount, gotoBCount;
 
 #define MAX_COUNT 10000
 
+// Number of barrier rounds and of lock operations per thread
+#define BARRIER_ROUNDS 10000
+#define LOCK_COUNT     100000
+
+// One lock operation in this many is a write
+#define WRITE_RATIO    16
+
+// Ping-pong objects for test 3
+GLFWthreadevent eventA, eventB;
+GLFWsemaphore   semA, semB;
+
+// Shared objects for tests 4 and 5
+GLFWbarrier barrier;
+GLFWrwlock  rwlock;
+GLFWmutex   plainMutex;
+int         sharedValue, sharedReads;
+
 
 //------------------------------------------------------------------------
 // InitSignal()
@@ -178,48 +207,17 @@ void GLFWCALL threadBfun( void * arg )
 
 
 //------------------------------------------------------------------------
-// main()
+// PingPong() - returns the number of context switches per second
 //------------------------------------------------------------------------
 
-int main( void )
+double PingPong( void )
 {
     GLFWthread threadA, threadB;
-    double     t1, t2, csps;
-    int        done, count, i;
+    double     t1, t2;
+    int        done;
 
     gotoACount = gotoBCount = doneCount = 0;
 
-    // Initialize GLFW
-    if( !glfwInit() )
-    {
-        return 0;
-    }
-
-    // Print some program information
-    printf( "\nMultithreading benchmarking program\n" );
-    printf( "-----------------------------------\n\n" );
-    printf( "This program consists of two tests. In the first test " );
-    printf( "two threads are created,\n" );
-    printf( "which continously signal/wait each other. This forces " );
-    printf( "the execution to\n" );
-    printf( "alternate between the two threads, and gives a measure " );
-    printf( "of the thread\n" );
-    printf( "synchronization granularity. In the second test, the " );
-    printf( "main thread is repeatedly\n" );
-    printf( "put to sleep for a very short interval using glfwSleep. " );
-    printf( "The average sleep time\n" );
-    printf( "is measured, which tells the minimum supported sleep " );
-    printf( "interval.\n\n" );
-    printf( "Results:\n" );
-    printf( "--------\n\n" );
-    printf( "Number of CPUs: %d\n\n", glfwGetNumberOfProcessors() );
-    fflush( stdout );
-
-
-//------------------------------------------------------------------------
-// 1) Benchmark thread synchronization granularity
-//------------------------------------------------------------------------
-
     // Init mutexes and conditions
     doneMutex  = glfwCreateMutex();
     threadDone = glfwCreateCond();
@@ -251,13 +249,6 @@ int main( void )
     glfwUnlockMutex( doneMutex );
     t2 = glfwGetTime();
 
-    // Display results
-    count = gotoACount + gotoBCount;
-    csps = (double)count / (t2-t1);
-    printf( "Test 1:  %.0f context switches / second (%.3f us/switch)\n",
-            csps, 1e6/csps );
-    fflush( stdout );
-
     // Wait for threads to die
     glfwWaitThread( threadA, GLFW_WAIT );
     glfwWaitThread( threadB, GLFW_WAIT );
@@ -268,6 +259,265 @@ int main( void )
     KillSignal( &gotoA );
     KillSignal( &gotoB );
 
+    return (double)(gotoACount + gotoBCount) / (t2-t1);
+}
+
+
+
+//------------------------------------------------------------------------
+// Event and semaphore ping-pong threads
+//------------------------------------------------------------------------
+
+void GLFWCALL eventThreadFun( void * arg )
+{
+    int i, first = (arg != NULL);
+
+    for( i = 0; i < MAX_COUNT; i ++ )
+    {
+        if( first )
+        {
+            glfwSetThreadEvent( eventB );
+            glfwWaitThreadEvent( eventA, GLFW_INFINITY );
+        }
+        else
+        {
+            glfwWaitThreadEvent( eventB, GLFW_INFINITY );
+            glfwSetThreadEvent( eventA );
+        }
+    }
+}
+
+void GLFWCALL semaphoreThreadFun( void * arg )
+{
+    int i, first = (arg != NULL);
+
+    for( i = 0; i < MAX_COUNT; i ++ )
+    {
+        if( first )
+        {
+            glfwPostSemaphore( semB, 1 );
+            glfwWaitSemaphore( semA, GLFW_INFINITY );
+        }
+        else
+        {
+            glfwWaitSemaphore( semB, GLFW_INFINITY );
+            glfwPostSemaphore( semA, 1 );
+        }
+    }
+}
+
+
+//------------------------------------------------------------------------
+// PingPongObjects() - ping-pong with events or semaphores, returns the
+// number of context switches per second
+//------------------------------------------------------------------------
+
+double PingPongObjects( int semaphores )
+{
+    GLFWthreadfun fun;
+    GLFWthread    threadA, threadB;
+    double        t;
+
+    eventA = glfwCreateThreadEvent( GL_FALSE, GL_FALSE );
+    eventB = glfwCreateThreadEvent( GL_FALSE, GL_FALSE );
+    semA = glfwCreateSemaphore( 0 );
+    semB = glfwCreateSemaphore( 0 );
+    fun = semaphores ? semaphoreThreadFun : eventThreadFun;
+
+    t = glfwGetTime();
+    threadA = glfwCreateThread( fun, (void *) &threadA );
+    threadB = glfwCreateThread( fun, NULL );
+    glfwWaitThread( threadA, GLFW_WAIT );
+    glfwWaitThread( threadB, GLFW_WAIT );
+    t = glfwGetTime() - t;
+
+    glfwDestroyThreadEvent( eventA );
+    glfwDestroyThreadEvent( eventB );
+    glfwDestroySemaphore( semA );
+    glfwDestroySemaphore( semB );
+
+    return (double)(2 * MAX_COUNT) / t;
+}
+
+
+//------------------------------------------------------------------------
+// barrierThreadFun()
+//------------------------------------------------------------------------
+
+void GLFWCALL barrierThreadFun( void * arg )
+{
+    int i;
+
+    for( i = 0; i < BARRIER_ROUNDS; i ++ )
+    {
+        glfwWaitBarrier( barrier, GLFW_INFINITY );
+    }
+}
+
+
+//------------------------------------------------------------------------
+// lockThreadFun() - mostly reads, sometimes increments, a shared value
+//------------------------------------------------------------------------
+
+void GLFWCALL lockThreadFun( void * arg )
+{
+    int i, reads = 0, useRWLock = (arg != NULL);
+
+    for( i = 0; i < LOCK_COUNT; i ++ )
+    {
+        if( i % WRITE_RATIO == 0 )
+        {
+            if( useRWLock )
+            {
+                glfwWriteLockRWLock( rwlock, GLFW_INFINITY );
+                sharedValue ++;
+                glfwUnlockRWLock( rwlock );
+            }
+            else
+            {
+                glfwLockMutex( plainMutex );
+                sharedValue ++;
+                glfwUnlockMutex( plainMutex );
+            }
+        }
+        else
+        {
+            if( useRWLock )
+            {
+                glfwReadLockRWLock( rwlock, GLFW_INFINITY );
+                reads += (sharedValue >= 0);
+                glfwUnlockRWLock( rwlock );
+            }
+            else
+            {
+                glfwLockMutex( plainMutex );
+                reads += (sharedValue >= 0);
+                glfwUnlockMutex( plainMutex );
+            }
+        }
+    }
+
+    glfwLockMutex( doneMutex );
+    sharedReads += reads;
+    glfwUnlockMutex( doneMutex );
+}
+
+
+//------------------------------------------------------------------------
+// RunThreads() - runs a function in a number of threads, returns the
+// time it took
+//------------------------------------------------------------------------
+
+double RunThreads( GLFWthreadfun fun, void *arg, int count )
+{
+    GLFWthread threads[ 64 ];
+    double     t;
+    int        i;
+
+    t = glfwGetTime();
+    for( i = 0; i < count; i ++ )
+    {
+        threads[ i ] = glfwCreateThread( fun, arg );
+    }
+    for( i = 0; i < count; i ++ )
+    {
+        glfwWaitThread( threads[ i ], GLFW_WAIT );
+    }
+
+    return glfwGetTime() - t;
+}
+
+
+//------------------------------------------------------------------------
+// LockTest() - returns the number of lock operations per second, or a
+// negative value if an update was lost
+//------------------------------------------------------------------------
+
+double LockTest( int useRWLock, int count )
+{
+    double t;
+    int    expected;
+
+    doneMutex = glfwCreateMutex();
+    rwlock = glfwCreateRWLock();
+    plainMutex = glfwCreateMutex();
+    sharedValue = sharedReads = 0;
+
+    t = RunThreads( lockThreadFun, useRWLock ? (void *) &t : NULL, count );
+
+    glfwDestroyMutex( doneMutex );
+    glfwDestroyRWLock( rwlock );
+    glfwDestroyMutex( plainMutex );
+
+    expected = count * ((LOCK_COUNT + WRITE_RATIO - 1) / WRITE_RATIO);
+    if( sharedValue != expected ||
+        sharedReads != count * LOCK_COUNT - expected )
+    {
+        return -1.0;
+    }
+
+    return (double)(count * LOCK_COUNT) / t;
+}
+
+
+//------------------------------------------------------------------------
+// main()
+//------------------------------------------------------------------------
+
+int main( void )
+{
+    double     t1, t2, csps;
+    int        count, i, threads;
+
+    // Initialize GLFW
+    if( !glfwInit() )
+    {
+        return 0;
+    }
+
+    // Print some program information
+    printf( "\nMultithreading benchmarking program\n" );
+    printf( "-----------------------------------\n\n" );
+    printf( "This program consists of two tests. In the first test " );
+    printf( "two threads are created,\n" );
+    printf( "which continously signal/wait each other. This forces " );
+    printf( "the execution to\n" );
+    printf( "alternate between the two threads, and gives a measure " );
+    printf( "of the thread\n" );
+    printf( "synchronization granularity. In the second test, the " );
+    printf( "main thread is repeatedly\n" );
+    printf( "put to sleep for a very short interval using glfwSleep. " );
+    printf( "The average sleep time\n" );
+    printf( "is measured, which tells the minimum supported sleep " );
+    printf( "interval. The first test is run both without and with " );
+    printf( "GLFW_FUTEX_SYNC.\n" );
+    printf( "The remaining tests measure events, semaphores, barriers " );
+    printf( "and reader-writer locks.\n\n" );
+    printf( "Results:\n" );
+    printf( "--------\n\n" );
+    printf( "Number of CPUs: %d\n\n", glfwGetNumberOfProcessors() );
+    fflush( stdout );
+
+
+//------------------------------------------------------------------------
+// 1) Benchmark thread synchronization granularity
+//------------------------------------------------------------------------
+
+    // Default mutexes and condition variables
+    glfwDisable( GLFW_FUTEX_SYNC );
+    csps = PingPong();
+    printf( "Test 1a: %.0f context switches / second (%.3f us/switch)\n",
+            csps, 1e6/csps );
+    fflush( stdout );
+
+    // Futex mutexes and condition variables, where available
+    glfwEnable( GLFW_FUTEX_SYNC );
+    csps = PingPong();
+    glfwDisable( GLFW_FUTEX_SYNC );
+    printf( "Test 1b: %.0f context switches / second (%.3f us/switch)"
+            " with GLFW_FUTEX_SYNC\n", csps, 1e6/csps );
+    fflush( stdout );
+
 
 //------------------------------------------------------------------------
 // 2) Benchmark thread sleep granularity
@@ -291,8 +541,72 @@ int main( void )
     t2 = glfwGetTime();
 
     // Display results
-    printf( "Test 2:  %.3f ms / sleep (mean)\n\n",
+    printf( "Test 2:  %.3f ms / sleep (mean)\n",
             1000.0 * (t2-t1) / (double)count );
+    fflush( stdout );
+
+
+//------------------------------------------------------------------------
+// 3) Benchmark events and semaphores
+//------------------------------------------------------------------------
+
+    csps = PingPongObjects( GL_FALSE );
+    printf( "Test 3a: %.0f context switches / second (%.3f us/switch)"
+            " with events\n", csps, 1e6/csps );
+    csps = PingPongObjects( GL_TRUE );
+    printf( "Test 3b: %.0f context switches / second (%.3f us/switch)"
+            " with semaphores\n", csps, 1e6/csps );
+    fflush( stdout );
+
+
+//------------------------------------------------------------------------
+// 4) Benchmark barriers
+//------------------------------------------------------------------------
+
+    threads = glfwGetNumberOfProcessors();
+    if( threads < 2 )
+    {
+        threads = 2;
+    }
+    if( threads > 64 )
+    {
+        threads = 64;
+    }
+
+    barrier = glfwCreateBarrier( threads );
+    t1 = RunThreads( barrierThreadFun, NULL, threads );
+    glfwDestroyBarrier( barrier );
+    printf( "Test 4:  %.0f barrier rounds / second (%.3f us/round)"
+            " with %d threads\n",
+            BARRIER_ROUNDS / t1, 1e6 * t1 / BARRIER_ROUNDS, threads );
+    fflush( stdout );
+
+
+//------------------------------------------------------------------------
+// 5) Benchmark reader-writer locks against plain mutexes
+//------------------------------------------------------------------------
+
+    csps = LockTest( GL_TRUE, threads );
+    if( csps < 0.0 )
+    {
+        printf( "Test 5a: lost updates with the reader-writer lock\n" );
+    }
+    else
+    {
+        printf( "Test 5a: %.0f lock operations / second with a "
+                "reader-writer lock\n", csps );
+    }
+
+    csps = LockTest( GL_FALSE, threads );
+    if( csps < 0.0 )
+    {
+        printf( "Test 5b: lost updates with the mutex\n\n" );
+    }
+    else
+    {
+        printf( "Test 5b: %.0f lock operations / second with a "
+                "mutex\n\n", csps );
+    }
 
     // Terminate GLFW
     glfwTerminate();
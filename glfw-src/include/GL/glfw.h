@@ -362,11 +362,20 @@ extern "C" {
 #define GLFW_SYSTEM_KEYS          0x00030004
 #define GLFW_KEY_REPEAT           0x00030005
 #define GLFW_AUTO_POLL_EVENTS     0x00030006
+#define GLFW_TEXTURE_ACCOUNTING   0x00030007
+#define GLFW_TEXTURE_HOT_RELOAD   0x00030008
+#define GLFW_FUTEX_SYNC           0x00030009
 
 /* glfwWaitThread wait modes */
 #define GLFW_WAIT                 0x00040001
 #define GLFW_NOWAIT               0x00040002
 
+/* glfwSetThreadPriority priorities */
+#define GLFW_THREAD_PRIORITY_LOW      0x00070001
+#define GLFW_THREAD_PRIORITY_NORMAL   0x00070002
+#define GLFW_THREAD_PRIORITY_HIGH     0x00070003
+#define GLFW_THREAD_PRIORITY_REALTIME 0x00070004
+
 /* glfwGetJoystickParam tokens */
 #define GLFW_PRESENT              0x00050001
 #define GLFW_AXES                 0x00050002
@@ -377,6 +386,25 @@ extern "C" {
 #define GLFW_ORIGIN_UL_BIT        0x00000002
 #define GLFW_BUILD_MIPMAPS_BIT    0x00000004 /* Only for glfwLoadTexture2D */
 #define GLFW_ALPHA_MAP_BIT        0x00000008
+#define GLFW_PREMULTIPLY_ALPHA_BIT 0x00000010
+#define GLFW_EXPAND_RGBA_BIT      0x00000020 /* Only for glfwReadImage */
+#define GLFW_ALIGN_ROWS_BIT       0x00000040 /* Only for glfwReadImage */
+#define GLFW_RESCALE_NEAREST_POT_BIT 0x00000080 /* Only for glfwReadImage */
+#define GLFW_INDEXED_BIT          0x00000100 /* Only for glfwReadImage */
+#define GLFW_INDEX_TEXTURE_BIT    0x00000200 /* Only for glfwLoadTextureImage2D */
+#define GLFW_TEXTURE_ATLAS_BIT    0x00000400 /* Only for glfwLoadTextureArray */
+
+/* glfwResizeImage filters */
+#define GLFW_BOX_FILTER           0x00060001
+#define GLFW_TRIANGLE_FILTER      0x00060002
+#define GLFW_LANCZOS_FILTER       0x00060003
+
+/* glfwStartRecording flags */
+#define GLFW_RECORD_DELTA_BIT     0x00000001
+#define GLFW_RECORD_DROP_FRAMES_BIT 0x00000002
+
+/* Most processor groups reported per kind by glfwGetCPUTopology */
+#define GLFW_MAX_CPU_GROUPS       32
 
 /* Time spans longer than this (seconds) are considered to be infinity */
 #define GLFW_INFINITY 100000.0
@@ -398,8 +426,36 @@ typedef struct {
     int Format;
     int BytesPerPixel;
     unsigned char *Data;
+    int RowStride;
+    unsigned char *Palette;     /* 256 entries, for GL_COLOR_INDEX images */
+    int PaletteSize;            /* Number of entries used */
+    int PaletteFormat;          /* GL_RGB or GL_RGBA */
 } GLFWimage;
 
+/* Processor topology information, as returned by glfwGetCPUTopology().
+ * Masks only cover processors 0-31, as for glfwSetThreadAffinity() */
+typedef struct {
+    int OnlineCount;            /* Processors in the system */
+    int UsableCount;            /* Processors this process may use */
+    int CoreCount;              /* Usable physical cores */
+    int L2GroupCount;           /* Groups of usable processors sharing L2 */
+    int L3GroupCount;           /* Groups of usable processors sharing L3 */
+    unsigned int UsableMask;
+    unsigned int CoreMasks[ GLFW_MAX_CPU_GROUPS ];
+    unsigned int L2Masks[ GLFW_MAX_CPU_GROUPS ];
+    unsigned int L3Masks[ GLFW_MAX_CPU_GROUPS ];
+} GLFWcputopology;
+
+/* Thread statistics, as returned by glfwGetThreadStats(). Values that
+ * the system does not provide are -1 */
+typedef struct {
+    double CreationTime;        /* glfwGetTime() when created */
+    double RunTime;             /* Seconds since created */
+    double CPUTime;             /* Seconds of processor time used */
+    long VoluntarySwitches;     /* Context switches while waiting */
+    long InvoluntarySwitches;   /* Context switches by preemption */
+} GLFWthreadstats;
+
 /* Thread ID */
 typedef int GLFWthread;
 
@@ -409,6 +465,21 @@ typedef void * GLFWmutex;
 /* Condition variable object */
 typedef void * GLFWcond;
 
+/* Thread pool object */
+typedef void * GLFWpool;
+
+/* Task graph object */
+typedef void * GLFWtaskgraph;
+
+/* Single producer, single consumer ring buffer object */
+typedef void * GLFWring;
+
+/* Barrier, reader-writer lock, semaphore and event objects */
+typedef void * GLFWbarrier;
+typedef void * GLFWrwlock;
+typedef void * GLFWsemaphore;
+typedef void * GLFWthreadevent;
+
 /* Function pointer types */
 typedef void (GLFWCALL * GLFWwindowsizefun)(int,int);
 typedef int  (GLFWCALL * GLFWwindowclosefun)(void);
@@ -419,6 +490,9 @@ typedef void (GLFWCALL * GLFWmousewheelfun)(int);
 typedef void (GLFWCALL * GLFWkeyfun)(int,int);
 typedef void (GLFWCALL * GLFWcharfun)(int,int);
 typedef void (GLFWCALL * GLFWthreadfun)(void *);
+typedef void (GLFWCALL * GLFWtextureevictfun)(GLuint,long);
+typedef void (GLFWCALL * GLFWcapturefun)(GLFWimage *);
+typedef void (GLFWCALL * GLFWforfun)(int,int,void *);
 
 
 /*************************************************************************
@@ -486,6 +560,11 @@ GLFWAPI GLFWthread GLFWAPIENTRY glfwCreateThread( GLFWthreadfun fun, void *arg )
 GLFWAPI void GLFWAPIENTRY glfwDestroyThread( GLFWthread ID );
 GLFWAPI int  GLFWAPIENTRY glfwWaitThread( GLFWthread ID, int waitmode );
 GLFWAPI GLFWthread GLFWAPIENTRY glfwGetThreadID( void );
+GLFWAPI int  GLFWAPIENTRY glfwSetThreadAffinity( GLFWthread ID, unsigned int mask );
+GLFWAPI int  GLFWAPIENTRY glfwSetThreadPriority( GLFWthread ID, int priority );
+GLFWAPI int  GLFWAPIENTRY glfwSetThreadName( GLFWthread ID, const char *name );
+GLFWAPI int  GLFWAPIENTRY glfwGetThreadStats( GLFWthread ID, GLFWthreadstats *stats );
+GLFWAPI int  GLFWAPIENTRY glfwGetThreads( GLFWthread *list, int maxcount );
 GLFWAPI GLFWmutex GLFWAPIENTRY glfwCreateMutex( void );
 GLFWAPI void GLFWAPIENTRY glfwDestroyMutex( GLFWmutex mutex );
 GLFWAPI void GLFWAPIENTRY glfwLockMutex( GLFWmutex mutex );
@@ -493,9 +572,46 @@ GLFWAPI void GLFWAPIENTRY glfwUnlockMutex( GLFWmutex mutex );
 GLFWAPI GLFWcond GLFWAPIENTRY glfwCreateCond( void );
 GLFWAPI void GLFWAPIENTRY glfwDestroyCond( GLFWcond cond );
 GLFWAPI void GLFWAPIENTRY glfwWaitCond( GLFWcond cond, GLFWmutex mutex, double timeout );
+GLFWAPI void GLFWAPIENTRY glfwWaitCondUntil( GLFWcond cond, GLFWmutex mutex, double time );
 GLFWAPI void GLFWAPIENTRY glfwSignalCond( GLFWcond cond );
 GLFWAPI void GLFWAPIENTRY glfwBroadcastCond( GLFWcond cond );
 GLFWAPI int  GLFWAPIENTRY glfwGetNumberOfProcessors( void );
+GLFWAPI int  GLFWAPIENTRY glfwGetCPUTopology( GLFWcputopology *topology );
+GLFWAPI GLFWpool GLFWAPIENTRY glfwCreateThreadPool( int threads );
+GLFWAPI void GLFWAPIENTRY glfwDestroyThreadPool( GLFWpool pool );
+GLFWAPI int  GLFWAPIENTRY glfwSubmitJob( GLFWpool pool, GLFWthreadfun fun, void *arg );
+GLFWAPI void GLFWAPIENTRY glfwWaitThreadPool( GLFWpool pool );
+GLFWAPI void GLFWAPIENTRY glfwParallelFor( GLFWpool pool, int begin, int end, int grain, GLFWforfun fun, void *arg );
+GLFWAPI GLFWtaskgraph GLFWAPIENTRY glfwCreateTaskGraph( GLFWpool pool );
+GLFWAPI void GLFWAPIENTRY glfwDestroyTaskGraph( GLFWtaskgraph graph );
+GLFWAPI int  GLFWAPIENTRY glfwAddTask( GLFWtaskgraph graph, GLFWthreadfun fun, void *arg );
+GLFWAPI int  GLFWAPIENTRY glfwAddTaskDependency( GLFWtaskgraph graph, int task, int dependency );
+GLFWAPI int  GLFWAPIENTRY glfwRunTaskGraph( GLFWtaskgraph graph );
+GLFWAPI GLFWring GLFWAPIENTRY glfwCreateRing( int size, int capacity );
+GLFWAPI void GLFWAPIENTRY glfwDestroyRing( GLFWring ring );
+GLFWAPI int  GLFWAPIENTRY glfwTryPushRing( GLFWring ring, const void *element );
+GLFWAPI int  GLFWAPIENTRY glfwTryPopRing( GLFWring ring, void *element );
+GLFWAPI int  GLFWAPIENTRY glfwPushRingBatch( GLFWring ring, const void *elements, int count );
+GLFWAPI int  GLFWAPIENTRY glfwPopRingBatch( GLFWring ring, void *elements, int count );
+GLFWAPI int  GLFWAPIENTRY glfwPushRing( GLFWring ring, const void *element, double timeout );
+GLFWAPI int  GLFWAPIENTRY glfwPopRing( GLFWring ring, void *element, double timeout );
+GLFWAPI GLFWbarrier GLFWAPIENTRY glfwCreateBarrier( int count );
+GLFWAPI void GLFWAPIENTRY glfwDestroyBarrier( GLFWbarrier barrier );
+GLFWAPI int  GLFWAPIENTRY glfwWaitBarrier( GLFWbarrier barrier, double timeout );
+GLFWAPI GLFWrwlock GLFWAPIENTRY glfwCreateRWLock( void );
+GLFWAPI void GLFWAPIENTRY glfwDestroyRWLock( GLFWrwlock lock );
+GLFWAPI int  GLFWAPIENTRY glfwReadLockRWLock( GLFWrwlock lock, double timeout );
+GLFWAPI int  GLFWAPIENTRY glfwWriteLockRWLock( GLFWrwlock lock, double timeout );
+GLFWAPI void GLFWAPIENTRY glfwUnlockRWLock( GLFWrwlock lock );
+GLFWAPI GLFWsemaphore GLFWAPIENTRY glfwCreateSemaphore( int count );
+GLFWAPI void GLFWAPIENTRY glfwDestroySemaphore( GLFWsemaphore semaphore );
+GLFWAPI int  GLFWAPIENTRY glfwWaitSemaphore( GLFWsemaphore semaphore, double timeout );
+GLFWAPI void GLFWAPIENTRY glfwPostSemaphore( GLFWsemaphore semaphore, int count );
+GLFWAPI GLFWthreadevent GLFWAPIENTRY glfwCreateThreadEvent( int manualreset, int signaled );
+GLFWAPI void GLFWAPIENTRY glfwDestroyThreadEvent( GLFWthreadevent event );
+GLFWAPI int  GLFWAPIENTRY glfwWaitThreadEvent( GLFWthreadevent event, double timeout );
+GLFWAPI void GLFWAPIENTRY glfwSetThreadEvent( GLFWthreadevent event );
+GLFWAPI void GLFWAPIENTRY glfwResetThreadEvent( GLFWthreadevent event );
 
 /* Enable/disable functions */
 GLFWAPI void GLFWAPIENTRY glfwEnable( int token );
@@ -505,9 +621,53 @@ GLFWAPI void GLFWAPIENTRY glfwDisable( int token );
 GLFWAPI int  GLFWAPIENTRY glfwReadImage( const char *name, GLFWimage *img, int flags );
 GLFWAPI int  GLFWAPIENTRY glfwReadMemoryImage( const void *data, long size, GLFWimage *img, int flags );
 GLFWAPI void GLFWAPIENTRY glfwFreeImage( GLFWimage *img );
+GLFWAPI int  GLFWAPIENTRY glfwWriteImage( const char *name, GLFWimage *img, int flags );
+GLFWAPI int  GLFWAPIENTRY glfwResizeImage( const GLFWimage *src, GLFWimage *dst, int width, int height, int filter );
 GLFWAPI int  GLFWAPIENTRY glfwLoadTexture2D( const char *name, int flags );
 GLFWAPI int  GLFWAPIENTRY glfwLoadMemoryTexture2D( const void *data, long size, int flags );
 GLFWAPI int  GLFWAPIENTRY glfwLoadTextureImage2D( GLFWimage *img, int flags );
+GLFWAPI int  GLFWAPIENTRY glfwLoadPaletteTexture2D( const GLFWimage *img );
+GLFWAPI int  GLFWAPIENTRY glfwUpdateTextureRegion( GLFWimage *img, int srcX, int srcY, int width, int height, int dstX, int dstY, int flags );
+GLFWAPI int  GLFWAPIENTRY glfwLoadTextureArray( GLFWimage *layers, int count, int flags );
+GLFWAPI int  GLFWAPIENTRY glfwLoadTextureArrayFiles( const char **names, int count, int flags );
+
+/* Progressive texture streaming */
+GLFWAPI int  GLFWAPIENTRY glfwStreamTextureImage2D( GLFWimage *img, int flags );
+GLFWAPI long GLFWAPIENTRY glfwUpdateTextureStreams( int budget );
+GLFWAPI double GLFWAPIENTRY glfwGetTextureStreamProgress( GLuint texture );
+GLFWAPI void GLFWAPIENTRY glfwCancelTextureStream( GLuint texture );
+
+/* Texture memory accounting */
+GLFWAPI void GLFWAPIENTRY glfwSetTextureBudget( long bytes );
+GLFWAPI void GLFWAPIENTRY glfwSetTextureEvictCallback( GLFWtextureevictfun cbfun );
+GLFWAPI void GLFWAPIENTRY glfwTouchTexture( GLuint texture );
+GLFWAPI void GLFWAPIENTRY glfwForgetTexture( GLuint texture );
+GLFWAPI long GLFWAPIENTRY glfwGetTextureMemory( GLuint texture, int *format, int *compressed );
+GLFWAPI int  GLFWAPIENTRY glfwGetLeastRecentTextures( GLuint *list, int maxcount );
+GLFWAPI void GLFWAPIENTRY glfwGetTextureMemoryStats( long *used, long *budget, int *count, long *evictions );
+
+/* Asynchronous frame capture */
+GLFWAPI int  GLFWAPIENTRY glfwCaptureFrameAsync( const char *name, GLFWcapturefun cbfun );
+GLFWAPI void GLFWAPIENTRY glfwWaitCaptures( void );
+
+/* Frame recording */
+GLFWAPI int  GLFWAPIENTRY glfwStartRecording( const char *name, int flags );
+GLFWAPI void GLFWAPIENTRY glfwStopRecording( void );
+GLFWAPI void GLFWAPIENTRY glfwGetRecordingStats( int *recorded, int *written, int *dropped );
+
+/* Shared memory frame export (layout in GL/glfwexport.h) */
+GLFWAPI int  GLFWAPIENTRY glfwStartExport( const char *name, int slots );
+GLFWAPI void GLFWAPIENTRY glfwStopExport( void );
+GLFWAPI void GLFWAPIENTRY glfwGetExportStats( int *exported, int *skipped );
+
+/* Pack files */
+GLFWAPI int  GLFWAPIENTRY glfwMountPack( const char *path );
+GLFWAPI int  GLFWAPIENTRY glfwUnmountPack( const char *path );
+
+/* Texture hot reloading */
+GLFWAPI int  GLFWAPIENTRY glfwPollImageReload( GLFWimage *img, const char **name, GLuint *texture );
+GLFWAPI int  GLFWAPIENTRY glfwReloadTextures( void );
+GLFWAPI void GLFWAPIENTRY glfwUnwatchImage( const char *name );
 
 
 #ifdef __cplusplus
@@ -0,0 +1,94 @@
+/************************************************************************
+ * GLFW - An OpenGL framework
+ * API version: 2.7
+ * WWW:         http://www.glfw.org/
+ *------------------------------------------------------------------------
+ * Copyright (c) 2002-2006 Marcus Geelnard
+ * Copyright (c) 2006-2010 Camilla Berglund
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would
+ *    be appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not
+ *    be misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ *    distribution.
+ *
+ *************************************************************************/
+
+#ifndef __glfwexport_h_
+#define __glfwexport_h_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*************************************************************************
+ * Shared memory frame export
+ *
+ * glfwStartExport publishes every presented frame in a shared memory
+ * ring that other processes can map. This header describes its layout
+ * and declares the reader functions in support/export/glfwexport.c, which
+ * do not depend on the GLFW library.
+ *
+ * The ring starts with a GLFWexportheader, followed by SlotCount slots of
+ * SlotSize bytes. Each slot is a GLFWexportslot followed by the pixels.
+ * There are no locks: the producer makes a slot's Sequence odd while it
+ * writes the slot and even when it is done, so a reader that sees the
+ * same even Sequence before and after reading got a consistent frame.
+ *************************************************************************/
+
+#define GLFW_EXPORT_MAGIC       "GLFWSHM1"
+#define GLFW_EXPORT_VERSION     1
+
+typedef struct {
+    char                  Magic[ 8 ];
+    unsigned int          Version;
+    unsigned int          HeaderSize;   /* Offset of the first slot */
+    unsigned int          SlotCount;
+    unsigned int          SlotSize;     /* Including the slot header */
+    volatile unsigned int Latest;       /* Number of the newest frame + 1 */
+    volatile unsigned int Closed;       /* Non-zero once the producer stopped */
+} GLFWexportheader;
+
+typedef struct {
+    volatile unsigned int Sequence;     /* Odd while the slot is written */
+    unsigned int          Frame;        /* Frame number, counting from 0 */
+    unsigned int          Width;
+    unsigned int          Height;
+    unsigned int          Format;       /* GL_BGRA or GL_RGBA */
+    unsigned int          RowStride;    /* Rows are stored bottom to top */
+    double                Time;         /* Seconds since glfwStartExport */
+} GLFWexportslot;
+
+
+/*************************************************************************
+ * Reader functions (support/export/glfwexport.c)
+ *************************************************************************/
+
+typedef struct _GLFWexportreader GLFWexportreader;
+
+GLFWexportreader *glfwOpenExportReader( const char *name );
+void glfwCloseExportReader( GLFWexportreader *reader );
+int  glfwExportClosed( GLFWexportreader *reader );
+const unsigned char *glfwAcquireExportFrame( GLFWexportreader *reader, GLFWexportslot *info );
+int  glfwReleaseExportFrame( GLFWexportreader *reader );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __glfwexport_h_ */
@@ -0,0 +1,629 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Any
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+//========================================================================
+// Description:
+//
+// This module captures the framebuffer without stalling the pipeline.
+// With GL_ARB_pixel_buffer_object, glReadPixels writes into one of a ring
+// of pixel buffers and returns immediately. The buffer is mapped two
+// frames later (by glfwSwapBuffers), when the transfer has completed, and
+// the pixels are either passed to a callback or handed to an encoder
+// thread that writes them as a TGA file.
+//
+// Without pixel buffer objects the read-back is synchronous, but the file
+// is still written by the encoder thread. Without thread support the file
+// is written immediately.
+//
+// The same read-back ring feeds the frame recorder (record.c) and the
+// shared memory frame export (export.c).
+//
+//========================================================================
+
+#include "internal.h"
+
+
+// BGRA is an OpenGL 1.2 pixel format
+#ifndef GL_VERSION_1_2
+ #define GL_BGRA                    0x80E1
+#endif // GL_VERSION_1_2
+
+// Pixel buffer object tokens
+#ifndef GL_ARB_pixel_buffer_object
+ #define GL_PIXEL_PACK_BUFFER_ARB         0x88EB
+ #define GL_PIXEL_PACK_BUFFER_BINDING_ARB 0x88ED
+#endif // GL_ARB_pixel_buffer_object
+
+#ifndef GL_ARB_vertex_buffer_object
+ #define GL_STREAM_READ_ARB         0x88E1
+ #define GL_READ_ONLY_ARB           0x88B8
+#endif // GL_ARB_vertex_buffer_object
+
+// Number of frames to wait before mapping a pixel buffer
+#define _GLFW_CAPTURE_LATENCY 2
+
+
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+//========================================================================
+// Look for pixel buffer object support (called on first capture)
+//========================================================================
+
+static void InitCapture( void )
+{
+    _glfwCapture.HasPBO = GL_FALSE;
+
+    if( glfwExtensionSupported( "GL_ARB_pixel_buffer_object" ) )
+    {
+        _glfwCapture.GenBuffers = (PFNGLGENBUFFERSARBPROC)
+            glfwGetProcAddress( "glGenBuffersARB" );
+        _glfwCapture.DeleteBuffers = (PFNGLDELETEBUFFERSARBPROC)
+            glfwGetProcAddress( "glDeleteBuffersARB" );
+        _glfwCapture.BindBuffer = (PFNGLBINDBUFFERARBPROC)
+            glfwGetProcAddress( "glBindBufferARB" );
+        _glfwCapture.BufferData = (PFNGLBUFFERDATAARBPROC)
+            glfwGetProcAddress( "glBufferDataARB" );
+        _glfwCapture.MapBuffer = (PFNGLMAPBUFFERARBPROC)
+            glfwGetProcAddress( "glMapBufferARB" );
+        _glfwCapture.UnmapBuffer = (PFNGLUNMAPBUFFERARBPROC)
+            glfwGetProcAddress( "glUnmapBufferARB" );
+
+        if( _glfwCapture.GenBuffers && _glfwCapture.DeleteBuffers &&
+            _glfwCapture.BindBuffer && _glfwCapture.BufferData &&
+            _glfwCapture.MapBuffer && _glfwCapture.UnmapBuffer )
+        {
+            _glfwCapture.HasPBO = GL_TRUE;
+        }
+    }
+
+    _glfwCapture.Initialized = GL_TRUE;
+}
+
+
+//========================================================================
+// Encoder thread: write queued images until told to quit
+//========================================================================
+
+static void GLFWCALL CaptureThread( void *arg )
+{
+    _GLFWcapturejob *job;
+
+    for( ;; )
+    {
+        glfwLockMutex( _glfwCapture.Mutex );
+        while( !_glfwCapture.FirstJob && !_glfwCapture.Quit )
+        {
+            glfwWaitCond( _glfwCapture.Cond, _glfwCapture.Mutex,
+                          GLFW_INFINITY );
+        }
+
+        // The queue is always drained before quitting
+        job = _glfwCapture.FirstJob;
+        if( job == NULL )
+        {
+            glfwUnlockMutex( _glfwCapture.Mutex );
+            break;
+        }
+
+        _glfwCapture.FirstJob = job->Next;
+        if( _glfwCapture.FirstJob == NULL )
+        {
+            _glfwCapture.LastJob = NULL;
+        }
+        glfwUnlockMutex( _glfwCapture.Mutex );
+
+        glfwWriteImage( job->Name, &job->Image, 0 );
+
+        free( job->Image.Data );
+        free( job->Name );
+        free( job );
+
+        // Wake up anyone waiting for the queue to drain
+        glfwLockMutex( _glfwCapture.Mutex );
+        _glfwCapture.ActiveJobs --;
+        glfwBroadcastCond( _glfwCapture.Cond );
+        glfwUnlockMutex( _glfwCapture.Mutex );
+    }
+}
+
+
+//========================================================================
+// Hand an image over to the encoder thread (takes ownership of the name
+// and the image data)
+//========================================================================
+
+static void QueueCapture( char *name, GLFWimage *img )
+{
+    _GLFWcapturejob *job;
+
+    // Start the encoder thread on first use
+    if( !_glfwCapture.Threaded )
+    {
+        _glfwCapture.Mutex = glfwCreateMutex();
+        _glfwCapture.Cond = glfwCreateCond();
+        if( _glfwCapture.Mutex && _glfwCapture.Cond )
+        {
+            _glfwCapture.Quit = GL_FALSE;
+            _glfwCapture.Thread = glfwCreateThread( CaptureThread, NULL );
+            _glfwCapture.Threaded = _glfwCapture.Thread >= 0;
+            glfwSetThreadName( _glfwCapture.Thread, "glfw-capture" );
+        }
+
+        if( !_glfwCapture.Threaded )
+        {
+            if( _glfwCapture.Mutex )
+            {
+                glfwDestroyMutex( _glfwCapture.Mutex );
+                _glfwCapture.Mutex = NULL;
+            }
+            if( _glfwCapture.Cond )
+            {
+                glfwDestroyCond( _glfwCapture.Cond );
+                _glfwCapture.Cond = NULL;
+            }
+        }
+    }
+
+    job = NULL;
+    if( _glfwCapture.Threaded )
+    {
+        job = (_GLFWcapturejob *) malloc( sizeof(_GLFWcapturejob) );
+    }
+
+    // Without an encoder thread, the image is written right away
+    if( job == NULL )
+    {
+        glfwWriteImage( name, img, 0 );
+        free( img->Data );
+        free( name );
+        return;
+    }
+
+    job->Next = NULL;
+    job->Name = name;
+    job->Image = *img;
+
+    glfwLockMutex( _glfwCapture.Mutex );
+    if( _glfwCapture.LastJob )
+    {
+        _glfwCapture.LastJob->Next = job;
+    }
+    else
+    {
+        _glfwCapture.FirstJob = job;
+    }
+    _glfwCapture.LastJob = job;
+    _glfwCapture.ActiveJobs ++;
+    glfwBroadcastCond( _glfwCapture.Cond );
+    glfwUnlockMutex( _glfwCapture.Mutex );
+}
+
+
+//========================================================================
+// Pass a frame read back for glfwSwapBuffers on to the recorder and the
+// shared memory export
+//========================================================================
+
+static void DeliverRecordedFrame( const GLFWimage *img, double time )
+{
+    _glfwQueueRecordedFrame( img, time );
+    _glfwExportFrame( img, time );
+}
+
+
+//========================================================================
+// Map the pixel buffer of a pending capture and deliver its contents
+//========================================================================
+
+static void FinishCapture( _GLFWcaptureslot *slot )
+{
+    GLint     binding;
+    GLFWimage img;
+    unsigned char *pixels;
+    long      size;
+
+    glGetIntegerv( GL_PIXEL_PACK_BUFFER_BINDING_ARB, &binding );
+    _glfwCapture.BindBuffer( GL_PIXEL_PACK_BUFFER_ARB, slot->Buffer );
+
+    pixels = (unsigned char *) _glfwCapture.MapBuffer(
+                 GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB );
+
+    size = (long) slot->Width * slot->Height * 4;
+
+    img.Width         = slot->Width;
+    img.Height        = slot->Height;
+    img.Format        = GL_BGRA;
+    img.BytesPerPixel = 4;
+    img.RowStride     = slot->Width * 4;
+    img.Data          = pixels;
+    img.Palette       = NULL;
+    img.PaletteSize   = 0;
+    img.PaletteFormat = 0;
+
+    // Every capture callback is called exactly once, in capture order, so
+    // a lost frame is reported with NULL pixel data rather than dropped
+    if( slot->Callback )
+    {
+        slot->Callback( &img );
+    }
+
+    if( pixels != NULL )
+    {
+        if( slot->Record )
+        {
+            DeliverRecordedFrame( &img, slot->Time );
+        }
+        else if( !slot->Callback )
+        {
+            // The buffer must be unmapped before the next read-back, so
+            // the encoder works on a copy
+            img.Data = (unsigned char *) malloc( size );
+            if( img.Data != NULL )
+            {
+                memcpy( img.Data, pixels, size );
+                QueueCapture( slot->Name, &img );
+                slot->Name = NULL;
+            }
+        }
+
+        _glfwCapture.UnmapBuffer( GL_PIXEL_PACK_BUFFER_ARB );
+    }
+
+    _glfwCapture.BindBuffer( GL_PIXEL_PACK_BUFFER_ARB, (GLuint) binding );
+
+    free( slot->Name );
+    slot->Name = NULL;
+    slot->Callback = NULL;
+    slot->Record = GL_FALSE;
+    slot->Pending = GL_FALSE;
+}
+
+
+//========================================================================
+// Finish all pending captures, oldest first
+//========================================================================
+
+void _glfwFinishCaptures( void )
+{
+    int i;
+    _GLFWcaptureslot *slot;
+
+    for( i = 0; i < _GLFW_CAPTURE_SLOTS; i ++ )
+    {
+        slot = &_glfwCapture.Slots[ (_glfwCapture.NextSlot + i) %
+                                    _GLFW_CAPTURE_SLOTS ];
+        if( slot->Pending )
+        {
+            FinishCapture( slot );
+        }
+    }
+}
+
+
+//========================================================================
+// Read back the current read buffer, either into the next pixel buffer of
+// the ring or (without pixel buffer objects) directly. The pixels go to
+// the recorder and export, to cbfun or to the named file (the name is taken over).
+//========================================================================
+
+static int ReadFrame( char *name, GLFWcapturefun cbfun, int record )
+{
+    GLint     PackAlignment, PackRowLength, PackSkipPixels, PackSkipRows;
+    GLint     binding;
+    GLFWimage img;
+    _GLFWcaptureslot *slot;
+    long      size;
+    int       ok;
+
+    if( !_glfwCapture.Initialized )
+    {
+        InitCapture();
+    }
+
+    size = (long) _glfwWin.width * _glfwWin.height * 4;
+    ok = GL_TRUE;
+
+    glGetIntegerv( GL_PACK_ALIGNMENT, &PackAlignment );
+    glGetIntegerv( GL_PACK_ROW_LENGTH, &PackRowLength );
+    glGetIntegerv( GL_PACK_SKIP_PIXELS, &PackSkipPixels );
+    glGetIntegerv( GL_PACK_SKIP_ROWS, &PackSkipRows );
+    glPixelStorei( GL_PACK_ALIGNMENT, 4 );
+    glPixelStorei( GL_PACK_ROW_LENGTH, 0 );
+    glPixelStorei( GL_PACK_SKIP_PIXELS, 0 );
+    glPixelStorei( GL_PACK_SKIP_ROWS, 0 );
+
+    if( _glfwCapture.HasPBO )
+    {
+        // Reuse the oldest slot, finishing it first if it is still busy
+        slot = &_glfwCapture.Slots[ _glfwCapture.NextSlot ];
+        if( slot->Pending )
+        {
+            FinishCapture( slot );
+        }
+        _glfwCapture.NextSlot = (_glfwCapture.NextSlot + 1) %
+                                _GLFW_CAPTURE_SLOTS;
+
+        glGetIntegerv( GL_PIXEL_PACK_BUFFER_BINDING_ARB, &binding );
+
+        if( !slot->Buffer )
+        {
+            _glfwCapture.GenBuffers( 1, &slot->Buffer );
+        }
+        _glfwCapture.BindBuffer( GL_PIXEL_PACK_BUFFER_ARB, slot->Buffer );
+
+        if( slot->Size != size )
+        {
+            _glfwCapture.BufferData( GL_PIXEL_PACK_BUFFER_ARB, size, NULL,
+                GL_STREAM_READ_ARB );
+            slot->Size = size;
+        }
+
+        // This only queues the transfer
+        glReadPixels( 0, 0, _glfwWin.width, _glfwWin.height, GL_BGRA,
+            GL_UNSIGNED_BYTE, NULL );
+
+        _glfwCapture.BindBuffer( GL_PIXEL_PACK_BUFFER_ARB, (GLuint) binding );
+
+        slot->Pending  = GL_TRUE;
+        slot->Frame    = _glfwCapture.Frame;
+        slot->Time     = _glfwPlatformGetTime();
+        slot->Width    = _glfwWin.width;
+        slot->Height   = _glfwWin.height;
+        slot->Name     = name;
+        slot->Callback = cbfun;
+        slot->Record   = record;
+    }
+    else
+    {
+        img.Data = (unsigned char *) malloc( size );
+        if( img.Data == NULL )
+        {
+            free( name );
+            ok = GL_FALSE;
+        }
+        else
+        {
+            img.Width         = _glfwWin.width;
+            img.Height        = _glfwWin.height;
+            img.BytesPerPixel = 4;
+            img.RowStride     = img.Width * 4;
+            img.Format        = _glfwCaptureFormat();
+            img.Palette       = NULL;
+            img.PaletteSize   = 0;
+            img.PaletteFormat = 0;
+
+            glReadPixels( 0, 0, img.Width, img.Height, img.Format,
+                GL_UNSIGNED_BYTE, img.Data );
+
+            if( record )
+            {
+                DeliverRecordedFrame( &img, _glfwPlatformGetTime() );
+                free( img.Data );
+            }
+            else if( cbfun )
+            {
+                cbfun( &img );
+                free( img.Data );
+            }
+            else
+            {
+                QueueCapture( name, &img );
+            }
+        }
+    }
+
+    glPixelStorei( GL_PACK_ALIGNMENT, PackAlignment );
+    glPixelStorei( GL_PACK_ROW_LENGTH, PackRowLength );
+    glPixelStorei( GL_PACK_SKIP_PIXELS, PackSkipPixels );
+    glPixelStorei( GL_PACK_SKIP_ROWS, PackSkipRows );
+
+    return ok;
+}
+
+
+//========================================================================
+// Return the pixel format that frames are read back in
+//========================================================================
+
+int _glfwCaptureFormat( void )
+{
+    // BGRA is what the TGA writer wants, but requires OpenGL 1.2
+    if( _glfwWin.glMajor == 1 && _glfwWin.glMinor < 2 )
+    {
+        return GL_RGBA;
+    }
+
+    return GL_BGRA;
+}
+
+
+//========================================================================
+// Read back the frame about to be presented for the recorder and the
+// shared memory export (called by glfwSwapBuffers)
+//========================================================================
+
+void _glfwRecordFrame( void )
+{
+    if( _glfwRecorder.Active || _glfwExport.Active )
+    {
+        ReadFrame( NULL, NULL, GL_TRUE );
+    }
+}
+
+
+//========================================================================
+// Deliver captures whose read-back has completed (called once per frame
+// by glfwSwapBuffers)
+//========================================================================
+
+void _glfwServiceCaptures( void )
+{
+    int i;
+    _GLFWcaptureslot *slot;
+
+    if( !_glfwCapture.Initialized )
+    {
+        return;
+    }
+
+    _glfwCapture.Frame ++;
+
+    for( i = 0; i < _GLFW_CAPTURE_SLOTS; i ++ )
+    {
+        slot = &_glfwCapture.Slots[ (_glfwCapture.NextSlot + i) %
+                                    _GLFW_CAPTURE_SLOTS ];
+        if( slot->Pending &&
+            _glfwCapture.Frame - slot->Frame >= _GLFW_CAPTURE_LATENCY )
+        {
+            FinishCapture( slot );
+        }
+    }
+}
+
+
+//========================================================================
+// Finish pending captures, release pixel buffers and stop the encoder
+// thread (called when the OpenGL context goes away)
+//========================================================================
+
+void _glfwTerminateCapture( void )
+{
+    int i;
+
+    // The recorder needs the read-back ring to deliver its last frames
+    glfwStopRecording();
+    glfwStopExport();
+
+    if( !_glfwCapture.Initialized )
+    {
+        return;
+    }
+
+    if( _glfwCapture.HasPBO && _glfwWin.opened )
+    {
+        _glfwFinishCaptures();
+
+        for( i = 0; i < _GLFW_CAPTURE_SLOTS; i ++ )
+        {
+            if( _glfwCapture.Slots[ i ].Buffer )
+            {
+                _glfwCapture.DeleteBuffers( 1,
+                    &_glfwCapture.Slots[ i ].Buffer );
+            }
+        }
+    }
+
+    // Let the encoder thread write out everything before it exits
+    if( _glfwCapture.Threaded )
+    {
+        glfwLockMutex( _glfwCapture.Mutex );
+        _glfwCapture.Quit = GL_TRUE;
+        glfwBroadcastCond( _glfwCapture.Cond );
+        glfwUnlockMutex( _glfwCapture.Mutex );
+
+        glfwWaitThread( _glfwCapture.Thread, GLFW_WAIT );
+
+        glfwDestroyCond( _glfwCapture.Cond );
+        glfwDestroyMutex( _glfwCapture.Mutex );
+    }
+
+    memset( &_glfwCapture, 0, sizeof(_glfwCapture) );
+}
+
+
+//************************************************************************
+//****                    GLFW user functions                         ****
+//************************************************************************
+
+//========================================================================
+// Capture the current read buffer. The pixels are passed to cbfun a few
+// frames later or, if cbfun is NULL, written to the named TGA file.
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwCaptureFrameAsync( const char *name, GLFWcapturefun cbfun )
+{
+    char *copy;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwWin.opened )
+    {
+        return GL_FALSE;
+    }
+
+    if( name == NULL && cbfun == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    copy = NULL;
+    if( !cbfun )
+    {
+        copy = (char *) malloc( strlen( name ) + 1 );
+        if( copy == NULL )
+        {
+            return GL_FALSE;
+        }
+        strcpy( copy, name );
+    }
+
+    return ReadFrame( copy, cbfun, GL_FALSE );
+}
+
+
+//========================================================================
+// Finish all pending captures and wait until they have been written
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwWaitCaptures( void )
+{
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwCapture.Initialized )
+    {
+        return;
+    }
+
+    if( _glfwCapture.HasPBO && _glfwWin.opened )
+    {
+        _glfwFinishCaptures();
+    }
+
+    if( _glfwCapture.Threaded )
+    {
+        glfwLockMutex( _glfwCapture.Mutex );
+        while( _glfwCapture.ActiveJobs > 0 )
+        {
+            glfwWaitCond( _glfwCapture.Cond, _glfwCapture.Mutex,
+                          GLFW_INFINITY );
+        }
+        glfwUnlockMutex( _glfwCapture.Mutex );
+    }
+}
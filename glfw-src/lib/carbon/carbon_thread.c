@@ -31,6 +31,8 @@
 
 #include "internal.h"
 
+#include <mach/mach.h>
+
 
 
 //************************************************************************
@@ -43,25 +45,17 @@
 
 void * _glfwNewThread( void * arg )
 {
-    GLFWthreadfun threadfun;
-    _GLFWthread   *t;
-
-    // Get pointer to thread information for current thread
-    t = _glfwGetThreadPointer( glfwGetThreadID() );
-    if( t == NULL )
-    {
-        return 0;
-    }
+    _GLFWthread *t = (_GLFWthread *) arg;
 
-    // Get user thread function pointer
-    threadfun = t->Function;
+    // Remember the thread record for glfwGetThreadID
+    pthread_setspecific( _glfwThrd.Key, t );
 
     // Call the user thread function
-    threadfun( arg );
+    t->Function( t->Arg );
 
-    // Remove thread from thread list
+    // Release the thread record
     ENTER_THREAD_CRITICAL_SECTION
-        _glfwRemoveThread( t );
+    _glfwFinishThread( t );
     LEAVE_THREAD_CRITICAL_SECTION
 
     // When the thread function returns, the thread will die...
@@ -69,6 +63,26 @@ void * _glfwNewThread( void * arg )
 }
 
 
+//========================================================================
+// Find the record of a thread, including that of the calling thread
+// before its ID has been published. Must be called inside the thread
+// critical section
+//========================================================================
+
+static _GLFWthread * GetThreadRecord( GLFWthread ID )
+{
+    _GLFWthread *t;
+
+    t = (_GLFWthread *) pthread_getspecific( _glfwThrd.Key );
+    if( t != NULL && _GLFW_THREAD_ID( t->Slot, t->Generation ) == ID )
+    {
+        return t;
+    }
+
+    return _glfwGetThreadPointer( ID );
+}
+
+
 
 //************************************************************************
 //****               Platform implementation functions                ****
@@ -82,47 +96,40 @@ GLFWthread _glfwPlatformCreateThread( GLFWthreadfun fun, void *arg )
 {
     GLFWthread  ID;
     _GLFWthread *t;
+    pthread_t   posixID;
     int         result;
 
-    // Enter critical section
+    // Allocate a thread record
     ENTER_THREAD_CRITICAL_SECTION
-
-    // Create a new thread information memory area
-    t = (_GLFWthread *) malloc( sizeof(_GLFWthread) );
+    t = _glfwAllocThread( fun, arg );
+    LEAVE_THREAD_CRITICAL_SECTION
     if( t == NULL )
     {
-        // Leave critical section
-        LEAVE_THREAD_CRITICAL_SECTION
         return -1;
     }
 
-    // Get a new unique thread id
-    ID = _glfwThrd.NextID ++;
-
-    // Store thread information in the thread list
-    t->Function = fun;
-    t->ID       = ID;
-
     // Create thread
     result = pthread_create(
-                            &t->PosixID,      // Thread handle
-                            NULL,             // Default thread attributes
-                            _glfwNewThread,   // Thread function (a wrapper function)
-                            (void *)arg       // Argument to thread is user argument
-                            );
+        &posixID,         // Thread handle
+        NULL,             // Default thread attributes
+        _glfwNewThread,   // Thread function (a wrapper function)
+        (void *)t         // Argument to thread is the thread record
+    );
+
+    ENTER_THREAD_CRITICAL_SECTION
 
     // Did the thread creation fail?
     if( result != 0 )
     {
-        free( (void *) t );
+        _glfwFreeThread( t );
         LEAVE_THREAD_CRITICAL_SECTION
         return -1;
     }
 
-    // Append thread to thread list
-    _glfwAppendThread( t );
+    // Make the thread visible to glfwWaitThread and glfwDestroyThread
+    t->PosixID = posixID;
+    ID = _glfwPublishThread( t );
 
-    // Leave critical section
     LEAVE_THREAD_CRITICAL_SECTION
 
     // Return the GLFW thread ID
@@ -153,8 +160,8 @@ void _glfwPlatformDestroyThread( GLFWthread ID )
     // Simply murder the process, no mercy!
     pthread_kill( t->PosixID, SIGKILL );
 
-    // Remove thread from thread list
-    _glfwRemoveThread( t );
+    // Release the thread record
+    _glfwFreeThread( t );
 
     // Leave critical section
     LEAVE_THREAD_CRITICAL_SECTION
@@ -170,31 +177,29 @@ int _glfwPlatformWaitThread( GLFWthread ID, int waitmode )
     pthread_t   thread;
     _GLFWthread *t;
 
-    // Enter critical section
-    ENTER_THREAD_CRITICAL_SECTION
-
     // Get thread information pointer
     t = _glfwGetThreadPointer( ID );
 
     // Is the thread already dead?
     if( t == NULL )
     {
-        LEAVE_THREAD_CRITICAL_SECTION
         return GL_TRUE;
     }
 
     // If got this far, the thread is alive => polling returns FALSE
     if( waitmode == GLFW_NOWAIT )
     {
-        LEAVE_THREAD_CRITICAL_SECTION
         return GL_FALSE;
     }
 
-    // Get thread handle
+    // Get thread handle, and make sure the record was not reused for
+    // another thread while reading it
     thread = t->PosixID;
-
-    // Leave critical section
-    LEAVE_THREAD_CRITICAL_SECTION
+    _glfwPlatformMemoryBarrier();
+    if( t->ID != ID )
+    {
+        return GL_TRUE;
+    }
 
     // Wait for thread to die
     (void) pthread_join( thread, NULL );
@@ -210,31 +215,140 @@ int _glfwPlatformWaitThread( GLFWthread ID, int waitmode )
 GLFWthread _glfwPlatformGetThreadID( void )
 {
     _GLFWthread *t;
-    GLFWthread  ID = -1;
-    pthread_t   posixID;
 
-    // Get current thread ID
-    posixID = pthread_self();
+    // Get the thread record of this thread
+    t = (_GLFWthread *) pthread_getspecific( _glfwThrd.Key );
+    if( t == NULL )
+    {
+        return -1;
+    }
 
-    // Enter critical section
-    ENTER_THREAD_CRITICAL_SECTION
+    // The record may not have been published yet, so build the ID
+    return _GLFW_THREAD_ID( t->Slot, t->Generation );
+}
+
+
+//========================================================================
+// Restrict a thread to the processors in a mask. Mac OS X only has
+// affinity tags, which are hints that cannot express a processor mask
+//========================================================================
+
+int _glfwPlatformSetThreadAffinity( GLFWthread ID, unsigned int mask )
+{
+    return GL_FALSE;
+}
+
+
+//========================================================================
+// Change the scheduling priority of a thread
+//========================================================================
+
+int _glfwPlatformSetThreadPriority( GLFWthread ID, int priority )
+{
+    _GLFWthread        *t;
+    struct sched_param param;
+    int                policy = SCHED_OTHER, result = GL_FALSE;
+
+    memset( &param, 0, sizeof( param ) );
 
-    // Loop through entire list of threads to find the matching POSIX
-    // thread ID
-    for( t = &_glfwThrd.First; t != NULL; t = t->Next )
+    switch( priority )
     {
-        if( t->PosixID == posixID )
-        {
-            ID = t->ID;
+        case GLFW_THREAD_PRIORITY_LOW:
+            param.sched_priority = sched_get_priority_min( SCHED_OTHER );
+            break;
+        case GLFW_THREAD_PRIORITY_HIGH:
+            param.sched_priority = sched_get_priority_max( SCHED_OTHER );
+            break;
+        case GLFW_THREAD_PRIORITY_REALTIME:
+            policy = SCHED_RR;
+            param.sched_priority = sched_get_priority_max( SCHED_RR );
+            break;
+        default:
+            param.sched_priority = (sched_get_priority_min( SCHED_OTHER ) +
+                                    sched_get_priority_max( SCHED_OTHER )) / 2;
             break;
-        }
     }
 
-    // Leave critical section
+    ENTER_THREAD_CRITICAL_SECTION
+    t = GetThreadRecord( ID );
+    if( t != NULL &&
+        pthread_setschedparam( t->PosixID, policy, &param ) == 0 )
+    {
+        result = GL_TRUE;
+    }
     LEAVE_THREAD_CRITICAL_SECTION
 
-    // Return the found GLFW thread identifier
-    return ID;
+    return result;
+}
+
+
+//========================================================================
+// Name a thread for debuggers and profilers. Mac OS X 10.6 and later
+// can only name the calling thread
+//========================================================================
+
+int _glfwPlatformSetThreadName( GLFWthread ID, const char *name )
+{
+#if defined( MAC_OS_X_VERSION_10_6 )
+    if( ID != _glfwPlatformGetThreadID() )
+    {
+        return GL_FALSE;
+    }
+
+    return pthread_setname_np( name ) == 0 ? GL_TRUE : GL_FALSE;
+#else
+    return GL_FALSE;
+#endif
+}
+
+
+//========================================================================
+// Get the CPU time of a thread. Mac OS X has no per-thread context
+// switch counts, so they are left unknown
+//========================================================================
+
+int _glfwPlatformGetThreadStats( GLFWthread ID, GLFWthreadstats *stats )
+{
+    _GLFWthread              *t;
+    thread_basic_info_data_t info;
+    mach_msg_type_number_t   count = THREAD_BASIC_INFO_COUNT;
+    mach_port_t              port;
+
+    ENTER_THREAD_CRITICAL_SECTION
+
+    t = GetThreadRecord( ID );
+    if( t == NULL )
+    {
+        LEAVE_THREAD_CRITICAL_SECTION
+        return GL_FALSE;
+    }
+
+    stats->CreationTime = t->CreationTime;
+    stats->RunTime      = _glfwGetSteadyTime() - t->StartTime;
+
+    // The POSIX ID of the calling thread may not have been stored yet
+    if( t == (_GLFWthread *) pthread_getspecific( _glfwThrd.Key ) )
+    {
+        port = pthread_mach_thread_np( pthread_self() );
+    }
+    else
+    {
+        port = pthread_mach_thread_np( t->PosixID );
+    }
+
+    if( thread_info( port, THREAD_BASIC_INFO, (thread_info_t) &info,
+                     &count ) == KERN_SUCCESS )
+    {
+        stats->CPUTime =
+            (double) info.user_time.seconds +
+            (double) info.user_time.microseconds * 1e-6 +
+            (double) info.system_time.seconds +
+            (double) info.system_time.microseconds * 1e-6;
+    }
+
+    LEAVE_THREAD_CRITICAL_SECTION
+
+    return GL_TRUE;
 }
 
 
@@ -343,7 +457,7 @@ void _glfwPlatformWaitCond( GLFWcond cond, GLFWmutex mutex,
 {
     struct timeval  currenttime;
     struct timespec wait;
-    long dt_sec, dt_usec;
+    long dt_sec, dt_nsec;
 
     // Select infinite or timed wait
     if( timeout >= GLFW_INFINITY )
@@ -357,9 +471,9 @@ void _glfwPlatformWaitCond( GLFWcond cond, GLFWmutex mutex,
         // Set timeout time, relatvie to current time
         gettimeofday( &currenttime, NULL );
         dt_sec  = (long) timeout;
-        dt_usec = (long) ((timeout - (double)dt_sec) * 1000000.0);
-        wait.tv_nsec = (currenttime.tv_usec + dt_usec) * 1000L;
-        if( wait.tv_nsec > 1000000000L )
+        dt_nsec = (long) ((timeout - (double)dt_sec) * 1000000000.0);
+        wait.tv_nsec = currenttime.tv_usec * 1000L + dt_nsec;
+        if( wait.tv_nsec >= 1000000000L )
         {
             wait.tv_nsec -= 1000000000L;
             dt_sec ++;
@@ -373,6 +487,30 @@ void _glfwPlatformWaitCond( GLFWcond cond, GLFWmutex mutex,
 }
 
 
+//========================================================================
+// Wait for a condition to be raised or the timer to reach a given value
+//========================================================================
+
+void _glfwPlatformWaitCondUntil( GLFWcond cond, GLFWmutex mutex,
+                                 double time )
+{
+    double timeout = GLFW_INFINITY;
+
+    // Turn the timer value into a timeout, as the system waits only
+    // support those
+    if( time < GLFW_INFINITY )
+    {
+        timeout = time - _glfwPlatformGetTime();
+        if( timeout < 0.0 )
+        {
+            timeout = 0.0;
+        }
+    }
+
+    _glfwPlatformWaitCond( cond, mutex, timeout );
+}
+
+
 //========================================================================
 // Signal a condition to one waiting thread
 //========================================================================
@@ -408,3 +546,99 @@ int _glfwPlatformGetNumberOfProcessors( void )
     return n;
 }
 
+
+//========================================================================
+// Describe the processors this process may use
+//========================================================================
+
+int _glfwPlatformGetCPUTopology( GLFWcputopology *topology )
+{
+    int    i, cores;
+    size_t len = sizeof( cores );
+
+    // Mac OS X has neither affinity masks nor CPU quotas, and does not
+    // tell which processors share a cache
+    topology->OnlineCount = _glfwPlatformGetNumberOfProcessors();
+    topology->UsableCount = topology->OnlineCount;
+    topology->CoreCount = topology->OnlineCount;
+    for( i = 0; i < topology->OnlineCount && i < 32; i ++ )
+    {
+        topology->UsableMask |= 1U << i;
+    }
+
+    if( sysctlbyname( "hw.physicalcpu", &cores, &len, NULL, 0 ) == 0 &&
+        cores > 0 && cores < topology->CoreCount )
+    {
+        topology->CoreCount = cores;
+    }
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Atomically add to an integer and return the new value
+//========================================================================
+
+int _glfwPlatformAtomicAdd( volatile int *value, int delta )
+{
+#if defined(__GNUC__)
+    return __sync_add_and_fetch( value, delta );
+#else
+    int result;
+
+    ENTER_THREAD_CRITICAL_SECTION
+    result = (*value += delta);
+    LEAVE_THREAD_CRITICAL_SECTION
+
+    return result;
+#endif
+}
+
+
+//========================================================================
+// Atomically replace an integer if it still has the expected value
+//========================================================================
+
+int _glfwPlatformAtomicCompareAndSwap( volatile int *value, int expected,
+                                       int desired )
+{
+#if defined(__GNUC__)
+    return __sync_bool_compare_and_swap( value, expected, desired ) ?
+           GL_TRUE : GL_FALSE;
+#else
+    int result = GL_FALSE;
+
+    ENTER_THREAD_CRITICAL_SECTION
+    if( *value == expected )
+    {
+        *value = desired;
+        result = GL_TRUE;
+    }
+    LEAVE_THREAD_CRITICAL_SECTION
+
+    return result;
+#endif
+}
+
+
+//========================================================================
+// Sleep while an integer still has the given value. Mac OS X has no
+// public way of doing this, so callers fall back on a condition variable
+//========================================================================
+
+int _glfwPlatformWaitAddress( volatile int *address, int value,
+                              double timeout )
+{
+    return GL_FALSE;
+}
+
+
+//========================================================================
+// Wake threads sleeping on an integer (see _glfwPlatformWaitAddress)
+//========================================================================
+
+int _glfwPlatformWakeAddress( volatile int *address, int count )
+{
+    return GL_FALSE;
+}
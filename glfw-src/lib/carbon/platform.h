@@ -241,12 +241,20 @@ typedef struct _GLFWthread_struct _GLFWthread;
 // Thread record (one for each thread)
 struct _GLFWthread_struct {
 
-    // Pointer to previous and next threads in linked list
-    _GLFWthread   *Previous, *Next;
-
-    // GLFW user side thread information
-    GLFWthread    ID;
+    // GLFW user side thread information (ID is -1 while the record is
+    // unused or the thread is still being created)
+    volatile GLFWthread ID;
     GLFWthreadfun Function;
+    void          *Arg;
+
+    // Position in the thread table
+    int           Slot, Generation, NextFree;
+    int           Finished;
+
+    // Time of creation, in glfwGetTime time and on the clock that
+    // glfwSetTime does not move (for measuring how long it has run)
+    double        CreationTime;
+    double        StartTime;
 
     // System side thread information
     pthread_t     PosixID;
@@ -255,14 +263,18 @@ struct _GLFWthread_struct {
 // General thread information
 GLFWGLOBAL struct {
 
-    // Critical section lock
+    // Critical section lock and thread record of the current thread
     pthread_mutex_t  CriticalSection;
+    pthread_key_t    Key;
 
-    // Next thread ID to use (increments for every created thread)
-    GLFWthread       NextID;
+    // Thread table chunks (the first chunk is static, and its first
+    // record is always the main thread)
+    _GLFWthread      FirstChunk[ _GLFW_THREAD_CHUNK_SIZE ];
+    _GLFWthread      *Chunks[ _GLFW_THREAD_CHUNKS ];
 
-    // First thread in linked list (always the main thread)
-    _GLFWthread      First;
+    // Number of slots in use and head of the free slot list
+    volatile int     SlotCount;
+    int              FirstFree;
 
 } _glfwThrd;
 
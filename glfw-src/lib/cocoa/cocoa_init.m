@@ -211,18 +211,17 @@ static void glfw_atexit( void )
 
 static void initThreads( void )
 {
-    // Initialize critical section handle
-    (void) pthread_mutex_init( &_glfwThrd.CriticalSection, NULL );
+    _GLFWthread *t;
 
-    // The first thread (the main thread) has ID 0
-    _glfwThrd.NextID = 0;
+    // Initialize critical section handle and thread record key
+    (void) pthread_mutex_init( &_glfwThrd.CriticalSection, NULL );
+    (void) pthread_key_create( &_glfwThrd.Key, NULL );
 
-    // Fill out information about the main thread (this thread)
-    _glfwThrd.First.ID       = _glfwThrd.NextID ++;
-    _glfwThrd.First.Function = NULL;
-    _glfwThrd.First.PosixID  = pthread_self();
-    _glfwThrd.First.Previous = NULL;
-    _glfwThrd.First.Next     = NULL;
+    // Fill out information about the main thread (this thread), which
+    // always has ID 0
+    t = _glfwInitThreadTable();
+    t->PosixID = pthread_self();
+    pthread_setspecific( _glfwThrd.Key, t );
 }
 
 //************************************************************************
@@ -288,6 +287,14 @@ int _glfwPlatformTerminate( void )
     // TODO: Kill all non-main threads?
     // TODO: Probably other cleanup
 
+    // Free memory allocated for the thread table
+    ENTER_THREAD_CRITICAL_SECTION
+    _glfwTerminateThreadTable();
+    LEAVE_THREAD_CRITICAL_SECTION
+
+    pthread_mutex_destroy( &_glfwThrd.CriticalSection );
+    pthread_key_delete( _glfwThrd.Key );
+
     [_glfwLibrary.AutoreleasePool release];
     _glfwLibrary.AutoreleasePool = nil;
 
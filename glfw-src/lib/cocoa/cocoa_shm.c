@@ -0,0 +1,208 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Cocoa/NSOpenGL
+// API Version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2009-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+#include "internal.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+//========================================================================
+// Make a POSIX shared memory object name (a single leading slash)
+//========================================================================
+
+static char *MakeObjectName( const char *name )
+{
+    char *path;
+
+    path = (char *) malloc( strlen( name ) + 2 );
+    if( path == NULL )
+    {
+        return NULL;
+    }
+
+    path[ 0 ] = '/';
+    strcpy( path + 1, name[ 0 ] == '/' ? name + 1 : name );
+
+    return path;
+}
+
+
+
+//************************************************************************
+//****               Platform implementation functions                ****
+//************************************************************************
+
+//========================================================================
+// Create and map a named shared memory object
+//========================================================================
+
+int _glfwPlatformOpenSharedMemory( _GLFWsharedmem *mem, const char *name,
+    long size )
+{
+    int fd;
+    void *data;
+
+    mem->Name = MakeObjectName( name );
+    if( mem->Name == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    // Replace any object left behind by a process that did not clean up
+    shm_unlink( mem->Name );
+    fd = shm_open( mem->Name, O_RDWR | O_CREAT | O_EXCL, 0600 );
+    if( fd < 0 )
+    {
+        free( mem->Name );
+        mem->Name = NULL;
+        return GL_FALSE;
+    }
+
+    if( ftruncate( fd, (off_t) size ) != 0 )
+    {
+        close( fd );
+        shm_unlink( mem->Name );
+        free( mem->Name );
+        mem->Name = NULL;
+        return GL_FALSE;
+    }
+
+    data = mmap( NULL, (size_t) size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                 fd, 0 );
+
+    // The mapping keeps the object alive
+    close( fd );
+
+    if( data == MAP_FAILED )
+    {
+        shm_unlink( mem->Name );
+        free( mem->Name );
+        mem->Name = NULL;
+        return GL_FALSE;
+    }
+
+    mem->Data = data;
+    mem->Size = size;
+    mem->Handle = NULL;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Unmap and remove a shared memory object. Processes that have it mapped
+// keep their mapping.
+//========================================================================
+
+void _glfwPlatformCloseSharedMemory( _GLFWsharedmem *mem )
+{
+    if( mem->Data != NULL )
+    {
+        munmap( mem->Data, (size_t) mem->Size );
+        shm_unlink( mem->Name );
+    }
+
+    free( mem->Name );
+    memset( mem, 0, sizeof(_GLFWsharedmem) );
+}
+
+
+//========================================================================
+// Map a file read-only
+//========================================================================
+
+int _glfwPlatformMapFile( _GLFWsharedmem *mem, const char *name )
+{
+    struct stat st;
+    void *data;
+    int fd;
+
+    memset( mem, 0, sizeof(_GLFWsharedmem) );
+
+    fd = open( name, O_RDONLY );
+    if( fd < 0 )
+    {
+        return GL_FALSE;
+    }
+
+    if( fstat( fd, &st ) != 0 || st.st_size == 0 )
+    {
+        close( fd );
+        return GL_FALSE;
+    }
+
+    data = mmap( NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+
+    // The mapping keeps the file open
+    close( fd );
+
+    if( data == MAP_FAILED )
+    {
+        return GL_FALSE;
+    }
+
+    mem->Data = data;
+    mem->Size = (long) st.st_size;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Unmap a file mapped by _glfwPlatformMapFile
+//========================================================================
+
+void _glfwPlatformUnmapFile( _GLFWsharedmem *mem )
+{
+    if( mem->Data != NULL )
+    {
+        munmap( mem->Data, (size_t) mem->Size );
+    }
+
+    memset( mem, 0, sizeof(_GLFWsharedmem) );
+}
+
+
+//========================================================================
+// Order memory accesses seen by other processes
+//========================================================================
+
+void _glfwPlatformMemoryBarrier( void )
+{
+#if defined(__GNUC__)
+    __sync_synchronize();
+#endif
+}
+
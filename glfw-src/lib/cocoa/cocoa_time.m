@@ -82,7 +82,7 @@ void _glfwPlatformSleep( double time )
     dt_sec  = (long) time;
     dt_usec = (long) ((time - (double)dt_sec) * 1000000.0);
     wait.tv_nsec = (currenttime.tv_usec + dt_usec) * 1000L;
-    if( wait.tv_nsec > 1000000000L )
+    if( wait.tv_nsec >= 1000000000L )
     {
         wait.tv_nsec -= 1000000000L;
         dt_sec ++;
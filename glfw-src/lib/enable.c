@@ -227,6 +227,63 @@ static void disableAutoPollEvents( void )
     _glfwWin.autoPollEvents = 0;
 }
 
+//========================================================================
+// Enable texture memory accounting
+//========================================================================
+
+static void enableTextureAccounting( void )
+{
+    _glfwTex.Accounting = GL_TRUE;
+}
+
+//========================================================================
+// Disable texture memory accounting
+//========================================================================
+
+static void disableTextureAccounting( void )
+{
+    // Records would go stale without accounting, so forget them
+    _glfwClearTextureRecords();
+
+    _glfwTex.Accounting = GL_FALSE;
+}
+
+//========================================================================
+// Enable texture hot reloading
+//========================================================================
+
+static void enableTextureHotReload( void )
+{
+    _glfwStartHotReload();
+}
+
+//========================================================================
+// Disable texture hot reloading
+//========================================================================
+
+static void disableTextureHotReload( void )
+{
+    _glfwStopHotReload();
+}
+
+//========================================================================
+// Create new mutexes with the futex backend
+//========================================================================
+
+static void enableFutexSync( void )
+{
+    _glfwFutexSync = GL_TRUE;
+}
+
+//========================================================================
+// Create new mutexes with the default backend
+//========================================================================
+
+static void disableFutexSync( void )
+{
+    _glfwFutexSync = GL_FALSE;
+}
+
 
 
 //************************************************************************
@@ -265,6 +322,15 @@ GLFWAPI void GLFWAPIENTRY glfwEnable( int token )
         case GLFW_AUTO_POLL_EVENTS:
             enableAutoPollEvents();
             break;
+        case GLFW_TEXTURE_ACCOUNTING:
+            enableTextureAccounting();
+            break;
+        case GLFW_TEXTURE_HOT_RELOAD:
+            enableTextureHotReload();
+            break;
+        case GLFW_FUTEX_SYNC:
+            enableFutexSync();
+            break;
         default:
             break;
     }
@@ -303,6 +369,15 @@ GLFWAPI void GLFWAPIENTRY glfwDisable( int token )
         case GLFW_AUTO_POLL_EVENTS:
             disableAutoPollEvents();
             break;
+        case GLFW_TEXTURE_ACCOUNTING:
+            disableTextureAccounting();
+            break;
+        case GLFW_TEXTURE_HOT_RELOAD:
+            disableTextureHotReload();
+            break;
+        case GLFW_FUTEX_SYNC:
+            disableFutexSync();
+            break;
         default:
             break;
     }
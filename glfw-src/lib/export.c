@@ -0,0 +1,243 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Any
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+//========================================================================
+// Description:
+//
+// This module publishes presented frames in a shared memory ring, so that
+// another process (e.g. a video encoder) can pick them up without any
+// copying through pipes or sockets. Frames are read back by
+// glfwSwapBuffers through the capture ring (capture.c) and copied into
+// the oldest slot of the ring. The layout is described in
+// GL/glfwexport.h, and a reader is provided in support/export.
+//
+// The producer never waits for readers. A reader that falls more than
+// SlotCount - 1 frames behind simply misses frames, which it can tell
+// from the frame numbers.
+//
+//========================================================================
+
+#include "internal.h"
+#include "../include/GL/glfwexport.h"
+
+
+// Slots are aligned to this many bytes
+#define _GLFW_EXPORT_ALIGNMENT 64
+
+
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+//========================================================================
+// Return the header of the ring
+//========================================================================
+
+static GLFWexportheader *GetHeader( void )
+{
+    return (GLFWexportheader *) _glfwExport.Memory.Data;
+}
+
+
+//========================================================================
+// Return the header of a slot, which is followed by its pixels
+//========================================================================
+
+static GLFWexportslot *GetSlot( int index )
+{
+    return (GLFWexportslot *) ((unsigned char *) _glfwExport.Memory.Data +
+                               _GLFW_EXPORT_ALIGNMENT +
+                               index * _glfwExport.SlotSize);
+}
+
+
+//========================================================================
+// Publish a frame that has been read back (called on the main thread)
+//========================================================================
+
+void _glfwExportFrame( const GLFWimage *img, double time )
+{
+    GLFWexportslot *slot;
+    unsigned int sequence;
+    long size;
+
+    if( !_glfwExport.Active || time < _glfwExport.StartTime )
+    {
+        return;
+    }
+
+    // Frames larger than the slots (a window larger than the desktop) are
+    // skipped rather than cropped
+    size = (long) img->Height * img->RowStride;
+    if( size > _glfwExport.SlotSize - (long) sizeof(GLFWexportslot) )
+    {
+        _glfwExport.Skipped ++;
+        return;
+    }
+
+    slot = GetSlot( _glfwExport.NextSlot );
+    _glfwExport.NextSlot = (_glfwExport.NextSlot + 1) % _glfwExport.SlotCount;
+
+    // An odd sequence number tells readers that the slot is being written
+    sequence = slot->Sequence;
+    slot->Sequence = sequence + 1;
+    _glfwPlatformMemoryBarrier();
+
+    slot->Frame     = _glfwExport.Frame;
+    slot->Width     = (unsigned int) img->Width;
+    slot->Height    = (unsigned int) img->Height;
+    slot->Format    = (unsigned int) img->Format;
+    slot->RowStride = (unsigned int) img->RowStride;
+    slot->Time      = time - _glfwExport.StartTime;
+    memcpy( slot + 1, img->Data, size );
+
+    _glfwPlatformMemoryBarrier();
+    slot->Sequence = sequence + 2;
+
+    GetHeader()->Latest = _glfwExport.Frame + 1;
+    _glfwPlatformMemoryBarrier();
+
+    _glfwExport.Frame ++;
+    _glfwExport.Exported ++;
+}
+
+
+//************************************************************************
+//****                    GLFW user functions                         ****
+//************************************************************************
+
+//========================================================================
+// Start publishing every presented frame in a named shared memory ring
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwStartExport( const char *name, int slots )
+{
+    GLFWexportheader *header;
+    GLFWvidmode mode;
+    long width, height, size;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwWin.opened )
+    {
+        return GL_FALSE;
+    }
+
+    if( _glfwExport.Active || name == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    // A reader needs at least one slot that is not being written
+    if( slots < 2 )
+    {
+        slots = 2;
+    }
+
+    // Make room for frames as large as the desktop, so that the ring does
+    // not have to be resized when the window is
+    _glfwPlatformGetDesktopMode( &mode );
+    width = mode.Width > _glfwWin.width ? mode.Width : _glfwWin.width;
+    height = mode.Height > _glfwWin.height ? mode.Height : _glfwWin.height;
+
+    memset( &_glfwExport, 0, sizeof(_glfwExport) );
+    _glfwExport.SlotCount = slots;
+    _glfwExport.SlotSize = (long) sizeof(GLFWexportslot) + width * height * 4;
+    _glfwExport.SlotSize = (_glfwExport.SlotSize + _GLFW_EXPORT_ALIGNMENT - 1) /
+                           _GLFW_EXPORT_ALIGNMENT * _GLFW_EXPORT_ALIGNMENT;
+
+    size = _GLFW_EXPORT_ALIGNMENT + slots * _glfwExport.SlotSize;
+    if( !_glfwPlatformOpenSharedMemory( &_glfwExport.Memory, name, size ) )
+    {
+        memset( &_glfwExport, 0, sizeof(_glfwExport) );
+        return GL_FALSE;
+    }
+
+    header = GetHeader();
+    memset( header, 0, size );
+    header->Version    = GLFW_EXPORT_VERSION;
+    header->HeaderSize = _GLFW_EXPORT_ALIGNMENT;
+    header->SlotCount  = (unsigned int) slots;
+    header->SlotSize   = (unsigned int) _glfwExport.SlotSize;
+
+    // The magic goes in last, so readers never see a partial header
+    _glfwPlatformMemoryBarrier();
+    memcpy( header->Magic, GLFW_EXPORT_MAGIC, 8 );
+    _glfwPlatformMemoryBarrier();
+
+    _glfwExport.StartTime = _glfwPlatformGetTime();
+    _glfwExport.Active = GL_TRUE;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Stop publishing frames and remove the shared memory ring
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwStopExport( void )
+{
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwExport.Active )
+    {
+        return;
+    }
+
+    _glfwExport.Active = GL_FALSE;
+
+    // Readers that still have the ring mapped keep the last frames
+    GetHeader()->Closed = 1;
+    _glfwPlatformMemoryBarrier();
+
+    _glfwPlatformCloseSharedMemory( &_glfwExport.Memory );
+}
+
+
+//========================================================================
+// Get export counters (any pointer may be NULL)
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwGetExportStats( int *exported, int *skipped )
+{
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return;
+    }
+
+    if( exported )
+    {
+        *exported = _glfwExport.Exported;
+    }
+    if( skipped )
+    {
+        *skipped = _glfwExport.Skipped;
+    }
+}
@@ -38,9 +38,35 @@
 // to the next higher 2^N x 2^M resolution, unless it has a valid
 // 2^N x 2^M resolution. The interpolation is quite slow, even if the
 // routine has been optimized for speed (a 200x200 RGB image is scaled to
-// 256x256 in ~30 ms on a P3-500).
+// 256x256 in ~30 ms on a P3-500). With GLFW_RESCALE_NEAREST_POT_BIT, each
+// dimension goes to the closest power of two instead, which may be
+// smaller, and the image is filtered with the resampler in resample.c.
+// Images can also be resized to any size with glfwResizeImage.
 //
-// Paletted images are converted to RGB/RGBA images.
+// Paletted images are converted to RGB/RGBA images, unless
+// GLFW_INDEXED_BIT is set. Then they keep their 8-bit indices and palette,
+// and are either expanded when uploaded (through a scratch buffer that is
+// reused between uploads) or uploaded as an index texture, with
+// glfwLoadPaletteTexture2D providing the palette texture. RGBA images can
+// optionally have their color channels premultiplied by alpha, in which
+// case rescaling and software mipmap generation are done in premultiplied
+// space as well.
+//
+// For faster texture uploads, RGB images can be expanded to RGBA and rows
+// can be padded to a four byte boundary. The row stride is recorded in the
+// image, and the unpack alignment is chosen to match it when uploading.
+//
+// Images can be written to disk with glfwWriteImage (TGA format only).
+//
+// Reading, writing and freeing images does not touch the window or any
+// other global state apart from the pack and hot reloading lists, and so
+// works before glfwInit (e.g. on machines without a display) and from any
+// number of threads at once. All decoder state lives in the stream and
+// the image being read.
+//
+// Named images are looked up in mounted pack files (pack.c) before the
+// file system. Images read from the file system can be hot reloaded
+// (reload.c).
 //
 // A convenience function is also included (glfwLoadTexture2D), which
 // loads a texture image from a file directly to OpenGL texture memory,
@@ -50,6 +76,10 @@
 // method is included when GL_SGIS_generate_mipmap is not supported (it
 // generates all mipmaps of a 256x256 RGB texture in ~3 ms on a P3-500).
 //
+// Parts of an existing texture can be replaced with glfwUpdateTextureRegion,
+// which in the software fallback only rebuilds the mipmap texels covered by
+// the updated region.
+//
 //========================================================================
 
 
@@ -140,15 +170,40 @@ static void UpsampleImage( unsigned char *src, unsigned char *dst,
 }
 
 
+//========================================================================
+// Resize image without filtering, from size w1 x h1 to w2 x h2
+//========================================================================
+
+static void PointSampleImage( const unsigned char *src, unsigned char *dst,
+    int w1, int h1, int w2, int h2, int bpp )
+{
+    const unsigned char *row;
+    int m, n, k;
+
+    for( n = 0; n < h2; n ++ )
+    {
+        row = src + (long) ((2 * n + 1) * h1 / (2 * h2)) * w1 * bpp;
+        for( m = 0; m < w2; m ++ )
+        {
+            for( k = 0; k < bpp; k ++ )
+            {
+                *dst ++ = row[ ((2 * m + 1) * w1 / (2 * w2)) * bpp + k ];
+            }
+        }
+    }
+}
+
+
 //========================================================================
 // Build the next mip-map level
 //========================================================================
 
-static int HalveImage( GLubyte *src, int *width, int *height,
-    int components )
+int _glfwHalveImage( GLubyte *src, int *width, int *height,
+    int components, int *stride, int alignment )
 {
-    int     halfwidth, halfheight, m, n, k, idx1, idx2;
-    GLubyte *dst;
+    int     halfwidth, halfheight, halfstride, m, n, k, idx1, idx2;
+    int     srcstep, dststep;
+    GLubyte *dst, *srcrow, *dstrow;
 
     // Last level?
     if( *width <= 1 && *height <= 1 )
@@ -160,86 +215,104 @@ static int HalveImage( GLubyte *src, int *width, int *height,
     halfwidth  = *width > 1 ? *width / 2 : 1;
     halfheight = *height > 1 ? *height / 2 : 1;
 
+    // Rows of the new level keep the alignment of the source rows
+    halfstride = (halfwidth * components + alignment - 1) /
+                 alignment * alignment;
+
     // Downsample image with a simple box-filter
-    dst = src;
     if( *width == 1 || *height == 1 )
     {
-        // 1D case
+        // 1D case (a single column has its pixels one row apart)
+        srcstep = *width == 1 ? *stride : components;
+        dststep = *width == 1 ? halfstride : components;
         for( m = 0; m < halfwidth+halfheight-1; m ++ )
         {
+            dst = src + m * dststep;
+            srcrow = src + 2 * m * srcstep;
             for( k = 0; k < components; k ++ )
             {
-                *dst ++ = (GLubyte) (((int)*src +
-                                      (int)src[components] + 1) >> 1);
-                src ++;
+                dst[ k ] = (GLubyte) (((int)srcrow[ k ] +
+                                       (int)srcrow[ srcstep + k ] + 1) >> 1);
             }
-            src += components;
         }
     }
     else
     {
         // 2D case
-        idx1 = *width*components;
-        idx2 = (*width+1)*components;
+        idx1 = *stride;
+        idx2 = *stride + components;
         for( m = 0; m < halfheight; m ++ )
         {
+            srcrow = src + 2 * m * (*stride);
+            dstrow = src + m * halfstride;
             for( n = 0; n < halfwidth; n ++ )
             {
                 for( k = 0; k < components; k ++ )
                 {
-                    *dst ++ = (GLubyte) (((int)*src +
-                                          (int)src[components] +
-                                          (int)src[idx1] +
-                                          (int)src[idx2] + 2) >> 2);
-                    src ++;
+                    *dstrow ++ = (GLubyte) (((int)*srcrow +
+                                             (int)srcrow[components] +
+                                             (int)srcrow[idx1] +
+                                             (int)srcrow[idx2] + 2) >> 2);
+                    srcrow ++;
                 }
-                src += components;
+                srcrow += components;
             }
-            src += components * (*width);
         }
     }
 
-    // Return new width and height
+    // Return new width, height and row stride
     *width = halfwidth;
     *height = halfheight;
+    *stride = halfstride;
 
     return GL_TRUE;
 }
 
 
 //========================================================================
-// Rescales an image into power-of-two dimensions
+// Return the power of two closest to size, or the next larger one
 //========================================================================
 
-static int RescaleImage( GLFWimage* image )
+static int PowerOfTwo( int size, int nearest )
 {
-    int     width, height, log2, newsize;
-    unsigned char *data;
+    int log2, pot;
 
-    // Calculate next larger 2^N width
-    for( log2 = 0, width = image->Width; width > 1; width >>= 1, log2 ++ )
+    // Calculate next larger 2^N
+    for( log2 = 0, pot = size; pot > 1; pot >>= 1, log2 ++ )
       ;
 
-    width  = (int) 1 << log2;
-    if( width < image->Width )
+    pot = (int) 1 << log2;
+    if( pot < size )
     {
-        width <<= 1;
+        // Round down only if that is strictly closer
+        if( !nearest || size - pot >= ( pot << 1 ) - size )
+        {
+            pot <<= 1;
+        }
     }
 
-    // Calculate next larger 2^M height
-    for( log2 = 0, height = image->Height; height > 1; height >>= 1, log2 ++ )
-      ;
+    return pot;
+}
 
-    height = (int) 1 << log2;
-    if( height < image->Height )
-    {
-        height <<= 1;
-    }
+
+//========================================================================
+// Rescales an image into power-of-two dimensions
+//========================================================================
+
+static int RescaleImage( GLFWimage* image, int flags )
+{
+    int     width, height, newsize, nearest;
+    unsigned char *data;
+
+    nearest = ( flags & GLFW_RESCALE_NEAREST_POT_BIT ) ? GL_TRUE : GL_FALSE;
+
+    width  = PowerOfTwo( image->Width, nearest );
+    height = PowerOfTwo( image->Height, nearest );
 
     // Do we really need to rescale?
     if( width != image->Width || height != image->Height )
     {
-        // Allocate memory for new (upsampled) image data
+        // Allocate memory for new (resampled) image data
         newsize = width * height * image->BytesPerPixel;
         data = (unsigned char *) malloc( newsize );
         if( data == NULL )
@@ -248,9 +321,35 @@ static int RescaleImage( GLFWimage* image )
             return GL_FALSE;
         }
 
-        // Copy old image data to new image data with interpolation
-        UpsampleImage( image->Data, data, image->Width, image->Height,
-                       width, height, image->BytesPerPixel );
+        if( image->Palette )
+        {
+            // Palette indices cannot be interpolated
+            PointSampleImage( image->Data, data, image->Width,
+                              image->Height, width, height,
+                              image->BytesPerPixel );
+        }
+        else if( nearest )
+        {
+            // Shrinking needs a real filter to avoid aliasing
+            if( !_glfwResampleImage( image->Data, image->Width,
+                                     image->Height,
+                                     image->Width * image->BytesPerPixel,
+                                     data, width, height,
+                                     width * image->BytesPerPixel,
+                                     image->BytesPerPixel,
+                                     GLFW_TRIANGLE_FILTER ) )
+            {
+                free( data );
+                free( image->Data );
+                return GL_FALSE;
+            }
+        }
+        else
+        {
+            // Copy old image data to new image data with interpolation
+            UpsampleImage( image->Data, data, image->Width, image->Height,
+                           width, height, image->BytesPerPixel );
+        }
 
         // Free memory for old image data (not needed anymore)
         free( image->Data );
@@ -265,122 +364,162 @@ static int RescaleImage( GLFWimage* image )
 }
 
 
-//************************************************************************
-//****                    GLFW user functions                         ****
-//************************************************************************
-
 //========================================================================
-// Read an image from a named file
+// Premultiply the color channels of an RGBA image by its alpha channel
 //========================================================================
 
-GLFWAPI int GLFWAPIENTRY glfwReadImage( const char *name, GLFWimage *img,
-    int flags )
+static void PremultiplyAlpha( unsigned char *data, int count )
 {
-    _GLFWstream stream;
+    unsigned int alpha, t;
+    int n;
 
-    // Is GLFW initialized?
-    if( !_glfwInitialized )
+    // Division by 255 is replaced by (t + (t >> 8)) >> 8 with
+    // t = c*a + 128, which is correctly rounded for all 8-bit inputs. The
+    // loop has no branches or divisions, so the compiler can vectorize it.
+    for( n = 0; n < count; n ++ )
     {
-        return GL_FALSE;
+        alpha = data[ 3 ];
+
+        t = data[ 0 ] * alpha + 128;
+        data[ 0 ] = (unsigned char) ((t + (t >> 8)) >> 8);
+        t = data[ 1 ] * alpha + 128;
+        data[ 1 ] = (unsigned char) ((t + (t >> 8)) >> 8);
+        t = data[ 2 ] * alpha + 128;
+        data[ 2 ] = (unsigned char) ((t + (t >> 8)) >> 8);
+
+        data += 4;
     }
+}
 
-    // Start with an empty image descriptor
-    img->Width         = 0;
-    img->Height        = 0;
-    img->BytesPerPixel = 0;
-    img->Data          = NULL;
 
-    // Open file
-    if( !_glfwOpenFileStream( &stream, name, "rb" ) )
+//========================================================================
+// Expand an RGB image to RGBA with an opaque alpha channel
+//========================================================================
+
+static int ExpandToRGBA( GLFWimage *img )
+{
+    unsigned char *data, *src, *dst;
+    int n;
+
+    data = (unsigned char *) realloc( img->Data,
+                                      img->Width * img->Height * 4 );
+    if( data == NULL )
     {
+        free( img->Data );
+        img->Data = NULL;
         return GL_FALSE;
     }
 
-    // We only support TGA files at the moment
-    if( !_glfwReadTGA( &stream, img, flags ) )
+    // Expand back to front so that no pixel is overwritten before it has
+    // been read
+    src = data + img->Width * img->Height * 3;
+    dst = data + img->Width * img->Height * 4;
+    for( n = img->Width * img->Height; n > 0; n -- )
     {
-        _glfwCloseStream( &stream );
-        return GL_FALSE;
+        *-- dst = 255;
+        *-- dst = *-- src;
+        *-- dst = *-- src;
+        *-- dst = *-- src;
     }
 
-    // Close stream
-    _glfwCloseStream( &stream );
+    img->Data          = data;
+    img->BytesPerPixel = 4;
 
-    // Should we rescale the image to closest 2^N x 2^M resolution?
-    if( !(flags & GLFW_NO_RESCALE_BIT) )
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Pad the rows of a tightly packed image to a four byte boundary
+//========================================================================
+
+static int PadImageRows( GLFWimage *img )
+{
+    unsigned char *data;
+    int rowsize, stride, n;
+
+    rowsize = img->Width * img->BytesPerPixel;
+    stride  = (rowsize + 3) & ~3;
+
+    if( stride != rowsize )
     {
-        if( !RescaleImage( img ) )
+        data = (unsigned char *) realloc( img->Data, stride * img->Height );
+        if( data == NULL )
         {
+            free( img->Data );
+            img->Data = NULL;
             return GL_FALSE;
         }
-    }
 
-    // Interpret BytesPerPixel as an OpenGL format
-    switch( img->BytesPerPixel )
-    {
-        default:
-        case 1:
-            if( flags & GLFW_ALPHA_MAP_BIT )
-            {
-                img->Format = GL_ALPHA;
-            }
-            else
-            {
-                img->Format = GL_LUMINANCE;
-            }
-            break;
-        case 3:
-            img->Format = GL_RGB;
-            break;
-        case 4:
-            img->Format = GL_RGBA;
-            break;
+        // Move rows back to front, as with the RGBA expansion
+        for( n = img->Height - 1; n > 0; n -- )
+        {
+            memmove( data + n * stride, data + n * rowsize, rowsize );
+        }
+
+        img->Data = data;
     }
 
+    img->RowStride = stride;
+
     return GL_TRUE;
 }
 
 
 //========================================================================
-// Read an image file from a memory buffer
+// Return the unpack alignment matching the rows of an image
 //========================================================================
 
-GLFWAPI int GLFWAPIENTRY glfwReadMemoryImage( const void *data, long size, GLFWimage *img, int flags )
+int _glfwGetRowAlignment( const GLFWimage *img )
 {
-    _GLFWstream stream;
+    int rowsize;
 
-    // Is GLFW initialized?
-    if( !_glfwInitialized )
+    rowsize = img->Width * img->BytesPerPixel;
+
+    // Images not produced by glfwReadImage may not have a valid stride,
+    // so anything but exactly padded rows is treated as tightly packed
+    if( (rowsize & 3) == 0 || img->RowStride == ((rowsize + 3) & ~3) )
     {
-        return GL_FALSE;
+        return 4;
     }
 
-    // Start with an empty image descriptor
-    img->Width         = 0;
-    img->Height        = 0;
-    img->BytesPerPixel = 0;
-    img->Data          = NULL;
+    return 1;
+}
 
-    // Open buffer
-    if( !_glfwOpenBufferStream( &stream, (void*) data, size ) )
+
+//========================================================================
+// Post-decode pass shared by the image readers: pixel conversion,
+// rescaling and OpenGL format selection
+//========================================================================
+
+static int PostProcessImage( GLFWimage *img, int flags )
+{
+    // Premultiply alpha before any filtering is done, so that rescaling
+    // and mipmap generation both operate in premultiplied space
+    if( (flags & GLFW_PREMULTIPLY_ALPHA_BIT) && img->BytesPerPixel == 4 )
     {
-        return GL_FALSE;
+        PremultiplyAlpha( img->Data, img->Width * img->Height );
     }
-
-    // We only support TGA files at the moment
-    if( !_glfwReadTGA( &stream, img, flags ) )
+    if( (flags & GLFW_PREMULTIPLY_ALPHA_BIT) && img->Palette &&
+        img->PaletteFormat == GL_RGBA )
     {
-        _glfwCloseStream( &stream );
-        return GL_FALSE;
+        PremultiplyAlpha( img->Palette, 256 );
     }
 
-    // Close stream
-    _glfwCloseStream( &stream );
+    // Expand RGB to RGBA, which is the fastest format for most drivers to
+    // unpack
+    if( (flags & GLFW_EXPAND_RGBA_BIT) && img->BytesPerPixel == 3 )
+    {
+        if( !ExpandToRGBA( img ) )
+        {
+            return GL_FALSE;
+        }
+    }
 
     // Should we rescale the image to closest 2^N x 2^M resolution?
     if( !(flags & GLFW_NO_RESCALE_BIT) )
     {
-        if( !RescaleImage( img ) )
+        if( !RescaleImage( img, flags ) )
         {
             return GL_FALSE;
         }
@@ -408,132 +547,697 @@ GLFWAPI int GLFWAPIENTRY glfwReadMemoryImage( const void *data, long size, GLFWi
             break;
     }
 
+    // Indexed images keep their palette indices
+    if( img->Palette )
+    {
+        img->Format = GL_COLOR_INDEX;
+    }
+
+    // Row padding is done last, as the steps above expect packed rows
+    if( flags & GLFW_ALIGN_ROWS_BIT )
+    {
+        return PadImageRows( img );
+    }
+
+    img->RowStride = img->Width * img->BytesPerPixel;
+
     return GL_TRUE;
 }
 
 
 //========================================================================
-// Free allocated memory for an image
+// Upload the texels of a mipmap level that are covered by an updated
+// level 0 region, from a tightly packed buffer holding the texels from
+// (bx, by) on
 //========================================================================
 
-GLFWAPI void GLFWAPIENTRY glfwFreeImage( GLFWimage *img )
+static void UploadMipmapRegion( GLFWimage *img, int level, int width,
+    int height, int dstX, int dstY, const unsigned char *data, int bx,
+    int by, int bw, int bh )
 {
-    // Is GLFW initialized?
-    if( !_glfwInitialized )
-    {
-        return;
-    }
-
-    // Free memory
-    if( img->Data != NULL )
-    {
-        free( img->Data );
-        img->Data = NULL;
-    }
-
-    // Clear all fields
-    img->Width         = 0;
-    img->Height        = 0;
-    img->Format        = 0;
-    img->BytesPerPixel = 0;
+    int x0, y0, x1, y1;
+
+    x0 = dstX >> level;
+    y0 = dstY >> level;
+    x1 = ((dstX + width - 1) >> level) + 1;
+    y1 = ((dstY + height - 1) >> level) + 1;
+    x1 = x1 > bx + bw ? bx + bw : x1;
+    y1 = y1 > by + bh ? by + bh : y1;
+
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, bw );
+    glPixelStorei( GL_UNPACK_SKIP_PIXELS, x0 - bx );
+    glPixelStorei( GL_UNPACK_SKIP_ROWS, y0 - by );
+    glTexSubImage2D( GL_TEXTURE_2D, level, x0, y0, x1 - x0, y1 - y0,
+        img->Format, GL_UNSIGNED_BYTE, (void*) data );
 }
 
 
 //========================================================================
-// Read an image from a file, and upload it to texture memory
+// Rebuild the mipmap levels covered by an updated level 0 region
 //========================================================================
 
-GLFWAPI int GLFWAPIENTRY glfwLoadTexture2D( const char *name, int flags )
+static void UpdateMipmapRegion( GLFWimage *img, int srcX, int srcY,
+    int width, int height, int dstX, int dstY, int texWidth, int texHeight )
 {
-    GLFWimage img;
+    int     x0, y0, x1, y1, bx0, by0, bx1, by1;
+    int     l, levels, lastLevel, size, bw, bh, stride;
+    int     srcstride, alignment, bpp, n;
+    GLint   PackAlignment, PackRowLength, PackSkipPixels, PackSkipRows;
+    unsigned char *data;
 
-    // Is GLFW initialized?
-    if( !_glfwInitialized || !_glfwWin.opened )
-    {
-        return GL_FALSE;
-    }
+    bpp = img->BytesPerPixel;
+    alignment = _glfwGetRowAlignment( img );
+    srcstride = (img->Width * bpp + alignment - 1) / alignment * alignment;
 
-    // Force rescaling if necessary
-    if( !_glfwWin.has_GL_ARB_texture_non_power_of_two )
+    lastLevel = 0;
+    while( (texWidth >> lastLevel) > 1 || (texHeight >> lastLevel) > 1 )
     {
-        flags &= (~GLFW_NO_RESCALE_BIT);
+        lastLevel ++;
     }
 
-    // Read image from file
-    if( !glfwReadImage( name, &img, flags ) )
+    // Find how many levels can be rebuilt from the image alone. Level l
+    // depends on 2^l x 2^l blocks of level 0, so the region is widened to
+    // that alignment, and the widened region must be available in the
+    // source
+    levels = 0;
+    bx0 = by0 = bx1 = by1 = 0;
+    for( l = 1; l <= lastLevel; l ++ )
     {
-        return GL_FALSE;
-    }
+        size = 1 << l;
+        x0 = dstX & ~(size-1);
+        y0 = dstY & ~(size-1);
+        x1 = (dstX + width + size-1) & ~(size-1);
+        y1 = (dstY + height + size-1) & ~(size-1);
+        x1 = x1 > texWidth ? texWidth : x1;
+        y1 = y1 > texHeight ? texHeight : y1;
+
+        if( x0 + srcX - dstX < 0 || y0 + srcY - dstY < 0 ||
+            x1 + srcX - dstX > img->Width || y1 + srcY - dstY > img->Height )
+        {
+            break;
+        }
 
-    if( !glfwLoadTextureImage2D( &img, flags ) )
-    {
-        return GL_FALSE;
+        levels = l;
+        bx0 = x0;
+        by0 = y0;
+        bx1 = x1;
+        by1 = y1;
     }
 
-    // Data buffer is not needed anymore
-    glfwFreeImage( &img );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
 
-    return GL_TRUE;
-}
+    if( levels > 0 )
+    {
+        // Copy the widened region into a tightly packed work buffer
+        bw = bx1 - bx0;
+        bh = by1 - by0;
+        stride = bw * bpp;
+        data = (unsigned char *) malloc( stride * bh );
+        if( data == NULL )
+        {
+            return;
+        }
 
+        for( n = 0; n < bh; n ++ )
+        {
+            memcpy( data + n * stride,
+                    img->Data + (by0 + srcY - dstY + n) * srcstride +
+                                (bx0 + srcX - dstX) * bpp,
+                    stride );
+        }
 
-//========================================================================
-// Read an image from a buffer, and upload it to texture memory
-//========================================================================
+        // Halve the buffer once per level, but only upload the texels
+        // that are covered by the updated region
+        for( l = 1; l <= levels; l ++ )
+        {
+            if( !_glfwHalveImage( data, &bw, &bh, bpp, &stride, 1 ) )
+            {
+                break;
+            }
 
-GLFWAPI int  GLFWAPIENTRY glfwLoadMemoryTexture2D( const void *data, long size, int flags )
-{
-    GLFWimage img;
+            UploadMipmapRegion( img, l, width, height, dstX, dstY, data,
+                                bx0 >> l, by0 >> l, bw, bh );
+        }
 
-    // Is GLFW initialized?
-    if( !_glfwInitialized || !_glfwWin.opened )
-    {
-        return GL_FALSE;
+        free( data );
     }
 
-    // Force rescaling if necessary
-    if( !_glfwWin.has_GL_ARB_texture_non_power_of_two )
+    if( levels == lastLevel )
     {
-        flags &= (~GLFW_NO_RESCALE_BIT);
+        return;
     }
 
-    // Read image from file
-    if( !glfwReadMemoryImage( data, size, &img, flags ) )
+    // The remaining levels also depend on texels outside the image. The
+    // last level rebuilt above (or level 0) is now up to date, so it is
+    // read back whole and the rest is built from that
+    bw = texWidth >> levels;
+    bh = texHeight >> levels;
+    bw = bw < 1 ? 1 : bw;
+    bh = bh < 1 ? 1 : bh;
+    stride = bw * bpp;
+    data = (unsigned char *) malloc( stride * bh );
+    if( data == NULL )
     {
-        return GL_FALSE;
+        return;
     }
 
-    if( !glfwLoadTextureImage2D( &img, flags ) )
+    glGetIntegerv( GL_PACK_ALIGNMENT, &PackAlignment );
+    glGetIntegerv( GL_PACK_ROW_LENGTH, &PackRowLength );
+    glGetIntegerv( GL_PACK_SKIP_PIXELS, &PackSkipPixels );
+    glGetIntegerv( GL_PACK_SKIP_ROWS, &PackSkipRows );
+    glPixelStorei( GL_PACK_ALIGNMENT, 1 );
+    glPixelStorei( GL_PACK_ROW_LENGTH, 0 );
+    glPixelStorei( GL_PACK_SKIP_PIXELS, 0 );
+    glPixelStorei( GL_PACK_SKIP_ROWS, 0 );
+
+    glGetTexImage( GL_TEXTURE_2D, levels, img->Format, GL_UNSIGNED_BYTE,
+        (void*) data );
+
+    glPixelStorei( GL_PACK_ALIGNMENT, PackAlignment );
+    glPixelStorei( GL_PACK_ROW_LENGTH, PackRowLength );
+    glPixelStorei( GL_PACK_SKIP_PIXELS, PackSkipPixels );
+    glPixelStorei( GL_PACK_SKIP_ROWS, PackSkipRows );
+
+    for( l = levels + 1; l <= lastLevel; l ++ )
     {
-        return GL_FALSE;
-    }
+        if( !_glfwHalveImage( data, &bw, &bh, bpp, &stride, 1 ) )
+        {
+            break;
+        }
 
-    // Data buffer is not needed anymore
-    glfwFreeImage( &img );
+        UploadMipmapRegion( img, l, width, height, dstX, dstY, data,
+                            0, 0, bw, bh );
+    }
 
-    return GL_TRUE;
+    free( data );
 }
 
 
 //========================================================================
-// Upload an image object to texture memory
+// Expand rows of an indexed image to its palette format, into the shared
+// scratch buffer. The view describes the expanded rows.
 //========================================================================
 
-GLFWAPI int  GLFWAPIENTRY glfwLoadTextureImage2D( GLFWimage *img, int flags )
+static int ExpandIndexedImage( const GLFWimage *img, int firstRow,
+    int rows, GLFWimage *view )
 {
-    GLint   UnpackAlignment, GenMipMap;
-    int     level, format, AutoGen, newsize, n;
-    unsigned char *data, *dataptr;
-
-    // Is GLFW initialized?
-    if( !_glfwInitialized || !_glfwWin.opened )
+    unsigned int lut[ 256 ], *dst32;
+    const unsigned char *src, *entry;
+    unsigned char *dst;
+    int bpp, stride, alignment, srcStride, m, n;
+    long size;
+
+    bpp = img->PaletteFormat == GL_RGBA ? 4 : 3;
+    stride = (img->Width * bpp + 3) & ~3;
+
+    alignment = _glfwGetRowAlignment( img );
+    srcStride = (img->Width + alignment - 1) / alignment * alignment;
+
+    // The scratch buffer only ever grows, so that repeated uploads do not
+    // allocate
+    size = (long) stride * rows;
+    if( size > _glfwTex.ScratchSize )
     {
-        return GL_FALSE;
+        dst = (unsigned char *) realloc( _glfwTex.Scratch, size );
+        if( dst == NULL )
+        {
+            return GL_FALSE;
+        }
+        _glfwTex.Scratch = dst;
+        _glfwTex.ScratchSize = size;
     }
 
-    // TODO: Use GL_MAX_TEXTURE_SIZE or GL_PROXY_TEXTURE_2D to determine
-    //       whether the image size is valid.
-    // NOTE: May require box filter downsampling routine.
+    if( bpp == 4 )
+    {
+        // Whole pixels are looked up in a table with the palette's byte
+        // order
+        memcpy( lut, img->Palette, sizeof(lut) );
+        for( n = 0; n < rows; n ++ )
+        {
+            src = img->Data + (long) (firstRow + n) * srcStride;
+            dst32 = (unsigned int *) (_glfwTex.Scratch + (long) n * stride);
+            for( m = 0; m < img->Width; m ++ )
+            {
+                dst32[ m ] = lut[ src[ m ] ];
+            }
+        }
+    }
+    else
+    {
+        for( n = 0; n < rows; n ++ )
+        {
+            src = img->Data + (long) (firstRow + n) * srcStride;
+            dst = _glfwTex.Scratch + (long) n * stride;
+            for( m = 0; m < img->Width; m ++ )
+            {
+                entry = img->Palette + src[ m ] * 3;
+                *dst ++ = entry[ 0 ];
+                *dst ++ = entry[ 1 ];
+                *dst ++ = entry[ 2 ];
+            }
+        }
+    }
+
+    *view = *img;
+    view->Height        = rows;
+    view->Format        = img->PaletteFormat;
+    view->BytesPerPixel = bpp;
+    view->RowStride     = stride;
+    view->Data          = _glfwTex.Scratch;
+    view->Palette       = NULL;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Describe the index plane of an indexed image as a single channel image
+//========================================================================
+
+static void GetIndexView( const GLFWimage *img, GLFWimage *view )
+{
+    *view = *img;
+    view->Format  = GL_LUMINANCE;
+    view->Palette = NULL;
+}
+
+
+//========================================================================
+// Disable filtering on the bound texture (for index and palette textures)
+//========================================================================
+
+static void SetNearestFilter( void )
+{
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+}
+
+
+//========================================================================
+// Read an image from an open stream, which is then closed
+//========================================================================
+
+static int ReadImageStream( _GLFWstream *stream, GLFWimage *img, int flags )
+{
+    // We only support TGA files at the moment
+    if( !_glfwReadTGA( stream, img, flags ) )
+    {
+        _glfwCloseStream( stream );
+        return GL_FALSE;
+    }
+
+    // Close stream
+    _glfwCloseStream( stream );
+
+    // Convert pixels, rescale and set the OpenGL format
+    return PostProcessImage( img, flags );
+}
+
+
+//========================================================================
+// Read a named image from the mounted packs or, failing that, from the
+// file system, in which case *fromFile is set
+//========================================================================
+
+static int ReadNamedImage( const char *name, GLFWimage *img, int flags,
+    int *fromFile )
+{
+    _GLFWstream stream;
+
+    *fromFile = GL_FALSE;
+
+    if( _glfwOpenPackStream( &stream, name ) )
+    {
+        img->Width         = 0;
+        img->Height        = 0;
+        img->BytesPerPixel = 0;
+        img->RowStride     = 0;
+        img->Data          = NULL;
+        img->Palette       = NULL;
+        img->PaletteSize   = 0;
+        img->PaletteFormat = 0;
+
+        return ReadImageStream( &stream, img, flags );
+    }
+
+    *fromFile = GL_TRUE;
+    return _glfwReadImageFile( name, img, flags );
+}
+
+
+//========================================================================
+// Read an image from a mounted pack or the file system, without watching
+// it for changes
+//========================================================================
+
+int _glfwReadImage( const char *name, GLFWimage *img, int flags )
+{
+    int fromFile;
+
+    return ReadNamedImage( name, img, flags, &fromFile );
+}
+
+
+//========================================================================
+// Read an image file from the file system, ignoring mounted packs
+//========================================================================
+
+int _glfwReadImageFile( const char *name, GLFWimage *img, int flags )
+{
+    _GLFWstream stream;
+
+    // Start with an empty image descriptor
+    img->Width         = 0;
+    img->Height        = 0;
+    img->BytesPerPixel = 0;
+    img->RowStride     = 0;
+    img->Data          = NULL;
+    img->Palette       = NULL;
+    img->PaletteSize   = 0;
+    img->PaletteFormat = 0;
+
+    // Open file
+    if( !_glfwOpenFileStream( &stream, name, "rb" ) )
+    {
+        return GL_FALSE;
+    }
+
+    return ReadImageStream( &stream, img, flags );
+}
+
+
+
+//************************************************************************
+//****                    GLFW user functions                         ****
+//************************************************************************
+
+//========================================================================
+// Read an image from a named file
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwReadImage( const char *name, GLFWimage *img,
+    int flags )
+{
+    int fromFile;
+
+    if( !ReadNamedImage( name, img, flags, &fromFile ) )
+    {
+        return GL_FALSE;
+    }
+
+    // Images from the file system can be hot reloaded
+    if( fromFile )
+    {
+        _glfwWatchImage( name, flags, 0 );
+    }
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Read an image file from a memory buffer
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwReadMemoryImage( const void *data, long size, GLFWimage *img, int flags )
+{
+    _GLFWstream stream;
+
+    // Start with an empty image descriptor
+    img->Width         = 0;
+    img->Height        = 0;
+    img->BytesPerPixel = 0;
+    img->RowStride     = 0;
+    img->Data          = NULL;
+    img->Palette       = NULL;
+    img->PaletteSize   = 0;
+    img->PaletteFormat = 0;
+
+    // Open buffer
+    if( !_glfwOpenBufferStream( &stream, (void*) data, size ) )
+    {
+        return GL_FALSE;
+    }
+
+    return ReadImageStream( &stream, img, flags );
+}
+
+
+//========================================================================
+// Free allocated memory for an image
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwFreeImage( GLFWimage *img )
+{
+    // Free memory
+    if( img->Data != NULL )
+    {
+        free( img->Data );
+        img->Data = NULL;
+    }
+    if( img->Palette != NULL )
+    {
+        free( img->Palette );
+        img->Palette = NULL;
+    }
+
+    // Clear all fields
+    img->Width         = 0;
+    img->Height        = 0;
+    img->Format        = 0;
+    img->BytesPerPixel = 0;
+    img->RowStride     = 0;
+    img->PaletteSize   = 0;
+    img->PaletteFormat = 0;
+}
+
+
+//========================================================================
+// Resize an image with the given filter. The destination may be the same
+// image as the source.
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwResizeImage( const GLFWimage *src,
+    GLFWimage *dst, int width, int height, int filter )
+{
+    unsigned char *data;
+    int alignment, stride;
+
+    // Filtering palette indices would not make sense
+    if( src->Data == NULL || src->Format == GL_COLOR_INDEX ||
+        width <= 0 || height <= 0 )
+    {
+        return GL_FALSE;
+    }
+
+    data = (unsigned char *) malloc( width * height * src->BytesPerPixel );
+    if( data == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    // Hand-built images may not have a valid stride
+    alignment = _glfwGetRowAlignment( src );
+    stride = (src->Width * src->BytesPerPixel + alignment - 1) / alignment *
+             alignment;
+
+    if( !_glfwResampleImage( src->Data, src->Width, src->Height,
+                             stride, data, width, height,
+                             width * src->BytesPerPixel, src->BytesPerPixel,
+                             filter ) )
+    {
+        free( data );
+        return GL_FALSE;
+    }
+
+    if( dst == src )
+    {
+        free( dst->Data );
+    }
+    else
+    {
+        dst->Format        = src->Format;
+        dst->BytesPerPixel = src->BytesPerPixel;
+        dst->Palette       = NULL;
+        dst->PaletteSize   = 0;
+        dst->PaletteFormat = 0;
+    }
+
+    dst->Data      = data;
+    dst->Width     = width;
+    dst->Height    = height;
+    dst->RowStride = width * dst->BytesPerPixel;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Write an image to a file (in TGA format)
+//========================================================================
+
+GLFWAPI int  GLFWAPIENTRY glfwWriteImage( const char *name, GLFWimage *img, int flags )
+{
+    FILE *f;
+    int  ok;
+
+    f = fopen( name, "wb" );
+    if( f == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    ok = _glfwWriteTGA( f, img, flags );
+    if( fclose( f ) != 0 )
+    {
+        ok = 0;
+    }
+
+    // Do not leave truncated files behind
+    if( !ok )
+    {
+        remove( name );
+        return GL_FALSE;
+    }
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Read an image from a file, and upload it to texture memory
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwLoadTexture2D( const char *name, int flags )
+{
+    GLFWimage img;
+    GLint     texture;
+    int       fromFile;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwWin.opened )
+    {
+        return GL_FALSE;
+    }
+
+    // Force rescaling if necessary
+    if( !_glfwWin.has_GL_ARB_texture_non_power_of_two )
+    {
+        flags &= (~GLFW_NO_RESCALE_BIT);
+    }
+
+    // Read image from file
+    if( !ReadNamedImage( name, &img, flags, &fromFile ) )
+    {
+        return GL_FALSE;
+    }
+
+    if( !glfwLoadTextureImage2D( &img, flags ) )
+    {
+        return GL_FALSE;
+    }
+
+    // Data buffer is not needed anymore
+    glfwFreeImage( &img );
+
+    // Textures loaded from the file system can be hot reloaded
+    if( fromFile )
+    {
+        glGetIntegerv( GL_TEXTURE_BINDING_2D, &texture );
+        _glfwWatchImage( name, flags, (GLuint) texture );
+    }
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Read an image from a buffer, and upload it to texture memory
+//========================================================================
+
+GLFWAPI int  GLFWAPIENTRY glfwLoadMemoryTexture2D( const void *data, long size, int flags )
+{
+    GLFWimage img;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwWin.opened )
+    {
+        return GL_FALSE;
+    }
+
+    // Force rescaling if necessary
+    if( !_glfwWin.has_GL_ARB_texture_non_power_of_two )
+    {
+        flags &= (~GLFW_NO_RESCALE_BIT);
+    }
+
+    // Read image from file
+    if( !glfwReadMemoryImage( data, size, &img, flags ) )
+    {
+        return GL_FALSE;
+    }
+
+    if( !glfwLoadTextureImage2D( &img, flags ) )
+    {
+        return GL_FALSE;
+    }
+
+    // Data buffer is not needed anymore
+    glfwFreeImage( &img );
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Upload an image object to texture memory
+//========================================================================
+
+GLFWAPI int  GLFWAPIENTRY glfwLoadTextureImage2D( GLFWimage *img, int flags )
+{
+    GLint   UnpackAlignment, GenMipMap;
+    int     level, format, AutoGen, newsize, m, n, alignment, stride;
+    unsigned char *data, *dataptr;
+    GLFWimage view;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwWin.opened )
+    {
+        return GL_FALSE;
+    }
+
+    // Indexed images are either uploaded as their indices, for palette
+    // lookups in a shader, or expanded to the palette format
+    if( img->Format == GL_COLOR_INDEX )
+    {
+        if( flags & GLFW_INDEX_TEXTURE_BIT )
+        {
+            // Averaged indices would be meaningless
+            GetIndexView( img, &view );
+            if( !glfwLoadTextureImage2D( &view,
+                                         flags & ~GLFW_BUILD_MIPMAPS_BIT ) )
+            {
+                return GL_FALSE;
+            }
+            SetNearestFilter();
+            return GL_TRUE;
+        }
+
+        if( !ExpandIndexedImage( img, 0, img->Height, &view ) )
+        {
+            return GL_FALSE;
+        }
+        return glfwLoadTextureImage2D( &view, flags );
+    }
+
+    // TODO: Use GL_MAX_TEXTURE_SIZE or GL_PROXY_TEXTURE_2D to determine
+    //       whether the image size is valid.
+    // NOTE: May require box filter downsampling routine.
+
+    // Get the row layout of the image data
+    alignment = _glfwGetRowAlignment( img );
+    stride = (img->Width * img->BytesPerPixel + alignment - 1) /
+             alignment * alignment;
 
     // Do we need to convert the alpha map to RGBA format (OpenGL 1.0)?
     if( (_glfwWin.glMajor == 1) && (_glfwWin.glMinor == 0) &&
@@ -553,24 +1257,30 @@ GLFWAPI int  GLFWAPIENTRY glfwLoadTextureImage2D( GLFWimage *img, int flags )
 
         // Convert Alpha map to RGBA
         dataptr = data;
-        for( n = 0; n < (img->Width*img->Height); ++ n )
+        for( m = 0; m < img->Height; ++ m )
         {
-            *dataptr ++ = 255;
-            *dataptr ++ = 255;
-            *dataptr ++ = 255;
-            *dataptr ++ = img->Data[n];
+            for( n = 0; n < img->Width; ++ n )
+            {
+                *dataptr ++ = 255;
+                *dataptr ++ = 255;
+                *dataptr ++ = 255;
+                *dataptr ++ = img->Data[ m * stride + n ];
+            }
         }
 
         // Free memory for old image data (not needed anymore)
         free( img->Data );
 
-        // Set pointer to new image data
+        // Set pointer to new image data (RGBA rows are always aligned)
         img->Data = data;
+        img->RowStride = img->Width * 4;
+        alignment = 4;
+        stride = img->RowStride;
     }
 
-    // Set unpack alignment to one byte
+    // Set unpack alignment to match the image rows
     glGetIntegerv( GL_UNPACK_ALIGNMENT, &UnpackAlignment );
-    glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, alignment );
 
     // Should we use automatic mipmap generation?
     AutoGen = ( flags & GLFW_BUILD_MIPMAPS_BIT ) &&
@@ -607,13 +1317,17 @@ GLFWAPI int  GLFWAPIENTRY glfwLoadTextureImage2D( GLFWimage *img, int flags )
         // Build next mipmap level manually, if required
         if( ( flags & GLFW_BUILD_MIPMAPS_BIT ) && !AutoGen )
         {
-            level = HalveImage( img->Data, &img->Width,
-                        &img->Height, img->BytesPerPixel ) ?
+            level = _glfwHalveImage( img->Data, &img->Width,
+                        &img->Height, img->BytesPerPixel,
+                        &stride, alignment ) ?
                     level + 1 : 0;
         }
     }
     while( level != 0 );
 
+    // The image now holds the last uploaded level
+    img->RowStride = stride;
+
     // Restore old automatic mipmap generation state
     if( AutoGen )
     {
@@ -624,6 +1338,190 @@ GLFWAPI int  GLFWAPIENTRY glfwLoadTextureImage2D( GLFWimage *img, int flags )
     // Restore old unpack alignment
     glPixelStorei( GL_UNPACK_ALIGNMENT, UnpackAlignment );
 
+    // Record texture memory use
+    _glfwTrackTexture( GL_TEXTURE_2D, format, img->BytesPerPixel );
+
     return GL_TRUE;
 }
 
+
+//========================================================================
+// Upload the palette of an indexed image as a 256x1 texture
+//========================================================================
+
+GLFWAPI int  GLFWAPIENTRY glfwLoadPaletteTexture2D( const GLFWimage *img )
+{
+    GLint   UnpackAlignment;
+    int     format;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwWin.opened )
+    {
+        return GL_FALSE;
+    }
+
+    if( img->Format != GL_COLOR_INDEX || img->Palette == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    // Format specification is different for OpenGL 1.0
+    if( _glfwWin.glMajor == 1 && _glfwWin.glMinor == 0 )
+    {
+        format = img->PaletteFormat == GL_RGBA ? 4 : 3;
+    }
+    else
+    {
+        format = img->PaletteFormat;
+    }
+
+    glGetIntegerv( GL_UNPACK_ALIGNMENT, &UnpackAlignment );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+
+    glTexImage2D( GL_TEXTURE_2D, 0, format, 256, 1, 0, img->PaletteFormat,
+        GL_UNSIGNED_BYTE, (void*) img->Palette );
+
+    glPixelStorei( GL_UNPACK_ALIGNMENT, UnpackAlignment );
+
+    // Entries must be looked up, not blended
+    SetNearestFilter();
+
+    // Record texture memory use
+    _glfwTrackTexture( GL_TEXTURE_2D, img->PaletteFormat,
+                       img->PaletteFormat == GL_RGBA ? 4 : 3 );
+
+    return GL_TRUE;
+}
+
+
+
+//========================================================================
+// Upload a region of an image object to part of the current texture
+//========================================================================
+
+GLFWAPI int  GLFWAPIENTRY glfwUpdateTextureRegion( GLFWimage *img,
+    int srcX, int srcY, int width, int height, int dstX, int dstY,
+    int flags )
+{
+    GLint   UnpackAlignment, UnpackRowLength, UnpackSkipPixels;
+    GLint   UnpackSkipRows, GenMipMap, texWidth, texHeight;
+    int     AutoGen, firstRow, lastRow;
+    GLFWimage view;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwWin.opened )
+    {
+        return GL_FALSE;
+    }
+
+    // Indexed images are uploaded as for glfwLoadTextureImage2D, expanding
+    // only the rows of the region
+    if( img->Format == GL_COLOR_INDEX )
+    {
+        if( flags & GLFW_INDEX_TEXTURE_BIT )
+        {
+            GetIndexView( img, &view );
+            return glfwUpdateTextureRegion( &view, srcX, srcY, width, height,
+                       dstX, dstY, flags & ~GLFW_BUILD_MIPMAPS_BIT );
+        }
+
+        if( srcY < 0 || height <= 0 || srcY + height > img->Height )
+        {
+            return GL_FALSE;
+        }
+
+        firstRow = srcY;
+        lastRow = srcY + height;
+
+        // Software mipmap rebuilding reads whole blocks of level 0 around
+        // the region, up to the entire texture for the smallest level, so
+        // all rows of the image that land in the texture are expanded
+        if( ( flags & GLFW_BUILD_MIPMAPS_BIT ) &&
+            !_glfwWin.has_GL_SGIS_generate_mipmap )
+        {
+            glGetTexLevelParameteriv( GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT,
+                &texHeight );
+
+            firstRow = srcY - dstY > 0 ? srcY - dstY : 0;
+            lastRow = srcY - dstY + texHeight;
+            lastRow = lastRow < img->Height ? lastRow : img->Height;
+            lastRow = lastRow > srcY + height ? lastRow : srcY + height;
+        }
+
+        if( !ExpandIndexedImage( img, firstRow, lastRow - firstRow, &view ) )
+        {
+            return GL_FALSE;
+        }
+        return glfwUpdateTextureRegion( &view, srcX, srcY - firstRow,
+                                        width, height, dstX, dstY, flags );
+    }
+
+    // Sub-image uploads were introduced in OpenGL 1.1
+    if( _glfwWin.glMajor == 1 && _glfwWin.glMinor == 0 )
+    {
+        return GL_FALSE;
+    }
+
+    // The region must lie within both the image and the texture
+    glGetTexLevelParameteriv( GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH,
+        &texWidth );
+    glGetTexLevelParameteriv( GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT,
+        &texHeight );
+    if( width <= 0 || height <= 0 || srcX < 0 || srcY < 0 ||
+        dstX < 0 || dstY < 0 ||
+        srcX + width > img->Width || srcY + height > img->Height ||
+        dstX + width > texWidth || dstY + height > texHeight )
+    {
+        return GL_FALSE;
+    }
+
+    // Save the unpack state, as we use most of it
+    glGetIntegerv( GL_UNPACK_ALIGNMENT, &UnpackAlignment );
+    glGetIntegerv( GL_UNPACK_ROW_LENGTH, &UnpackRowLength );
+    glGetIntegerv( GL_UNPACK_SKIP_PIXELS, &UnpackSkipPixels );
+    glGetIntegerv( GL_UNPACK_SKIP_ROWS, &UnpackSkipRows );
+
+    // Let OpenGL pick the region out of the image rows
+    glPixelStorei( GL_UNPACK_ALIGNMENT, _glfwGetRowAlignment( img ) );
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, img->Width );
+    glPixelStorei( GL_UNPACK_SKIP_PIXELS, srcX );
+    glPixelStorei( GL_UNPACK_SKIP_ROWS, srcY );
+
+    // Should we use automatic mipmap generation?
+    AutoGen = ( flags & GLFW_BUILD_MIPMAPS_BIT ) &&
+              _glfwWin.has_GL_SGIS_generate_mipmap;
+
+    // Enable automatic mipmap generation
+    if( AutoGen )
+    {
+        glGetTexParameteriv( GL_TEXTURE_2D, GL_GENERATE_MIPMAP_SGIS,
+            &GenMipMap );
+        glTexParameteri( GL_TEXTURE_2D, GL_GENERATE_MIPMAP_SGIS,
+            GL_TRUE );
+    }
+
+    // Upload the region to level 0
+    glTexSubImage2D( GL_TEXTURE_2D, 0, dstX, dstY, width, height,
+        img->Format, GL_UNSIGNED_BYTE, (void*) img->Data );
+
+    if( AutoGen )
+    {
+        // Restore old automatic mipmap generation state
+        glTexParameteri( GL_TEXTURE_2D, GL_GENERATE_MIPMAP_SGIS,
+            GenMipMap );
+    }
+    else if( flags & GLFW_BUILD_MIPMAPS_BIT )
+    {
+        // Rebuild the affected parts of the lower levels manually
+        UpdateMipmapRegion( img, srcX, srcY, width, height, dstX, dstY,
+                            texWidth, texHeight );
+    }
+
+    // Restore old unpack state
+    glPixelStorei( GL_UNPACK_ALIGNMENT, UnpackAlignment );
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, UnpackRowLength );
+    glPixelStorei( GL_UNPACK_SKIP_PIXELS, UnpackSkipPixels );
+    glPixelStorei( GL_UNPACK_SKIP_ROWS, UnpackSkipRows );
+
+    return GL_TRUE;
+}
@@ -56,6 +56,8 @@ GLFWAPI int GLFWAPIENTRY glfwInit( void )
 
     // Default enable/disable settings
     _glfwWin.sysKeysDisabled = GL_FALSE;
+    _glfwFutexSync = GL_FALSE;
+    _glfwTimerOffset = 0.0;
 
     // Clear window hints
     _glfwClearWindowHints();
@@ -86,12 +88,18 @@ GLFWAPI void GLFWAPIENTRY glfwTerminate( void )
         return;
     }
 
+    // Stop the hot reloading thread before the threads are killed
+    _glfwTerminateHotReload();
+
     // Platform specific termination
     if( !_glfwPlatformTerminate() )
     {
         return;
     }
 
+    // Release pack file mappings
+    _glfwUnmountPacks();
+
     // GLFW is no longer initialized
     _glfwInitialized = GL_FALSE;
 }
@@ -51,10 +51,28 @@
 #define GLFW_STICK 2
 
 
+//========================================================================
+// Thread table definitions
+//========================================================================
+
+// Thread records live in a table of fixed size chunks, and a thread ID
+// combines the slot of its record with the number of times that slot has
+// been reused, so that IDs of dead threads never match a new thread
+#define _GLFW_THREAD_CHUNK_SIZE 64
+#define _GLFW_THREAD_CHUNKS     64
+#define _GLFW_THREAD_SLOT_BITS  12
+#define _GLFW_THREAD_SLOT_MASK  ((1 << _GLFW_THREAD_SLOT_BITS) - 1)
+#define _GLFW_THREAD_GENERATION_MASK ((1 << (31 - _GLFW_THREAD_SLOT_BITS)) - 1)
+
+#define _GLFW_THREAD_ID( slot, generation ) \
+        (((generation) << _GLFW_THREAD_SLOT_BITS) | (slot))
+
+
 //========================================================================
 // System independent include files
 //========================================================================
 
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -146,6 +164,15 @@ int _glfwInitialized = 0;
 GLFWGLOBAL int _glfwInitialized;
 #endif
 
+// Flag indicating if new mutexes, and thereby the condition variables
+// waited on with them, should use the futex backend, where the platform
+// has one (GLFW_FUTEX_SYNC)
+GLFWGLOBAL int _glfwFutexSync;
+
+// Total amount that glfwSetTime has moved the timer back, so that the sum
+// of the two is a clock that is only reset by glfwInit
+GLFWGLOBAL double _glfwTimerOffset;
+
 
 //------------------------------------------------------------------------
 // Abstract data stream (for image I/O)
@@ -158,6 +185,359 @@ typedef struct {
 } _GLFWstream;
 
 
+//------------------------------------------------------------------------
+// 3D texture entry points (OpenGL 1.2, used for texture arrays)
+//------------------------------------------------------------------------
+typedef void (APIENTRY * _GLFWteximage3dfun) (GLenum, GLint, GLint, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid *);
+typedef void (APIENTRY * _GLFWtexsubimage3dfun) (GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const GLvoid *);
+
+
+//------------------------------------------------------------------------
+// Texture stream record (one for each texture being streamed)
+//------------------------------------------------------------------------
+#define _GLFW_MAX_TEXTURE_LEVELS 32
+
+typedef struct _GLFWtexstream_struct _GLFWtexstream;
+
+struct _GLFWtexstream_struct {
+    _GLFWtexstream *Next;
+
+    // Target texture object and format of the image data
+    GLuint          Texture;
+    int             Format;
+    int             BytesPerPixel;
+
+    // Mipmap chain, with all levels in a single allocation
+    int             Levels;
+    int             Width[ _GLFW_MAX_TEXTURE_LEVELS ];
+    int             Height[ _GLFW_MAX_TEXTURE_LEVELS ];
+    unsigned char  *Data[ _GLFW_MAX_TEXTURE_LEVELS ];
+
+    // Upload position (levels are uploaded from the coarsest one up)
+    int             Level;
+    int             Row;
+    long            TotalBytes;
+    long            UploadedBytes;
+};
+
+
+//------------------------------------------------------------------------
+// Texture memory record (one for each texture being accounted for)
+//------------------------------------------------------------------------
+typedef struct _GLFWtexrecord_struct _GLFWtexrecord;
+
+struct _GLFWtexrecord_struct {
+    // Neighbours in the LRU list
+    _GLFWtexrecord *Prev;
+    _GLFWtexrecord *Next;
+
+    // Next record in the same hash bucket
+    _GLFWtexrecord *NextInBucket;
+
+    // Texture object and its memory use (all mipmap levels)
+    GLuint          Texture;
+    int             Format;
+    int             Compressed;
+    int             Levels;
+    long            Bytes;
+};
+
+
+//------------------------------------------------------------------------
+// Texture management state
+//------------------------------------------------------------------------
+GLFWGLOBAL struct {
+
+    // Streams in upload order
+    _GLFWtexstream *FirstStream;
+
+    // Texture memory accounting
+    int             Accounting;
+    int             Evicting;
+    _GLFWtexrecord *MostRecent;
+    _GLFWtexrecord *LeastRecent;
+    _GLFWtexrecord **Buckets;
+    int             BucketCount;
+    int             TextureCount;
+    long            UsedBytes;
+    long            BudgetBytes;
+    long            EvictionCount;
+    GLFWtextureevictfun EvictCallback;
+
+    // Scratch buffer for expanding indexed images
+    unsigned char  *Scratch;
+    long            ScratchSize;
+
+    // Texture array entry points (looked up on first use)
+    int             ArrayInitialized;
+    int             HasTextureArray;
+    _GLFWteximage3dfun    TexImage3D;
+    _GLFWtexsubimage3dfun TexSubImage3D;
+
+} _glfwTex;
+
+
+//------------------------------------------------------------------------
+// Buffer object entry points (GL_ARB_pixel_buffer_object)
+//------------------------------------------------------------------------
+#ifndef GL_ARB_vertex_buffer_object
+
+typedef void (APIENTRY * PFNGLGENBUFFERSARBPROC) (GLsizei, GLuint *);
+typedef void (APIENTRY * PFNGLDELETEBUFFERSARBPROC) (GLsizei, const GLuint *);
+typedef void (APIENTRY * PFNGLBINDBUFFERARBPROC) (GLenum, GLuint);
+typedef void (APIENTRY * PFNGLBUFFERDATAARBPROC) (GLenum, ptrdiff_t, const GLvoid *, GLenum);
+typedef GLvoid * (APIENTRY * PFNGLMAPBUFFERARBPROC) (GLenum, GLenum);
+typedef GLboolean (APIENTRY * PFNGLUNMAPBUFFERARBPROC) (GLenum);
+
+#endif /*GL_ARB_vertex_buffer_object*/
+
+
+//------------------------------------------------------------------------
+// Frame capture slot (one for each pixel buffer in the read-back ring)
+//------------------------------------------------------------------------
+#define _GLFW_CAPTURE_SLOTS 3
+
+typedef struct {
+    GLuint          Buffer;
+    long            Size;
+
+    // Read-back in flight
+    int             Pending;
+    int             Frame;
+    int             Width;
+    int             Height;
+    double          Time;
+    char           *Name;
+    GLFWcapturefun  Callback;
+    int             Record;
+} _GLFWcaptureslot;
+
+
+//------------------------------------------------------------------------
+// Frame capture encoder job
+//------------------------------------------------------------------------
+typedef struct _GLFWcapturejob_struct _GLFWcapturejob;
+
+struct _GLFWcapturejob_struct {
+    _GLFWcapturejob *Next;
+    char            *Name;
+    GLFWimage        Image;
+};
+
+
+//------------------------------------------------------------------------
+// Frame capture state
+//------------------------------------------------------------------------
+GLFWGLOBAL struct {
+
+    // Read-back ring (pixel buffers are created on first use)
+    int             Initialized;
+    int             HasPBO;
+    int             NextSlot;
+    int             Frame;
+    _GLFWcaptureslot Slots[ _GLFW_CAPTURE_SLOTS ];
+
+    // Encoder thread and its job queue
+    int             Threaded;
+    GLFWthread      Thread;
+    GLFWmutex       Mutex;
+    GLFWcond        Cond;
+    int             Quit;
+    int             ActiveJobs;
+    _GLFWcapturejob *FirstJob;
+    _GLFWcapturejob *LastJob;
+
+    // Buffer object entry points
+    PFNGLGENBUFFERSARBPROC    GenBuffers;
+    PFNGLDELETEBUFFERSARBPROC DeleteBuffers;
+    PFNGLBINDBUFFERARBPROC    BindBuffer;
+    PFNGLBUFFERDATAARBPROC    BufferData;
+    PFNGLMAPBUFFERARBPROC     MapBuffer;
+    PFNGLUNMAPBUFFERARBPROC   UnmapBuffer;
+
+} _glfwCapture;
+
+
+//------------------------------------------------------------------------
+// Frame recorder queue entry
+//------------------------------------------------------------------------
+#define _GLFW_RECORD_QUEUE_SIZE 8
+
+typedef struct {
+    unsigned char  *Data;
+    long            Capacity;
+    int             Number;
+    int             Width;
+    int             Height;
+    double          Time;
+} _GLFWrecframe;
+
+
+//------------------------------------------------------------------------
+// Frame index entry (written at the end of a recording)
+//------------------------------------------------------------------------
+typedef struct {
+    int             Number;
+    double          Time;
+    double          Offset;
+} _GLFWrecindex;
+
+
+//------------------------------------------------------------------------
+// Frame recorder state
+//------------------------------------------------------------------------
+GLFWGLOBAL struct {
+
+    int             Active;
+    int             Flags;
+    int             Format;
+    double          StartTime;
+
+    // Bounded frame queue (filled by the main thread, drained by the
+    // writer thread)
+    _GLFWrecframe   Queue[ _GLFW_RECORD_QUEUE_SIZE ];
+    int             Head;
+    int             Count;
+    GLFWthread      Thread;
+    GLFWmutex       Mutex;
+    GLFWcond        Cond;
+    int             Quit;
+
+    // Writer thread state
+    FILE           *File;
+    double          Offset;
+    unsigned char  *Previous;
+    long            PreviousSize;
+    unsigned char  *Packets;
+    long            PacketsSize;
+    _GLFWrecindex  *Index;
+    int             IndexSize;
+    int             IndexCapacity;
+    int             Error;
+
+    // Counters
+    int             Recorded;
+    int             Written;
+    int             Dropped;
+
+} _glfwRecorder;
+
+
+//------------------------------------------------------------------------
+// Shared memory block or mapped file (platform specific handle)
+//------------------------------------------------------------------------
+typedef struct {
+    void           *Data;
+    long            Size;
+    char           *Name;
+    void           *Handle;
+} _GLFWsharedmem;
+
+
+//------------------------------------------------------------------------
+// Shared memory frame export state
+//------------------------------------------------------------------------
+GLFWGLOBAL struct {
+
+    int             Active;
+    double          StartTime;
+    _GLFWsharedmem  Memory;
+    int             SlotCount;
+    long            SlotSize;
+    int             NextSlot;
+    unsigned int    Frame;
+
+    // Counters
+    int             Exported;
+    int             Skipped;
+
+} _glfwExport;
+
+
+//------------------------------------------------------------------------
+// Mounted pack file
+//------------------------------------------------------------------------
+typedef struct _GLFWpack {
+    struct _GLFWpack *Next;
+    char           *Path;
+    _GLFWsharedmem  Memory;
+    int             Count;
+    const unsigned char *Index;
+    const char     *Names;
+    long            NamesSize;
+} _GLFWpack;
+
+
+//------------------------------------------------------------------------
+// Pack file state
+//------------------------------------------------------------------------
+GLFWGLOBAL struct {
+
+    // Mounted packs, most recently mounted first
+    _GLFWpack      *First;
+
+} _glfwPacks;
+
+
+//------------------------------------------------------------------------
+// Watched image file (hot reloading)
+//------------------------------------------------------------------------
+typedef struct _GLFWwatch {
+    struct _GLFWwatch *Next;
+    int             ID;
+    char           *Path;
+    const char     *File;           // File name part of Path
+    int             Directory;      // Platform directory watch, or -1
+    int             Flags;
+    GLuint          Texture;        // Zero for glfwReadImage
+
+    // Last known state, for watches that are polled
+    long            ModTime;
+    long            Size;
+
+    // Changes wait for a quiet period before the file is decoded
+    int             Dirty;
+    double          ChangeTime;
+} _GLFWwatch;
+
+
+//------------------------------------------------------------------------
+// Reloaded image waiting to be polled
+//------------------------------------------------------------------------
+typedef struct _GLFWreload {
+    struct _GLFWreload *Next;
+    char           *Path;
+    int             Flags;
+    GLuint          Texture;
+    GLFWimage       Image;
+} _GLFWreload;
+
+
+//------------------------------------------------------------------------
+// Hot reloading state
+//------------------------------------------------------------------------
+GLFWGLOBAL struct {
+
+    int             Active;
+    int             Watcher;        // Platform watcher, or -1 to poll
+    GLFWthread      Thread;
+    GLFWmutex       Mutex;
+    int             Quit;
+
+    _GLFWwatch     *FirstWatch;
+    int             NextID;
+    double          PollTime;
+
+    // Decoded images, oldest first
+    _GLFWreload    *FirstResult;
+    _GLFWreload    *LastResult;
+
+    // Path of the last polled image
+    char           *PolledPath;
+
+} _glfwReload;
+
+
 //========================================================================
 // Prototypes for platform specific implementation functions
 //========================================================================
@@ -188,6 +568,10 @@ GLFWthread _glfwPlatformCreateThread( GLFWthreadfun fun, void *arg );
 void _glfwPlatformDestroyThread( GLFWthread ID );
 int _glfwPlatformWaitThread( GLFWthread ID, int waitmode );
 GLFWthread _glfwPlatformGetThreadID( void );
+int _glfwPlatformSetThreadAffinity( GLFWthread ID, unsigned int mask );
+int _glfwPlatformSetThreadPriority( GLFWthread ID, int priority );
+int _glfwPlatformSetThreadName( GLFWthread ID, const char *name );
+int _glfwPlatformGetThreadStats( GLFWthread ID, GLFWthreadstats *stats );
 GLFWmutex _glfwPlatformCreateMutex( void );
 void _glfwPlatformDestroyMutex( GLFWmutex mutex );
 void _glfwPlatformLockMutex( GLFWmutex mutex );
@@ -195,9 +579,29 @@ void _glfwPlatformUnlockMutex( GLFWmutex mutex );
 GLFWcond _glfwPlatformCreateCond( void );
 void _glfwPlatformDestroyCond( GLFWcond cond );
 void _glfwPlatformWaitCond( GLFWcond cond, GLFWmutex mutex, double timeout );
+void _glfwPlatformWaitCondUntil( GLFWcond cond, GLFWmutex mutex, double time );
 void _glfwPlatformSignalCond( GLFWcond cond );
 void _glfwPlatformBroadcastCond( GLFWcond cond );
 int _glfwPlatformGetNumberOfProcessors( void );
+int _glfwPlatformGetCPUTopology( GLFWcputopology *topology );
+int _glfwPlatformAtomicAdd( volatile int *value, int delta );
+int _glfwPlatformAtomicCompareAndSwap( volatile int *value, int expected, int desired );
+int _glfwPlatformWaitAddress( volatile int *address, int value, double timeout );
+int _glfwPlatformWakeAddress( volatile int *address, int count );
+
+// Shared memory
+int  _glfwPlatformOpenSharedMemory( _GLFWsharedmem *mem, const char *name, long size );
+void _glfwPlatformCloseSharedMemory( _GLFWsharedmem *mem );
+int  _glfwPlatformMapFile( _GLFWsharedmem *mem, const char *name );
+void _glfwPlatformUnmapFile( _GLFWsharedmem *mem );
+void _glfwPlatformMemoryBarrier( void );
+
+// File system watcher
+typedef void (* _GLFWwatchfun)( int directory, const char *name );
+int  _glfwPlatformCreateWatcher( void );
+void _glfwPlatformDestroyWatcher( int watcher );
+int  _glfwPlatformWatchDirectory( int watcher, const char *path );
+int  _glfwPlatformWaitWatcher( int watcher, double timeout, _GLFWwatchfun fun );
 
 // Time
 double _glfwPlatformGetTime( void );
@@ -236,10 +640,19 @@ void _glfwInputKey( int key, int action );
 void _glfwInputChar( int character, int action );
 void _glfwInputMouseClick( int button, int action );
 
+// Time (time.c)
+double _glfwGetSteadyTime( void );
+
 // Threads (thread.c)
+_GLFWthread * _glfwInitThreadTable( void );
+void _glfwTerminateThreadTable( void );
+_GLFWthread * _glfwGetThreadSlot( int slot );
 _GLFWthread * _glfwGetThreadPointer( int ID );
-void _glfwAppendThread( _GLFWthread * t );
-void _glfwRemoveThread( _GLFWthread * t );
+_GLFWthread * _glfwAllocThread( GLFWthreadfun fun, void *arg );
+GLFWthread _glfwPublishThread( _GLFWthread * t );
+void _glfwFinishThread( _GLFWthread * t );
+void _glfwFreeThread( _GLFWthread * t );
+int _glfwGetUsableProcessors( void );
 
 // OpenGL extensions (glext.c)
 void _glfwParseGLVersion( int *major, int *minor, int *rev );
@@ -254,8 +667,49 @@ long _glfwTellStream( _GLFWstream *stream );
 int _glfwSeekStream( _GLFWstream *stream, long offset, int whence );
 void _glfwCloseStream( _GLFWstream *stream );
 
+// Pack files (pack.c)
+int  _glfwOpenPackStream( _GLFWstream *stream, const char *name );
+void _glfwUnmountPacks( void );
+
 // Targa image I/O (tga.c)
 int _glfwReadTGA( _GLFWstream *s, GLFWimage *img, int flags );
+int _glfwWriteTGA( FILE *f, const GLFWimage *img, int flags );
+int _glfwEncodeRLE( unsigned char *dst, const unsigned char *src, int n, int bpp );
+
+// Image processing (image.c)
+int _glfwReadImage( const char *name, GLFWimage *img, int flags );
+int _glfwReadImageFile( const char *name, GLFWimage *img, int flags );
+int _glfwHalveImage( GLubyte *src, int *width, int *height, int components, int *stride, int alignment );
+int _glfwGetRowAlignment( const GLFWimage *img );
+
+// Image resampling (resample.c)
+int _glfwResampleImage( const unsigned char *src, int srcWidth, int srcHeight, int srcStride, unsigned char *dst, int dstWidth, int dstHeight, int dstStride, int bpp, int filter );
+
+// Frame capture (capture.c)
+int  _glfwCaptureFormat( void );
+void _glfwFinishCaptures( void );
+void _glfwRecordFrame( void );
+void _glfwServiceCaptures( void );
+void _glfwTerminateCapture( void );
+
+// Frame recording (record.c)
+void _glfwQueueRecordedFrame( const GLFWimage *img, double time );
+
+// Frame export (export.c)
+void _glfwExportFrame( const GLFWimage *img, double time );
+
+// Hot reloading (reload.c)
+void _glfwWatchImage( const char *name, int flags, GLuint texture );
+void _glfwUnwatchTexture( GLuint texture );
+void _glfwUnwatchTextures( void );
+void _glfwStartHotReload( void );
+void _glfwStopHotReload( void );
+void _glfwTerminateHotReload( void );
+
+// Texture management (texture.c)
+void _glfwTrackTexture( GLenum target, int format, int bpp );
+void _glfwClearTextureRecords( void );
+void _glfwClearTextures( void );
 
 // Framebuffer configs
 const _GLFWfbconfig *_glfwChooseFBConfig( const _GLFWfbconfig *desired,
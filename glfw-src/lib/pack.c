@@ -0,0 +1,381 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Any
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+//========================================================================
+// Description:
+//
+// This module implements pack files: many images stored in one file,
+// which is mapped into memory when mounted. glfwReadImage (and thereby
+// glfwLoadTexture2D) looks names up in the mounted packs before trying
+// the file system, and reads pack entries straight from the mapping, so
+// no file is opened per image.
+//
+// Pack layout (all integers are little endian, unsigned 32-bit):
+//
+//   Header:  "GLFWPAK1", entry count, index offset, names offset,
+//            names size, padded to 64 bytes
+//   Data:    entry contents, each starting at a multiple of 64 bytes
+//   Names:   NUL terminated entry names
+//   Index:   name hash, name offset (into names), data offset, data size
+//            per entry, sorted by hash and then by name
+//
+// Names use forward slashes; backslashes in looked up names match them.
+// The hash is 32-bit FNV-1a over the name bytes. Packs are written by
+// support/pack/glfwpack.c.
+//
+// Lookups only read the pack list, so images may be read from packs on
+// several threads at once, but packs must not be mounted or unmounted
+// while another thread is reading images.
+//
+//========================================================================
+
+#include "internal.h"
+
+
+#define _GLFW_PACK_HEADER_SIZE 64
+#define _GLFW_PACK_ENTRY_SIZE  16
+
+
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+//========================================================================
+// Read a little endian integer
+//========================================================================
+
+static unsigned long GetUint32( const unsigned char *p )
+{
+    return (unsigned long) p[0] | ((unsigned long) p[1] << 8) |
+           ((unsigned long) p[2] << 16) | ((unsigned long) p[3] << 24);
+}
+
+
+//========================================================================
+// Hash a name (FNV-1a, backslashes counting as slashes)
+//========================================================================
+
+static unsigned long HashName( const char *name )
+{
+    unsigned long hash = 2166136261UL;
+    int c;
+
+    while( *name )
+    {
+        c = (unsigned char) *name++;
+        if( c == '\\' )
+        {
+            c = '/';
+        }
+        hash = ((hash ^ c) * 16777619UL) & 0xffffffffUL;
+    }
+
+    return hash;
+}
+
+
+//========================================================================
+// Compare a name with a name stored in a pack (at most max bytes)
+//========================================================================
+
+static int CompareNames( const char *name, const char *stored, long max )
+{
+    int c;
+
+    for( ; max > 0; max --, name ++, stored ++ )
+    {
+        c = (unsigned char) *name;
+        if( c == '\\' )
+        {
+            c = '/';
+        }
+        if( c != (unsigned char) *stored )
+        {
+            return c - (unsigned char) *stored;
+        }
+        if( c == 0 )
+        {
+            return 0;
+        }
+    }
+
+    // Unterminated name in a broken pack
+    return 1;
+}
+
+
+//========================================================================
+// Find a named entry in a pack. Returns its index record or NULL.
+//========================================================================
+
+static const unsigned char *FindEntry( const _GLFWpack *pack,
+    const char *name, unsigned long hash )
+{
+    const unsigned char *entry;
+    unsigned long offset;
+    int low, high, mid, cmp;
+
+    // Binary search for the first entry with this hash
+    low = 0;
+    high = pack->Count;
+    while( low < high )
+    {
+        mid = (low + high) / 2;
+        if( GetUint32( pack->Index + mid * _GLFW_PACK_ENTRY_SIZE ) < hash )
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    // Entries sharing the hash are sorted by name
+    for( ; low < pack->Count; low ++ )
+    {
+        entry = pack->Index + low * _GLFW_PACK_ENTRY_SIZE;
+        if( GetUint32( entry ) != hash )
+        {
+            break;
+        }
+
+        offset = GetUint32( entry + 4 );
+        if( offset >= (unsigned long) pack->NamesSize )
+        {
+            continue;
+        }
+
+        cmp = CompareNames( name, pack->Names + offset,
+                            pack->NamesSize - (long) offset );
+        if( cmp == 0 )
+        {
+            return entry;
+        }
+        if( cmp < 0 )
+        {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+
+//========================================================================
+// Open a stream on a named entry of the mounted packs
+//========================================================================
+
+int _glfwOpenPackStream( _GLFWstream *stream, const char *name )
+{
+    const _GLFWpack *pack;
+    const unsigned char *entry;
+    unsigned long hash;
+
+    if( _glfwPacks.First == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    hash = HashName( name );
+
+    for( pack = _glfwPacks.First; pack != NULL; pack = pack->Next )
+    {
+        entry = FindEntry( pack, name, hash );
+        if( entry != NULL )
+        {
+            // The mapping is only read, so the cast is safe
+            return _glfwOpenBufferStream( stream,
+                (unsigned char *) pack->Memory.Data + GetUint32( entry + 8 ),
+                (long) GetUint32( entry + 12 ) );
+        }
+    }
+
+    return GL_FALSE;
+}
+
+
+//========================================================================
+// Validate the header and index of a mapped pack
+//========================================================================
+
+static int ParsePack( _GLFWpack *pack )
+{
+    const unsigned char *data = (const unsigned char *) pack->Memory.Data;
+    unsigned long size = (unsigned long) pack->Memory.Size;
+    unsigned long count, index, names, namesSize, offset, length;
+    int i;
+
+    if( size < _GLFW_PACK_HEADER_SIZE || memcmp( data, "GLFWPAK1", 8 ) != 0 )
+    {
+        return GL_FALSE;
+    }
+
+    count     = GetUint32( data + 8 );
+    index     = GetUint32( data + 12 );
+    names     = GetUint32( data + 16 );
+    namesSize = GetUint32( data + 20 );
+
+    if( index > size || count > (size - index) / _GLFW_PACK_ENTRY_SIZE ||
+        names > size || namesSize > size - names )
+    {
+        return GL_FALSE;
+    }
+
+    // Check entry bounds once, so that lookups need not
+    for( i = 0; i < (int) count; i ++ )
+    {
+        offset = GetUint32( data + index + i * _GLFW_PACK_ENTRY_SIZE + 8 );
+        length = GetUint32( data + index + i * _GLFW_PACK_ENTRY_SIZE + 12 );
+        if( offset > size || length > size - offset )
+        {
+            return GL_FALSE;
+        }
+    }
+
+    pack->Count     = (int) count;
+    pack->Index     = data + index;
+    pack->Names     = (const char *) data + names;
+    pack->NamesSize = (long) namesSize;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Unmap and free a pack
+//========================================================================
+
+static void FreePack( _GLFWpack *pack )
+{
+    _glfwPlatformUnmapFile( &pack->Memory );
+    free( pack->Path );
+    free( pack );
+}
+
+
+//========================================================================
+// Unmount all packs (called by glfwTerminate)
+//========================================================================
+
+void _glfwUnmountPacks( void )
+{
+    _GLFWpack *pack;
+
+    while( _glfwPacks.First != NULL )
+    {
+        pack = _glfwPacks.First;
+        _glfwPacks.First = pack->Next;
+        FreePack( pack );
+    }
+}
+
+
+//************************************************************************
+//****                    GLFW user functions                         ****
+//************************************************************************
+
+//========================================================================
+// Mount a pack file. Its entries take precedence over those of packs
+// mounted earlier and over loose files.
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwMountPack( const char *path )
+{
+    _GLFWpack *pack;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return GL_FALSE;
+    }
+
+    pack = (_GLFWpack *) malloc( sizeof(_GLFWpack) );
+    if( pack == NULL )
+    {
+        return GL_FALSE;
+    }
+    memset( pack, 0, sizeof(_GLFWpack) );
+
+    pack->Path = (char *) malloc( strlen( path ) + 1 );
+    if( pack->Path == NULL )
+    {
+        free( pack );
+        return GL_FALSE;
+    }
+    strcpy( pack->Path, path );
+
+    if( !_glfwPlatformMapFile( &pack->Memory, path ) )
+    {
+        free( pack->Path );
+        free( pack );
+        return GL_FALSE;
+    }
+
+    if( !ParsePack( pack ) )
+    {
+        FreePack( pack );
+        return GL_FALSE;
+    }
+
+    pack->Next = _glfwPacks.First;
+    _glfwPacks.First = pack;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Unmount a pack file mounted with glfwMountPack
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwUnmountPack( const char *path )
+{
+    _GLFWpack **prev, *pack;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return GL_FALSE;
+    }
+
+    for( prev = &_glfwPacks.First; *prev != NULL; prev = &pack->Next )
+    {
+        pack = *prev;
+        if( strcmp( pack->Path, path ) == 0 )
+        {
+            *prev = pack->Next;
+            FreePack( pack );
+            return GL_TRUE;
+        }
+    }
+
+    return GL_FALSE;
+}
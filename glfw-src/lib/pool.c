@@ -0,0 +1,1248 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Any
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+//========================================================================
+// Description:
+//
+// This module implements a work stealing thread pool on top of the GLFW
+// threading primitives. Every worker thread owns a Chase-Lev deque: the
+// owner pushes and pops jobs at the bottom without locking, while idle
+// threads steal from the top with a single compare-and-swap. One extra
+// deque is owned by whichever outside thread is currently running
+// glfwParallelFor, so that the calling thread takes part in the work.
+// Threads that were not created by GLFW have no thread ID to claim it
+// with, so they hand out work through the injection queue instead.
+//
+// Jobs submitted from outside the pool go through a mutex protected
+// injection queue. Idle workers sleep on a condition variable and are
+// only woken when the number of queued jobs goes up while somebody is
+// sleeping, so a busy pool never touches the pool mutex.
+//
+// glfwParallelFor splits its range lazily: a thread running a range
+// pushes the upper half to its deque until the range is no larger than
+// the grain size, and then runs what is left. Ranges that nobody steals
+// are popped and run by the same thread, in order.
+//
+// A thread waiting for a parallel-for or task graph run to finish keeps
+// taking jobs. Once it has found nothing for a while it sleeps on a
+// condition variable, and is woken by new jobs or by the thread that
+// finishes the last range or task.
+//
+// A task graph is a set of tasks with dependency edges that is built once
+// and run any number of times (typically once per frame). Each task has
+// a counter of unfinished dependencies, which is reset at the start of a
+// run. The thread that finishes a task decrements the counters of its
+// successors; the last successor that becomes ready is run right away by
+// the same thread and any others are pushed to its deque, so a chain of
+// stages does not bounce between threads.
+//
+//========================================================================
+
+#include "internal.h"
+
+
+// Maximum number of worker threads in a pool
+#define _GLFW_POOL_MAX_WORKERS 64
+
+// Number of times a thread waiting in HelpUntilDone yields before it
+// goes to sleep
+#define _GLFW_POOL_SPIN_COUNT 64
+
+// Number of jobs in each deque (must be a power of two)
+#define _GLFW_DEQUE_SIZE 256
+#define _GLFW_DEQUE_MASK (_GLFW_DEQUE_SIZE - 1)
+
+
+//------------------------------------------------------------------------
+// Parallel-for call, shared by all ranges that it is split into
+//------------------------------------------------------------------------
+typedef struct {
+    GLFWforfun   Function;
+    void         *Arg;
+    int          Grain;
+
+    // Number of indices that have not been processed yet
+    volatile int Remaining;
+} _GLFWforgroup;
+
+//------------------------------------------------------------------------
+// Task graph
+//------------------------------------------------------------------------
+typedef struct {
+    GLFWthreadfun Function;
+    void          *Arg;
+
+    // Tasks that depend on this one
+    int           *Successors;
+    int           SuccessorCount, SuccessorSize;
+
+    // Number of tasks this one depends on, and how many of those have not
+    // finished in the current run
+    int           DependencyCount;
+    volatile int  Pending;
+} _GLFWtask;
+
+typedef struct _GLFWpool_struct _GLFWpool;
+
+typedef struct {
+    _GLFWpool    *Pool;
+    _GLFWtask    *Tasks;
+    int          TaskCount, TaskSize;
+
+    // GL_TRUE if the graph was changed since it was last checked for cycles
+    int          Modified;
+    int          Acyclic;
+
+    // Number of tasks that have not finished in the current run
+    volatile int Remaining;
+} _GLFWgraph;
+
+//------------------------------------------------------------------------
+// Job (a submitted function, a parallel-for range or a graph task)
+//------------------------------------------------------------------------
+typedef struct _GLFWjob_struct _GLFWjob;
+
+struct _GLFWjob_struct {
+    GLFWthreadfun Function;
+    void          *Arg;
+    _GLFWforgroup *Group;
+    int           Begin, End;
+    _GLFWgraph    *Graph;
+    int           Task;
+
+    // Next job in the injection queue
+    _GLFWjob      *Next;
+};
+
+//------------------------------------------------------------------------
+// Chase-Lev work stealing deque. Jobs are stored by value; a job is only
+// overwritten after it has been taken, which needs a successful CAS on
+// Top whenever a thief could be reading it.
+//------------------------------------------------------------------------
+typedef struct {
+    volatile int Top;
+    volatile int Bottom;
+    _GLFWjob     Jobs[ _GLFW_DEQUE_SIZE ];
+} _GLFWdeque;
+
+//------------------------------------------------------------------------
+// Thread pool
+//------------------------------------------------------------------------
+typedef struct {
+    _GLFWpool    *Pool;
+    int          Index;
+    GLFWthread   ID;
+} _GLFWworker;
+
+struct _GLFWpool_struct {
+    int          WorkerCount;
+    _GLFWworker  Workers[ _GLFW_POOL_MAX_WORKERS ];
+
+    // One deque per requested worker, plus a last one for the thread in
+    // glfwParallelFor (this does not change once workers are running)
+    int          DequeCount;
+    _GLFWdeque   *Deques;
+
+    // Serializes outside callers of glfwParallelFor
+    GLFWmutex    MasterLock;
+    volatile GLFWthread MasterID;
+
+    // Protects the injection queue and sleeping threads
+    GLFWmutex    Lock;
+    GLFWcond     WorkCond;
+    GLFWcond     DoneCond;
+    GLFWcond     HelpCond;
+    _GLFWjob     *InjectHead, *InjectTail;
+
+    volatile int Queued;        // Jobs waiting in deques or the queue
+    volatile int Sleeping;      // Workers waiting for WorkCond
+    volatile int Helping;       // Threads waiting for HelpCond
+    volatile int Unfinished;    // Submitted jobs that have not returned
+    volatile int Quit;
+};
+
+
+
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+//========================================================================
+// Push a job to the bottom of a deque (owner only)
+//========================================================================
+
+static int PushJob( _GLFWdeque *deque, const _GLFWjob *job )
+{
+    int b, t;
+
+    b = deque->Bottom;
+    t = deque->Top;
+    if( b - t >= _GLFW_DEQUE_SIZE )
+    {
+        return GL_FALSE;
+    }
+
+    deque->Jobs[ b & _GLFW_DEQUE_MASK ] = *job;
+
+    // The job must be visible before the new bottom
+    _glfwPlatformMemoryBarrier();
+    deque->Bottom = b + 1;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Pop a job from the bottom of a deque (owner only)
+//========================================================================
+
+static int PopJob( _GLFWdeque *deque, _GLFWjob *job )
+{
+    int b, t, result = GL_TRUE;
+
+    b = deque->Bottom - 1;
+    deque->Bottom = b;
+    _glfwPlatformMemoryBarrier();
+    t = deque->Top;
+
+    if( t > b )
+    {
+        // The deque was empty
+        deque->Bottom = b + 1;
+        return GL_FALSE;
+    }
+
+    *job = deque->Jobs[ b & _GLFW_DEQUE_MASK ];
+
+    if( t == b )
+    {
+        // This is the last job, so race any thieves for it
+        result = _glfwPlatformAtomicCompareAndSwap( &deque->Top, t, t + 1 );
+        deque->Bottom = b + 1;
+    }
+
+    return result;
+}
+
+
+//========================================================================
+// Steal a job from the top of a deque (any thread)
+//========================================================================
+
+static int StealJob( _GLFWdeque *deque, _GLFWjob *job )
+{
+    int b, t;
+
+    t = deque->Top;
+    _glfwPlatformMemoryBarrier();
+    b = deque->Bottom;
+
+    if( t >= b )
+    {
+        return GL_FALSE;
+    }
+
+    *job = deque->Jobs[ t & _GLFW_DEQUE_MASK ];
+
+    // If Top moved, the job was taken by someone else and the copy may
+    // be torn, so it is discarded
+    return _glfwPlatformAtomicCompareAndSwap( &deque->Top, t, t + 1 );
+}
+
+
+//========================================================================
+// Wake one sleeping worker, or the threads in HelpUntilDone if no worker
+// is sleeping
+//========================================================================
+
+static void WakeWorker( _GLFWpool *pool )
+{
+    if( pool->Sleeping > 0 )
+    {
+        glfwLockMutex( pool->Lock );
+        glfwSignalCond( pool->WorkCond );
+        glfwUnlockMutex( pool->Lock );
+    }
+    else if( pool->Helping > 0 )
+    {
+        glfwLockMutex( pool->Lock );
+        glfwBroadcastCond( pool->HelpCond );
+        glfwUnlockMutex( pool->Lock );
+    }
+}
+
+
+//========================================================================
+// Wake the threads in HelpUntilDone after a counter they may be waiting
+// for has reached zero
+//========================================================================
+
+static void WakeHelpers( _GLFWpool *pool )
+{
+    if( pool->Helping > 0 )
+    {
+        glfwLockMutex( pool->Lock );
+        glfwBroadcastCond( pool->HelpCond );
+        glfwUnlockMutex( pool->Lock );
+    }
+}
+
+
+//========================================================================
+// Queue a job, on the given deque if possible (self is the index of the
+// deque owned by the calling thread, or -1)
+//========================================================================
+
+static int QueueJob( _GLFWpool *pool, int self, const _GLFWjob *job )
+{
+    _GLFWjob *node;
+
+    if( self < 0 || !PushJob( &pool->Deques[ self ], job ) )
+    {
+        node = (_GLFWjob *) malloc( sizeof(_GLFWjob) );
+        if( node == NULL )
+        {
+            return GL_FALSE;
+        }
+
+        *node = *job;
+        node->Next = NULL;
+
+        glfwLockMutex( pool->Lock );
+        if( pool->InjectTail )
+        {
+            pool->InjectTail->Next = node;
+        }
+        else
+        {
+            pool->InjectHead = node;
+        }
+        pool->InjectTail = node;
+        glfwUnlockMutex( pool->Lock );
+    }
+
+    // This is a full barrier, which pairs with the one in WorkerThread
+    // so that either the job or the sleeping worker is seen
+    _glfwPlatformAtomicAdd( &pool->Queued, 1 );
+    WakeWorker( pool );
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Take a job from the own deque, the injection queue or another deque
+//========================================================================
+
+static int TakeJob( _GLFWpool *pool, int self, unsigned int *seed,
+                    _GLFWjob *job )
+{
+    _GLFWjob *node;
+    int      i, count, victim;
+
+    if( self >= 0 && PopJob( &pool->Deques[ self ], job ) )
+    {
+        _glfwPlatformAtomicAdd( &pool->Queued, -1 );
+        return GL_TRUE;
+    }
+
+    if( pool->InjectHead != NULL )
+    {
+        glfwLockMutex( pool->Lock );
+        node = pool->InjectHead;
+        if( node )
+        {
+            pool->InjectHead = node->Next;
+            if( pool->InjectHead == NULL )
+            {
+                pool->InjectTail = NULL;
+            }
+        }
+        glfwUnlockMutex( pool->Lock );
+
+        if( node )
+        {
+            *job = *node;
+            free( node );
+            _glfwPlatformAtomicAdd( &pool->Queued, -1 );
+            return GL_TRUE;
+        }
+    }
+
+    // Try every other deque once, starting at a random one
+    count = pool->DequeCount;
+    *seed = *seed * 1103515245 + 12345;
+    victim = (int) ((*seed >> 16) % (unsigned int) count);
+
+    for( i = 0; i < count; i ++ )
+    {
+        if( victim != self && StealJob( &pool->Deques[ victim ], job ) )
+        {
+            _glfwPlatformAtomicAdd( &pool->Queued, -1 );
+            return GL_TRUE;
+        }
+
+        victim = (victim + 1) % count;
+    }
+
+    return GL_FALSE;
+}
+
+
+//========================================================================
+// Run a parallel-for range, handing out its upper halves to other threads
+//========================================================================
+
+static void RunRange( _GLFWpool *pool, int self, const _GLFWjob *range )
+{
+    _GLFWforgroup *group = range->Group;
+    _GLFWjob      job;
+    int           begin, end;
+
+    begin = range->Begin;
+    end   = range->End;
+
+    job.Function = NULL;
+    job.Arg      = NULL;
+    job.Group    = group;
+    job.Graph    = NULL;
+    job.Task     = 0;
+
+    while( end - begin > group->Grain )
+    {
+        job.Begin = begin + (end - begin) / 2;
+        job.End   = end;
+
+        if( self < 0 )
+        {
+            // Threads without a deque hand out halves through the
+            // injection queue
+            if( !QueueJob( pool, self, &job ) )
+            {
+                break;
+            }
+        }
+        else
+        {
+            if( !PushJob( &pool->Deques[ self ], &job ) )
+            {
+                break;
+            }
+
+            _glfwPlatformAtomicAdd( &pool->Queued, 1 );
+            WakeWorker( pool );
+        }
+
+        end = job.Begin;
+    }
+
+    group->Function( begin, end, group->Arg );
+
+    // The group may be gone as soon as this reaches zero
+    if( _glfwPlatformAtomicAdd( &group->Remaining, -(end - begin) ) == 0 )
+    {
+        WakeHelpers( pool );
+    }
+}
+
+
+//========================================================================
+// Run a graph task and then any successors that it makes ready
+//========================================================================
+
+static void RunTask( _GLFWpool *pool, int self, _GLFWgraph *graph,
+                     int index )
+{
+    _GLFWtask *task, *successor;
+    _GLFWjob  job;
+    int       i, next;
+
+    job.Function = NULL;
+    job.Arg      = NULL;
+    job.Group    = NULL;
+    job.Begin    = 0;
+    job.End      = 0;
+    job.Graph    = graph;
+
+    while( index >= 0 )
+    {
+        task = graph->Tasks + index;
+        task->Function( task->Arg );
+
+        // Keep one ready successor for this thread and queue the rest
+        next = -1;
+        for( i = 0; i < task->SuccessorCount; i ++ )
+        {
+            successor = graph->Tasks + task->Successors[ i ];
+            if( _glfwPlatformAtomicAdd( &successor->Pending, -1 ) != 0 )
+            {
+                continue;
+            }
+
+            if( next >= 0 )
+            {
+                job.Task = next;
+                if( !QueueJob( pool, self, &job ) )
+                {
+                    RunTask( pool, self, graph, next );
+                }
+            }
+            next = task->Successors[ i ];
+        }
+
+        // The graph run may be over as soon as this reaches zero
+        if( _glfwPlatformAtomicAdd( &graph->Remaining, -1 ) == 0 )
+        {
+            WakeHelpers( pool );
+        }
+
+        index = next;
+    }
+}
+
+
+//========================================================================
+// Run a job of any kind
+//========================================================================
+
+static void RunJob( _GLFWpool *pool, int self, const _GLFWjob *job )
+{
+    if( job->Group )
+    {
+        RunRange( pool, self, job );
+        return;
+    }
+
+    if( job->Graph )
+    {
+        RunTask( pool, self, job->Graph, job->Task );
+        return;
+    }
+
+    job->Function( job->Arg );
+
+    if( _glfwPlatformAtomicAdd( &pool->Unfinished, -1 ) == 0 )
+    {
+        glfwLockMutex( pool->Lock );
+        glfwBroadcastCond( pool->DoneCond );
+        glfwUnlockMutex( pool->Lock );
+    }
+}
+
+
+//========================================================================
+// Return the index of the deque owned by the calling thread, or -1
+//========================================================================
+
+static int FindSelf( _GLFWpool *pool )
+{
+    GLFWthread ID;
+    int        i;
+
+    // A thread that was not created by GLFW has no ID of its own (and
+    // -1 is also what MasterID and unstarted workers hold), so it never
+    // owns a deque
+    ID = glfwGetThreadID();
+    if( ID < 0 )
+    {
+        return -1;
+    }
+
+    for( i = 0; i < pool->WorkerCount; i ++ )
+    {
+        if( pool->Workers[ i ].ID == ID )
+        {
+            return i;
+        }
+    }
+
+    if( pool->MasterID == ID )
+    {
+        return pool->DequeCount - 1;
+    }
+
+    return -1;
+}
+
+
+//========================================================================
+// Return the deque to be used by the calling thread, making it the owner
+// of the extra deque if it is not a worker. Returns -1 for threads not
+// created by GLFW, which queue their jobs on the injection queue instead.
+//========================================================================
+
+static int EnterPool( _GLFWpool *pool, int *master )
+{
+    int self;
+
+    // Outside threads take turns owning the extra deque, while workers
+    // (and nested calls) use the deque they already own. Threads without
+    // a GLFW ID cannot be told apart, so a nested call from one could not
+    // see that it already holds MasterLock.
+    self = FindSelf( pool );
+    if( self < 0 && glfwGetThreadID() >= 0 )
+    {
+        glfwLockMutex( pool->MasterLock );
+        pool->MasterID = glfwGetThreadID();
+        self    = pool->DequeCount - 1;
+        *master = GL_TRUE;
+    }
+    else
+    {
+        *master = GL_FALSE;
+    }
+
+    return self;
+}
+
+
+//========================================================================
+// Give up the extra deque, if it was taken by EnterPool
+//========================================================================
+
+static void LeavePool( _GLFWpool *pool, int master )
+{
+    if( master )
+    {
+        pool->MasterID = -1;
+        glfwUnlockMutex( pool->MasterLock );
+    }
+}
+
+
+//========================================================================
+// Run jobs until the given counter reaches zero. Jobs run here may belong
+// to other calls or be submitted jobs, which is fine.
+//========================================================================
+
+static void HelpUntilDone( _GLFWpool *pool, int self,
+                           volatile int *remaining )
+{
+    _GLFWjob     job;
+    unsigned int seed;
+    int          spins = 0;
+
+    seed = (unsigned int) self * 2654435761U + 7;
+
+    while( *remaining > 0 )
+    {
+        if( TakeJob( pool, self, &seed, &job ) )
+        {
+            RunJob( pool, self, &job );
+            spins = 0;
+        }
+        else if( spins < _GLFW_POOL_SPIN_COUNT )
+        {
+            _glfwPlatformSleep( 0.0 );
+            spins ++;
+        }
+        else
+        {
+            // The remaining work is running on other threads. The atomic
+            // add is a full barrier, which pairs with the one on the
+            // counter (or on Queued) so that either the zero (or the new
+            // job) or this sleeping thread is seen.
+            glfwLockMutex( pool->Lock );
+            _glfwPlatformAtomicAdd( &pool->Helping, 1 );
+            while( *remaining > 0 && pool->Queued <= 0 )
+            {
+                glfwWaitCond( pool->HelpCond, pool->Lock, GLFW_INFINITY );
+            }
+            _glfwPlatformAtomicAdd( &pool->Helping, -1 );
+            glfwUnlockMutex( pool->Lock );
+
+            spins = 0;
+        }
+    }
+}
+
+
+//========================================================================
+// Check that a task graph has no cycles (Kahn's algorithm)
+//========================================================================
+
+static int CheckTaskGraph( _GLFWgraph *graph )
+{
+    int *pending, *ready;
+    int i, j, count = 0, readyCount = 0;
+    _GLFWtask *task;
+
+    if( graph->TaskCount == 0 )
+    {
+        return GL_TRUE;
+    }
+
+    pending = (int *) malloc( 2 * graph->TaskCount * sizeof(int) );
+    if( pending == NULL )
+    {
+        return GL_FALSE;
+    }
+    ready = pending + graph->TaskCount;
+
+    for( i = 0; i < graph->TaskCount; i ++ )
+    {
+        pending[ i ] = graph->Tasks[ i ].DependencyCount;
+        if( pending[ i ] == 0 )
+        {
+            ready[ readyCount ++ ] = i;
+        }
+    }
+
+    while( readyCount > 0 )
+    {
+        task = graph->Tasks + ready[ -- readyCount ];
+        count ++;
+
+        for( j = 0; j < task->SuccessorCount; j ++ )
+        {
+            if( -- pending[ task->Successors[ j ] ] == 0 )
+            {
+                ready[ readyCount ++ ] = task->Successors[ j ];
+            }
+        }
+    }
+
+    free( pending );
+
+    return count == graph->TaskCount;
+}
+
+
+//========================================================================
+// Worker thread main loop
+//========================================================================
+
+static void GLFWCALL WorkerThread( void *arg )
+{
+    _GLFWworker  *worker = (_GLFWworker *) arg;
+    _GLFWpool    *pool = worker->Pool;
+    _GLFWjob     job;
+    unsigned int seed;
+
+    seed = (unsigned int) worker->Index * 2654435761U + 1;
+
+    for( ;; )
+    {
+        if( TakeJob( pool, worker->Index, &seed, &job ) )
+        {
+            RunJob( pool, worker->Index, &job );
+            continue;
+        }
+
+        glfwLockMutex( pool->Lock );
+        _glfwPlatformAtomicAdd( &pool->Sleeping, 1 );
+        while( pool->Queued <= 0 && !pool->Quit )
+        {
+            glfwWaitCond( pool->WorkCond, pool->Lock, GLFW_INFINITY );
+        }
+        _glfwPlatformAtomicAdd( &pool->Sleeping, -1 );
+        glfwUnlockMutex( pool->Lock );
+
+        if( pool->Quit && pool->Queued <= 0 )
+        {
+            break;
+        }
+    }
+}
+
+
+
+//************************************************************************
+//****                     GLFW user functions                        ****
+//************************************************************************
+
+//========================================================================
+// Create a thread pool with the given number of worker threads, or one
+// less than the number of processors if threads is zero or negative
+//========================================================================
+
+GLFWAPI GLFWpool GLFWAPIENTRY glfwCreateThreadPool( int threads )
+{
+    _GLFWpool *pool;
+    char      name[ 32 ];
+    int       i;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return (GLFWpool) 0;
+    }
+
+    if( threads <= 0 )
+    {
+        // The thread calling glfwParallelFor does its share of the work
+        threads = _glfwGetUsableProcessors() - 1;
+        if( threads < 1 )
+        {
+            threads = 1;
+        }
+    }
+    if( threads > _GLFW_POOL_MAX_WORKERS )
+    {
+        threads = _GLFW_POOL_MAX_WORKERS;
+    }
+
+    pool = (_GLFWpool *) calloc( 1, sizeof(_GLFWpool) );
+    if( pool == NULL )
+    {
+        return (GLFWpool) 0;
+    }
+
+    pool->DequeCount = threads + 1;
+    pool->Deques = (_GLFWdeque *) calloc( pool->DequeCount,
+                                          sizeof(_GLFWdeque) );
+    pool->Lock       = glfwCreateMutex();
+    pool->MasterLock = glfwCreateMutex();
+    pool->WorkCond   = glfwCreateCond();
+    pool->DoneCond   = glfwCreateCond();
+    pool->HelpCond   = glfwCreateCond();
+    pool->MasterID   = -1;
+
+    if( !pool->Deques || !pool->Lock || !pool->MasterLock ||
+        !pool->WorkCond || !pool->DoneCond || !pool->HelpCond )
+    {
+        glfwDestroyThreadPool( (GLFWpool) pool );
+        return (GLFWpool) 0;
+    }
+
+    // Start the workers. If threads are not available, the pool still
+    // works, with all jobs run by the calling thread.
+    for( i = 0; i < threads; i ++ )
+    {
+        pool->Workers[ i ].Pool  = pool;
+        pool->Workers[ i ].Index = i;
+        pool->Workers[ i ].ID    = -1;
+    }
+
+    for( i = 0; i < threads; i ++ )
+    {
+        pool->Workers[ i ].ID = glfwCreateThread( WorkerThread,
+                                                  &pool->Workers[ i ] );
+        if( pool->Workers[ i ].ID < 0 )
+        {
+            break;
+        }
+
+        // Make the workers easy to tell apart in top and perf
+        sprintf( name, "glfw-pool-%i", i );
+        glfwSetThreadName( pool->Workers[ i ].ID, name );
+
+        pool->WorkerCount = i + 1;
+    }
+
+    return (GLFWpool) pool;
+}
+
+
+//========================================================================
+// Wait for all submitted jobs and destroy a thread pool
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwDestroyThreadPool( GLFWpool p )
+{
+    _GLFWpool *pool = (_GLFWpool *) p;
+    int       i;
+
+    if( !_glfwInitialized || !pool )
+    {
+        return;
+    }
+
+    if( pool->WorkerCount > 0 )
+    {
+        glfwWaitThreadPool( p );
+
+        glfwLockMutex( pool->Lock );
+        pool->Quit = GL_TRUE;
+        glfwBroadcastCond( pool->WorkCond );
+        glfwUnlockMutex( pool->Lock );
+
+        for( i = 0; i < pool->WorkerCount; i ++ )
+        {
+            glfwWaitThread( pool->Workers[ i ].ID, GLFW_WAIT );
+        }
+    }
+
+    if( pool->Lock )
+    {
+        glfwDestroyMutex( pool->Lock );
+    }
+    if( pool->MasterLock )
+    {
+        glfwDestroyMutex( pool->MasterLock );
+    }
+    if( pool->WorkCond )
+    {
+        glfwDestroyCond( pool->WorkCond );
+    }
+    if( pool->DoneCond )
+    {
+        glfwDestroyCond( pool->DoneCond );
+    }
+    if( pool->HelpCond )
+    {
+        glfwDestroyCond( pool->HelpCond );
+    }
+
+    free( pool->Deques );
+    free( pool );
+}
+
+
+//========================================================================
+// Submit a job to a thread pool
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwSubmitJob( GLFWpool p, GLFWthreadfun fun,
+                                        void *arg )
+{
+    _GLFWpool *pool = (_GLFWpool *) p;
+    _GLFWjob  job;
+
+    if( !_glfwInitialized || !pool || !fun )
+    {
+        return GL_FALSE;
+    }
+
+    // Without workers, the job is simply run right away
+    if( pool->WorkerCount == 0 )
+    {
+        fun( arg );
+        return GL_TRUE;
+    }
+
+    job.Function = fun;
+    job.Arg      = arg;
+    job.Group    = NULL;
+    job.Begin    = 0;
+    job.End      = 0;
+    job.Graph    = NULL;
+    job.Task     = 0;
+
+    _glfwPlatformAtomicAdd( &pool->Unfinished, 1 );
+
+    // Jobs submitted by a job go on the deque of the thread running it
+    if( !QueueJob( pool, FindSelf( pool ), &job ) )
+    {
+        _glfwPlatformAtomicAdd( &pool->Unfinished, -1 );
+        return GL_FALSE;
+    }
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Wait for all jobs submitted to a thread pool to return. This must not
+// be called from a job running in the same pool.
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwWaitThreadPool( GLFWpool p )
+{
+    _GLFWpool *pool = (_GLFWpool *) p;
+
+    if( !_glfwInitialized || !pool )
+    {
+        return;
+    }
+
+    glfwLockMutex( pool->Lock );
+    while( pool->Unfinished > 0 )
+    {
+        glfwWaitCond( pool->DoneCond, pool->Lock, GLFW_INFINITY );
+    }
+    glfwUnlockMutex( pool->Lock );
+}
+
+
+//========================================================================
+// Call fun( first, last, arg ) for disjoint subranges [first, last) that
+// together cover [begin, end), using the pool and the calling thread.
+// Subranges are no larger than grain, which is chosen from the range and
+// the number of threads if it is zero or negative. Returns when the whole
+// range has been processed.
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwParallelFor( GLFWpool p, int begin, int end,
+                                           int grain, GLFWforfun fun,
+                                           void *arg )
+{
+    _GLFWpool     *pool = (_GLFWpool *) p;
+    _GLFWforgroup group;
+    _GLFWjob      job;
+    int           self, master;
+
+    if( !_glfwInitialized || !pool || !fun || end <= begin )
+    {
+        return;
+    }
+
+    if( grain <= 0 )
+    {
+        grain = (end - begin) / (8 * (pool->WorkerCount + 1));
+        if( grain < 1 )
+        {
+            grain = 1;
+        }
+    }
+
+    self = EnterPool( pool, &master );
+
+    group.Function  = fun;
+    group.Arg       = arg;
+    group.Grain     = grain;
+    group.Remaining = end - begin;
+
+    job.Function = NULL;
+    job.Arg      = NULL;
+    job.Group    = &group;
+    job.Begin    = begin;
+    job.End      = end;
+    job.Graph    = NULL;
+    job.Task     = 0;
+
+    RunRange( pool, self, &job );
+
+    // Help out until every subrange has been processed
+    HelpUntilDone( pool, self, &group.Remaining );
+
+    LeavePool( pool, master );
+}
+
+
+//========================================================================
+// Create an empty task graph to be run on the given pool
+//========================================================================
+
+GLFWAPI GLFWtaskgraph GLFWAPIENTRY glfwCreateTaskGraph( GLFWpool pool )
+{
+    _GLFWgraph *graph;
+
+    if( !_glfwInitialized || !pool )
+    {
+        return (GLFWtaskgraph) 0;
+    }
+
+    graph = (_GLFWgraph *) calloc( 1, sizeof(_GLFWgraph) );
+    if( graph == NULL )
+    {
+        return (GLFWtaskgraph) 0;
+    }
+
+    graph->Pool     = (_GLFWpool *) pool;
+    graph->Modified = GL_TRUE;
+
+    return (GLFWtaskgraph) graph;
+}
+
+
+//========================================================================
+// Destroy a task graph
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwDestroyTaskGraph( GLFWtaskgraph g )
+{
+    _GLFWgraph *graph = (_GLFWgraph *) g;
+    int        i;
+
+    if( !_glfwInitialized || !graph )
+    {
+        return;
+    }
+
+    for( i = 0; i < graph->TaskCount; i ++ )
+    {
+        free( graph->Tasks[ i ].Successors );
+    }
+
+    free( graph->Tasks );
+    free( graph );
+}
+
+
+//========================================================================
+// Add a task to a task graph. Returns the index of the new task, or -1.
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwAddTask( GLFWtaskgraph g, GLFWthreadfun fun,
+                                      void *arg )
+{
+    _GLFWgraph *graph = (_GLFWgraph *) g;
+    _GLFWtask  *tasks;
+    int        size;
+
+    if( !_glfwInitialized || !graph || !fun )
+    {
+        return -1;
+    }
+
+    if( graph->TaskCount == graph->TaskSize )
+    {
+        size = graph->TaskSize ? graph->TaskSize * 2 : 16;
+        tasks = (_GLFWtask *) realloc( graph->Tasks,
+                                       size * sizeof(_GLFWtask) );
+        if( tasks == NULL )
+        {
+            return -1;
+        }
+
+        graph->Tasks    = tasks;
+        graph->TaskSize = size;
+    }
+
+    memset( graph->Tasks + graph->TaskCount, 0, sizeof(_GLFWtask) );
+    graph->Tasks[ graph->TaskCount ].Function = fun;
+    graph->Tasks[ graph->TaskCount ].Arg      = arg;
+    graph->Modified = GL_TRUE;
+
+    return graph->TaskCount ++;
+}
+
+
+//========================================================================
+// Make a task wait for another task to finish in every run of the graph
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwAddTaskDependency( GLFWtaskgraph g, int task,
+                                                int dependency )
+{
+    _GLFWgraph *graph = (_GLFWgraph *) g;
+    _GLFWtask  *before;
+    int        *successors;
+    int        size;
+
+    if( !_glfwInitialized || !graph )
+    {
+        return GL_FALSE;
+    }
+
+    if( task < 0 || task >= graph->TaskCount ||
+        dependency < 0 || dependency >= graph->TaskCount ||
+        task == dependency )
+    {
+        return GL_FALSE;
+    }
+
+    before = graph->Tasks + dependency;
+
+    if( before->SuccessorCount == before->SuccessorSize )
+    {
+        size = before->SuccessorSize ? before->SuccessorSize * 2 : 4;
+        successors = (int *) realloc( before->Successors,
+                                      size * sizeof(int) );
+        if( successors == NULL )
+        {
+            return GL_FALSE;
+        }
+
+        before->Successors    = successors;
+        before->SuccessorSize = size;
+    }
+
+    before->Successors[ before->SuccessorCount ++ ] = task;
+    graph->Tasks[ task ].DependencyCount ++;
+    graph->Modified = GL_TRUE;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Run every task of a task graph once, in dependency order, using the
+// pool and the calling thread. Returns GL_FALSE without running anything
+// if the dependencies form a cycle.
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwRunTaskGraph( GLFWtaskgraph g )
+{
+    _GLFWgraph *graph = (_GLFWgraph *) g;
+    _GLFWpool  *pool;
+    _GLFWjob   job;
+    int        i, self, master;
+
+    if( !_glfwInitialized || !graph )
+    {
+        return GL_FALSE;
+    }
+
+    if( graph->Modified )
+    {
+        graph->Acyclic  = CheckTaskGraph( graph );
+        graph->Modified = GL_FALSE;
+    }
+
+    if( !graph->Acyclic )
+    {
+        return GL_FALSE;
+    }
+
+    if( graph->TaskCount == 0 )
+    {
+        return GL_TRUE;
+    }
+
+    pool = graph->Pool;
+
+    for( i = 0; i < graph->TaskCount; i ++ )
+    {
+        graph->Tasks[ i ].Pending = graph->Tasks[ i ].DependencyCount;
+    }
+    graph->Remaining = graph->TaskCount;
+
+    self = EnterPool( pool, &master );
+
+    // Queue every task without dependencies
+    job.Function = NULL;
+    job.Arg      = NULL;
+    job.Group    = NULL;
+    job.Begin    = 0;
+    job.End      = 0;
+    job.Graph    = graph;
+
+    for( i = 0; i < graph->TaskCount; i ++ )
+    {
+        if( graph->Tasks[ i ].DependencyCount == 0 )
+        {
+            job.Task = i;
+            if( !QueueJob( pool, self, &job ) )
+            {
+                RunTask( pool, self, graph, i );
+            }
+        }
+    }
+
+    // Help out until every task has finished
+    HelpUntilDone( pool, self, &graph->Remaining );
+
+    LeavePool( pool, master );
+
+    return GL_TRUE;
+}
+
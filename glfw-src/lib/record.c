@@ -0,0 +1,528 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Any
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+//========================================================================
+// Description:
+//
+// This module records every presented frame to a single file. Frames are
+// read back by glfwSwapBuffers through the capture ring (capture.c), put
+// in a bounded queue and written by a separate thread. When the queue is
+// full, glfwSwapBuffers either waits for the writer or drops the frame,
+// depending on GLFW_RECORD_DROP_FRAMES_BIT.
+//
+// File layout (all integers are little endian):
+//
+//   Header:  "GLFWREC1", pixel format (u32, GL token), flags (u32)
+//   Frame:   "FRAM", number (u32), width (u32), height (u32),
+//            encoding (u32), size (u32), time in microseconds (u64),
+//            followed by size bytes of pixel data (rows bottom to top)
+//   Index:   number (u32), time (u64), frame offset (u64) per frame
+//   Trailer: "FIDX", frame count (u32), index offset (u64)
+//
+// Encoding 0 is raw pixels. Encoding 1 is the previous frame XOR:ed with
+// this one, compressed with TGA style run-length packets of 32-bit
+// pixels. Frame numbers are consecutive, so dropped frames show up as
+// gaps.
+//
+//========================================================================
+
+#include "internal.h"
+
+#include <math.h>
+
+
+#define _GLFW_RECORD_RAW   0
+#define _GLFW_RECORD_DELTA 1
+
+
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+//========================================================================
+// Store integers in little endian byte order
+//========================================================================
+
+static void PutUint32( unsigned char *p, unsigned long x )
+{
+    p[0] = (unsigned char) (x & 255);
+    p[1] = (unsigned char) ((x >> 8) & 255);
+    p[2] = (unsigned char) ((x >> 16) & 255);
+    p[3] = (unsigned char) ((x >> 24) & 255);
+}
+
+static void PutUint64( unsigned char *p, double x )
+{
+    double hi;
+
+    // Doubles hold integers exactly up to 2^53, which is plenty
+    hi = (double) (unsigned long) (x / 4294967296.0);
+    PutUint32( p, (unsigned long) (x - hi * 4294967296.0) );
+    PutUint32( p + 4, (unsigned long) hi );
+}
+
+static void PutMicroseconds( unsigned char *p, double time )
+{
+    // Going through long would overflow after 35 minutes where long is
+    // 32-bit, so stay in double precision
+    PutUint64( p, time > 0.0 ? floor( time * 1000000.0 ) : 0.0 );
+}
+
+
+//========================================================================
+// Write data to the recording, remembering any error
+//========================================================================
+
+static void WriteRecording( const void *data, long size )
+{
+    if( _glfwRecorder.Error )
+    {
+        return;
+    }
+
+    if( (long) fwrite( data, 1, size, _glfwRecorder.File ) != size )
+    {
+        _glfwRecorder.Error = GL_TRUE;
+        return;
+    }
+
+    _glfwRecorder.Offset += (double) size;
+}
+
+
+//========================================================================
+// Encode and write a queued frame (called by the writer thread)
+//========================================================================
+
+static void WriteFrame( _GLFWrecframe *frame )
+{
+    unsigned char hdr[ 32 ], *data, *prev, tmp;
+    _GLFWrecindex *index;
+    long size, psize, i;
+    int  encoding;
+
+    size = (long) frame->Width * frame->Height * 4;
+    data = frame->Data;
+    encoding = _GLFW_RECORD_RAW;
+
+    // Grow the frame index as needed
+    if( _glfwRecorder.IndexSize == _glfwRecorder.IndexCapacity )
+    {
+        index = (_GLFWrecindex *) realloc( _glfwRecorder.Index,
+                    (_glfwRecorder.IndexCapacity * 2 + 64) *
+                    sizeof(_GLFWrecindex) );
+        if( index == NULL )
+        {
+            _glfwRecorder.Error = GL_TRUE;
+            return;
+        }
+        _glfwRecorder.Index = index;
+        _glfwRecorder.IndexCapacity = _glfwRecorder.IndexCapacity * 2 + 64;
+    }
+
+    if( _glfwRecorder.Flags & GLFW_RECORD_DELTA_BIT )
+    {
+        if( _glfwRecorder.Previous && _glfwRecorder.PreviousSize == size )
+        {
+            if( _glfwRecorder.PacketsSize < size + size / 4 )
+            {
+                free( _glfwRecorder.Packets );
+                _glfwRecorder.Packets = (unsigned char *)
+                    malloc( size + size / 4 );
+                _glfwRecorder.PacketsSize = _glfwRecorder.Packets ?
+                    size + size / 4 : 0;
+            }
+
+            if( _glfwRecorder.Packets )
+            {
+                // XOR with the previous frame, which at the same time is
+                // replaced by this frame (the queue entry is ours now)
+                prev = _glfwRecorder.Previous;
+                for( i = 0; i < size; i ++ )
+                {
+                    tmp = data[ i ];
+                    data[ i ] ^= prev[ i ];
+                    prev[ i ] = tmp;
+                }
+
+                psize = _glfwEncodeRLE( _glfwRecorder.Packets, data,
+                            frame->Width * frame->Height, 4 );
+
+                // Fall back to raw pixels if nothing was gained
+                if( psize < size )
+                {
+                    data = _glfwRecorder.Packets;
+                    size = psize;
+                    encoding = _GLFW_RECORD_DELTA;
+                }
+                else
+                {
+                    data = prev;
+                }
+            }
+        }
+        else
+        {
+            // The first frame, or the size changed: start over
+            free( _glfwRecorder.Previous );
+            _glfwRecorder.Previous = (unsigned char *) malloc( size );
+            _glfwRecorder.PreviousSize = 0;
+            if( _glfwRecorder.Previous )
+            {
+                memcpy( _glfwRecorder.Previous, data, size );
+                _glfwRecorder.PreviousSize = size;
+            }
+        }
+    }
+
+    index = &_glfwRecorder.Index[ _glfwRecorder.IndexSize ++ ];
+    index->Number = frame->Number;
+    index->Time   = frame->Time;
+    index->Offset = _glfwRecorder.Offset;
+
+    memcpy( hdr, "FRAM", 4 );
+    PutUint32( hdr + 4, (unsigned long) frame->Number );
+    PutUint32( hdr + 8, (unsigned long) frame->Width );
+    PutUint32( hdr + 12, (unsigned long) frame->Height );
+    PutUint32( hdr + 16, (unsigned long) encoding );
+    PutUint32( hdr + 20, (unsigned long) size );
+    PutMicroseconds( hdr + 24, frame->Time );
+
+    WriteRecording( hdr, 32 );
+    WriteRecording( data, size );
+}
+
+
+//========================================================================
+// Writer thread: write queued frames until told to quit
+//========================================================================
+
+static void GLFWCALL RecorderThread( void *arg )
+{
+    _GLFWrecframe *frame;
+
+    for( ;; )
+    {
+        glfwLockMutex( _glfwRecorder.Mutex );
+        while( _glfwRecorder.Count == 0 && !_glfwRecorder.Quit )
+        {
+            glfwWaitCond( _glfwRecorder.Cond, _glfwRecorder.Mutex,
+                          GLFW_INFINITY );
+        }
+
+        // The queue is always drained before quitting
+        if( _glfwRecorder.Count == 0 )
+        {
+            glfwUnlockMutex( _glfwRecorder.Mutex );
+            break;
+        }
+        frame = &_glfwRecorder.Queue[ _glfwRecorder.Head ];
+        glfwUnlockMutex( _glfwRecorder.Mutex );
+
+        // The entry stays in the queue until written, so the producer
+        // will not reuse it
+        WriteFrame( frame );
+
+        glfwLockMutex( _glfwRecorder.Mutex );
+        _glfwRecorder.Head = (_glfwRecorder.Head + 1) %
+                             _GLFW_RECORD_QUEUE_SIZE;
+        _glfwRecorder.Count --;
+        _glfwRecorder.Written ++;
+        glfwBroadcastCond( _glfwRecorder.Cond );
+        glfwUnlockMutex( _glfwRecorder.Mutex );
+    }
+}
+
+
+//========================================================================
+// Write the frame index and trailer, and close the file
+//========================================================================
+
+static int CloseRecording( void )
+{
+    unsigned char buf[ 20 ];
+    double indexOffset;
+    int i, ok;
+
+    indexOffset = _glfwRecorder.Offset;
+
+    for( i = 0; i < _glfwRecorder.IndexSize; i ++ )
+    {
+        PutUint32( buf, (unsigned long) _glfwRecorder.Index[ i ].Number );
+        PutMicroseconds( buf + 4, _glfwRecorder.Index[ i ].Time );
+        PutUint64( buf + 12, _glfwRecorder.Index[ i ].Offset );
+        WriteRecording( buf, 20 );
+    }
+
+    memcpy( buf, "FIDX", 4 );
+    PutUint32( buf + 4, (unsigned long) _glfwRecorder.IndexSize );
+    PutUint64( buf + 8, indexOffset );
+    WriteRecording( buf, 16 );
+
+    ok = !_glfwRecorder.Error;
+    if( fclose( _glfwRecorder.File ) != 0 )
+    {
+        ok = GL_FALSE;
+    }
+    _glfwRecorder.File = NULL;
+
+    return ok;
+}
+
+
+//========================================================================
+// Queue a frame that has been read back (called on the main thread).
+// Waits for the writer or drops the frame if the queue is full.
+//========================================================================
+
+void _glfwQueueRecordedFrame( const GLFWimage *img, double time )
+{
+    _GLFWrecframe *frame;
+    long size;
+    int  number, slot;
+
+    // Frames read back before the recording started are not part of it
+    if( !_glfwRecorder.Mutex || time < _glfwRecorder.StartTime )
+    {
+        return;
+    }
+
+    size = (long) img->Width * img->Height * 4;
+    number = _glfwRecorder.Recorded ++;
+
+    glfwLockMutex( _glfwRecorder.Mutex );
+    if( _glfwRecorder.Flags & GLFW_RECORD_DROP_FRAMES_BIT )
+    {
+        if( _glfwRecorder.Count == _GLFW_RECORD_QUEUE_SIZE )
+        {
+            glfwUnlockMutex( _glfwRecorder.Mutex );
+            _glfwRecorder.Dropped ++;
+            return;
+        }
+    }
+    else
+    {
+        // Apply backpressure by waiting for the writer
+        while( _glfwRecorder.Count == _GLFW_RECORD_QUEUE_SIZE )
+        {
+            glfwWaitCond( _glfwRecorder.Cond, _glfwRecorder.Mutex,
+                          GLFW_INFINITY );
+        }
+    }
+    slot = (_glfwRecorder.Head + _glfwRecorder.Count) %
+           _GLFW_RECORD_QUEUE_SIZE;
+    glfwUnlockMutex( _glfwRecorder.Mutex );
+
+    // The free entry is not touched by the writer, so it can be filled in
+    // without holding the lock
+    frame = &_glfwRecorder.Queue[ slot ];
+    if( frame->Capacity < size )
+    {
+        free( frame->Data );
+        frame->Data = (unsigned char *) malloc( size );
+        frame->Capacity = frame->Data ? size : 0;
+        if( frame->Data == NULL )
+        {
+            _glfwRecorder.Dropped ++;
+            return;
+        }
+    }
+
+    memcpy( frame->Data, img->Data, size );
+    frame->Number = number;
+    frame->Width  = img->Width;
+    frame->Height = img->Height;
+    frame->Time   = time - _glfwRecorder.StartTime;
+
+    glfwLockMutex( _glfwRecorder.Mutex );
+    _glfwRecorder.Count ++;
+    glfwBroadcastCond( _glfwRecorder.Cond );
+    glfwUnlockMutex( _glfwRecorder.Mutex );
+}
+
+
+//************************************************************************
+//****                    GLFW user functions                         ****
+//************************************************************************
+
+//========================================================================
+// Start recording every presented frame to a file
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwStartRecording( const char *name, int flags )
+{
+    unsigned char hdr[ 16 ];
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwWin.opened )
+    {
+        return GL_FALSE;
+    }
+
+    if( _glfwRecorder.Active )
+    {
+        return GL_FALSE;
+    }
+
+    memset( &_glfwRecorder, 0, sizeof(_glfwRecorder) );
+    _glfwRecorder.Flags = flags;
+    _glfwRecorder.Format = _glfwCaptureFormat();
+
+    _glfwRecorder.File = fopen( name, "wb" );
+    if( _glfwRecorder.File == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    memcpy( hdr, "GLFWREC1", 8 );
+    PutUint32( hdr + 8, (unsigned long) _glfwRecorder.Format );
+    PutUint32( hdr + 12, (unsigned long) flags );
+    WriteRecording( hdr, 16 );
+
+    // The writer thread is what keeps recording cheap, so it is required
+    _glfwRecorder.Mutex = glfwCreateMutex();
+    _glfwRecorder.Cond = glfwCreateCond();
+    _glfwRecorder.Thread = -1;
+    if( _glfwRecorder.Mutex && _glfwRecorder.Cond )
+    {
+        _glfwRecorder.Thread = glfwCreateThread( RecorderThread, NULL );
+        glfwSetThreadName( _glfwRecorder.Thread, "glfw-record" );
+    }
+
+    if( _glfwRecorder.Thread < 0 || _glfwRecorder.Error )
+    {
+        if( _glfwRecorder.Mutex )
+        {
+            glfwDestroyMutex( _glfwRecorder.Mutex );
+        }
+        if( _glfwRecorder.Cond )
+        {
+            glfwDestroyCond( _glfwRecorder.Cond );
+        }
+        fclose( _glfwRecorder.File );
+        remove( name );
+        memset( &_glfwRecorder, 0, sizeof(_glfwRecorder) );
+        return GL_FALSE;
+    }
+
+    _glfwRecorder.StartTime = _glfwPlatformGetTime();
+    _glfwRecorder.Active = GL_TRUE;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Stop recording, write out all queued frames and the frame index
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwStopRecording( void )
+{
+    int i;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwRecorder.Active )
+    {
+        return;
+    }
+
+    _glfwRecorder.Active = GL_FALSE;
+
+    // Frames still in the read-back ring belong to the recording
+    if( _glfwCapture.HasPBO && _glfwWin.opened )
+    {
+        _glfwFinishCaptures();
+    }
+
+    glfwLockMutex( _glfwRecorder.Mutex );
+    _glfwRecorder.Quit = GL_TRUE;
+    glfwBroadcastCond( _glfwRecorder.Cond );
+    glfwUnlockMutex( _glfwRecorder.Mutex );
+
+    glfwWaitThread( _glfwRecorder.Thread, GLFW_WAIT );
+
+    glfwDestroyCond( _glfwRecorder.Cond );
+    glfwDestroyMutex( _glfwRecorder.Mutex );
+    _glfwRecorder.Cond = NULL;
+    _glfwRecorder.Mutex = NULL;
+
+    CloseRecording();
+
+    // Free buffers, but keep the counters for glfwGetRecordingStats
+    for( i = 0; i < _GLFW_RECORD_QUEUE_SIZE; i ++ )
+    {
+        free( _glfwRecorder.Queue[ i ].Data );
+        _glfwRecorder.Queue[ i ].Data = NULL;
+        _glfwRecorder.Queue[ i ].Capacity = 0;
+    }
+    free( _glfwRecorder.Previous );
+    free( _glfwRecorder.Packets );
+    free( _glfwRecorder.Index );
+    _glfwRecorder.Previous = NULL;
+    _glfwRecorder.Packets = NULL;
+    _glfwRecorder.Index = NULL;
+}
+
+
+//========================================================================
+// Get recording counters (any pointer may be NULL)
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwGetRecordingStats( int *recorded, int *written, int *dropped )
+{
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return;
+    }
+
+    if( _glfwRecorder.Mutex )
+    {
+        glfwLockMutex( _glfwRecorder.Mutex );
+    }
+
+    if( recorded )
+    {
+        *recorded = _glfwRecorder.Recorded;
+    }
+    if( written )
+    {
+        *written = _glfwRecorder.Written;
+    }
+    if( dropped )
+    {
+        *dropped = _glfwRecorder.Dropped;
+    }
+
+    if( _glfwRecorder.Mutex )
+    {
+        glfwUnlockMutex( _glfwRecorder.Mutex );
+    }
+}
@@ -0,0 +1,822 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Any
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+//========================================================================
+// Description:
+//
+// This module reloads images when their files change on disk, so that
+// textures can be updated while an application is running. Once
+// GLFW_TEXTURE_HOT_RELOAD is enabled, every file read by glfwReadImage or
+// glfwLoadTexture2D is watched (images from pack files are not) until
+// glfwUnwatchImage or glfwForgetTexture is called for it. A
+// background thread waits for changes from the platform file system
+// watcher, or polls the modification times where there is none, and
+// decodes a changed file after it has been quiet for a short while, so
+// that an editor writing a file in several steps only causes one reload.
+// The decoded images are handed to the main thread by
+// glfwPollImageReload and glfwReloadTextures.
+//
+//========================================================================
+
+#include "internal.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+
+// Seconds a changed file must be left alone before it is decoded
+#define _GLFW_RELOAD_QUIET_TIME     0.1
+
+// Seconds between checks for changes
+#define _GLFW_RELOAD_INTERVAL       0.05
+
+// Seconds between modification time checks of polled files
+#define _GLFW_RELOAD_POLL_INTERVAL  0.25
+
+
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+//========================================================================
+// Read the modification time and size of a file
+//========================================================================
+
+static int GetFileState( const char *path, long *modtime, long *size )
+{
+    struct stat st;
+
+    if( stat( path, &st ) != 0 )
+    {
+        return GL_FALSE;
+    }
+
+    *modtime = (long) st.st_mtime;
+    *size = (long) st.st_size;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Mark a watched file as changed (called with the mutex locked)
+//========================================================================
+
+static void MarkChanged( _GLFWwatch *watch )
+{
+    watch->Dirty = GL_TRUE;
+    watch->ChangeTime = _glfwPlatformGetTime();
+}
+
+
+//========================================================================
+// Handle a change reported by the platform watcher
+//========================================================================
+
+static void WatcherCallback( int directory, const char *name )
+{
+    _GLFWwatch *watch;
+
+    glfwLockMutex( _glfwReload.Mutex );
+
+    for( watch = _glfwReload.FirstWatch;  watch;  watch = watch->Next )
+    {
+        if( watch->Directory == directory && strcmp( watch->File, name ) == 0 )
+        {
+            MarkChanged( watch );
+        }
+    }
+
+    glfwUnlockMutex( _glfwReload.Mutex );
+}
+
+
+//========================================================================
+// Check the modification times of watches that have no directory watch
+//========================================================================
+
+static void PollFiles( void )
+{
+    _GLFWwatch *watch;
+    long modtime, size;
+
+    glfwLockMutex( _glfwReload.Mutex );
+
+    for( watch = _glfwReload.FirstWatch;  watch;  watch = watch->Next )
+    {
+        if( watch->Directory >= 0 )
+        {
+            continue;
+        }
+
+        if( !GetFileState( watch->Path, &modtime, &size ) )
+        {
+            // The file may be in the middle of being replaced
+            continue;
+        }
+
+        if( modtime != watch->ModTime || size != watch->Size )
+        {
+            watch->ModTime = modtime;
+            watch->Size = size;
+            MarkChanged( watch );
+        }
+    }
+
+    glfwUnlockMutex( _glfwReload.Mutex );
+}
+
+
+//========================================================================
+// Find a watch by ID (called with the mutex locked)
+//========================================================================
+
+static _GLFWwatch *FindWatch( int id )
+{
+    _GLFWwatch *watch;
+
+    for( watch = _glfwReload.FirstWatch;  watch;  watch = watch->Next )
+    {
+        if( watch->ID == id )
+        {
+            return watch;
+        }
+    }
+
+    return NULL;
+}
+
+
+//========================================================================
+// Free a decoded image
+//========================================================================
+
+static void FreeResult( _GLFWreload *result )
+{
+    glfwFreeImage( &result->Image );
+    free( result->Path );
+    free( result );
+}
+
+
+//========================================================================
+// Queue a decoded image, replacing an older one for the same file and
+// texture that has not been picked up yet (called with the mutex locked)
+//========================================================================
+
+static void AppendResult( _GLFWreload *result )
+{
+    _GLFWreload **prev, *old;
+
+    prev = &_glfwReload.FirstResult;
+    _glfwReload.LastResult = NULL;
+
+    while( *prev )
+    {
+        old = *prev;
+        if( old->Texture == result->Texture &&
+            strcmp( old->Path, result->Path ) == 0 )
+        {
+            *prev = old->Next;
+            FreeResult( old );
+            continue;
+        }
+
+        _glfwReload.LastResult = old;
+        prev = &old->Next;
+    }
+
+    result->Next = NULL;
+    *prev = result;
+    _glfwReload.LastResult = result;
+}
+
+
+//========================================================================
+// Decode one changed file that has been quiet for long enough. Returns
+// GL_FALSE if there was none.
+//========================================================================
+
+static int DecodeChangedFile( void )
+{
+    _GLFWwatch *watch;
+    _GLFWreload *result;
+    double now;
+    int id;
+
+    result = (_GLFWreload *) malloc( sizeof(_GLFWreload) );
+    if( result == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    now = _glfwPlatformGetTime();
+
+    glfwLockMutex( _glfwReload.Mutex );
+
+    for( watch = _glfwReload.FirstWatch;  watch;  watch = watch->Next )
+    {
+        if( watch->Dirty && now - watch->ChangeTime >= _GLFW_RELOAD_QUIET_TIME )
+        {
+            break;
+        }
+    }
+
+    if( watch )
+    {
+        watch->Dirty = GL_FALSE;
+        id = watch->ID;
+        result->Path = (char *) malloc( strlen( watch->Path ) + 1 );
+        if( result->Path )
+        {
+            strcpy( result->Path, watch->Path );
+        }
+        result->Flags = watch->Flags;
+        result->Texture = watch->Texture;
+    }
+
+    glfwUnlockMutex( _glfwReload.Mutex );
+
+    if( watch == NULL || result->Path == NULL )
+    {
+        free( result );
+        return watch != NULL;
+    }
+
+    // A file that cannot be read yet is most likely still being written,
+    // in which case there will be another change soon
+    if( !_glfwReadImageFile( result->Path, &result->Image, result->Flags ) )
+    {
+        free( result->Path );
+        free( result );
+        return GL_TRUE;
+    }
+
+    glfwLockMutex( _glfwReload.Mutex );
+
+    // The watch may have been removed while the file was decoded
+    if( FindWatch( id ) )
+    {
+        AppendResult( result );
+        result = NULL;
+    }
+
+    glfwUnlockMutex( _glfwReload.Mutex );
+
+    if( result )
+    {
+        FreeResult( result );
+    }
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Watcher thread
+//========================================================================
+
+static void GLFWCALL ReloadThread( void *arg )
+{
+    double now;
+    int quit;
+
+    (void) arg;
+
+    for( ;; )
+    {
+        glfwLockMutex( _glfwReload.Mutex );
+        quit = _glfwReload.Quit;
+        glfwUnlockMutex( _glfwReload.Mutex );
+
+        if( quit )
+        {
+            break;
+        }
+
+        // Wait for changes, or just for a while if we have to poll
+        if( _glfwReload.Watcher < 0 ||
+            _glfwPlatformWaitWatcher( _glfwReload.Watcher,
+                                      _GLFW_RELOAD_INTERVAL,
+                                      WatcherCallback ) < 0 )
+        {
+            _glfwPlatformSleep( _GLFW_RELOAD_INTERVAL );
+        }
+
+        now = _glfwPlatformGetTime();
+        if( now - _glfwReload.PollTime >= _GLFW_RELOAD_POLL_INTERVAL )
+        {
+            _glfwReload.PollTime = now;
+            PollFiles();
+        }
+
+        while( DecodeChangedFile() )
+        {
+        }
+    }
+}
+
+
+//========================================================================
+// Check whether a watch or result is for the given texture (or for any
+// texture if texture is zero), or for the given file read by
+// glfwReadImage if path is not NULL
+//========================================================================
+
+static int IsWatchedBy( GLuint watchTexture, const char *watchPath,
+                        GLuint texture, const char *path )
+{
+    if( path )
+    {
+        return !watchTexture && strcmp( watchPath, path ) == 0;
+    }
+
+    return watchTexture && ( !texture || watchTexture == texture );
+}
+
+
+//========================================================================
+// Remove watches, and the images they have decoded that have not been
+// picked up yet, as selected by IsWatchedBy
+//========================================================================
+
+static void RemoveWatches( GLuint texture, const char *path )
+{
+    _GLFWwatch **prevWatch, *watch;
+    _GLFWreload **prevResult, *result;
+
+    glfwLockMutex( _glfwReload.Mutex );
+
+    prevWatch = &_glfwReload.FirstWatch;
+    while( *prevWatch )
+    {
+        watch = *prevWatch;
+        if( IsWatchedBy( watch->Texture, watch->Path, texture, path ) )
+        {
+            *prevWatch = watch->Next;
+            free( watch->Path );
+            free( watch );
+            continue;
+        }
+
+        prevWatch = &watch->Next;
+    }
+
+    prevResult = &_glfwReload.FirstResult;
+    _glfwReload.LastResult = NULL;
+    while( *prevResult )
+    {
+        result = *prevResult;
+        if( IsWatchedBy( result->Texture, result->Path, texture, path ) )
+        {
+            *prevResult = result->Next;
+            FreeResult( result );
+            continue;
+        }
+
+        _glfwReload.LastResult = result;
+        prevResult = &result->Next;
+    }
+
+    glfwUnlockMutex( _glfwReload.Mutex );
+}
+
+
+//========================================================================
+// Start watching an image file that was just read
+//========================================================================
+
+void _glfwWatchImage( const char *name, int flags, GLuint texture )
+{
+    _GLFWwatch *watch, *old;
+    char *directory;
+    const char *file;
+#ifdef _WIN32
+    const char *separator;
+#endif
+
+    // Images may be read on any thread. The mutex is kept until GLFW is
+    // terminated, so it can be used to check whether watching is on.
+    if( !_glfwReload.Mutex )
+    {
+        return;
+    }
+
+    watch = (_GLFWwatch *) malloc( sizeof(_GLFWwatch) );
+    if( watch == NULL )
+    {
+        return;
+    }
+
+    memset( watch, 0, sizeof(_GLFWwatch) );
+    watch->Path = (char *) malloc( strlen( name ) + 1 );
+    directory = (char *) malloc( strlen( name ) + 2 );
+    if( watch->Path == NULL || directory == NULL )
+    {
+        free( watch->Path );
+        free( directory );
+        free( watch );
+        return;
+    }
+
+    strcpy( watch->Path, name );
+    watch->Flags = flags;
+    watch->Texture = texture;
+
+    // Changes are reported for directories, as files are often replaced
+    // rather than rewritten
+    file = strrchr( watch->Path, '/' );
+#ifdef _WIN32
+    separator = strrchr( watch->Path, '\\' );
+    if( separator && ( file == NULL || separator > file ) )
+    {
+        file = separator;
+    }
+#endif
+    if( file )
+    {
+        watch->File = file + 1;
+        strncpy( directory, watch->Path, file - watch->Path + 1 );
+        directory[ file - watch->Path + 1 ] = '\0';
+    }
+    else
+    {
+        watch->File = watch->Path;
+        strcpy( directory, "." );
+    }
+
+    // The check for an existing watch and the insertion are done under
+    // the same lock, so that threads reading the same file at once do not
+    // both add a watch
+    glfwLockMutex( _glfwReload.Mutex );
+
+    old = NULL;
+    if( _glfwReload.Active )
+    {
+        // A file that is read again for the same texture only gets new
+        // flags
+        for( old = _glfwReload.FirstWatch;  old;  old = old->Next )
+        {
+            if( old->Texture == texture && strcmp( old->Path, name ) == 0 )
+            {
+                old->Flags = flags;
+                break;
+            }
+        }
+    }
+
+    if( !_glfwReload.Active || old )
+    {
+        glfwUnlockMutex( _glfwReload.Mutex );
+        free( watch->Path );
+        free( watch );
+        free( directory );
+        return;
+    }
+
+    watch->Directory = -1;
+    if( _glfwReload.Watcher >= 0 )
+    {
+        watch->Directory = _glfwPlatformWatchDirectory( _glfwReload.Watcher,
+                                                        directory );
+    }
+
+    GetFileState( watch->Path, &watch->ModTime, &watch->Size );
+
+    watch->ID = ++ _glfwReload.NextID;
+    watch->Next = _glfwReload.FirstWatch;
+    _glfwReload.FirstWatch = watch;
+
+    glfwUnlockMutex( _glfwReload.Mutex );
+
+    free( directory );
+}
+
+
+//========================================================================
+// Stop watching files for a texture (called by glfwForgetTexture)
+//========================================================================
+
+void _glfwUnwatchTexture( GLuint texture )
+{
+    if( !_glfwReload.Active || !texture )
+    {
+        return;
+    }
+
+    RemoveWatches( texture, NULL );
+}
+
+
+//========================================================================
+// Stop watching files for all textures (called when the OpenGL context
+// goes away)
+//========================================================================
+
+void _glfwUnwatchTextures( void )
+{
+    if( !_glfwReload.Active )
+    {
+        return;
+    }
+
+    RemoveWatches( 0, NULL );
+}
+
+
+//========================================================================
+// Start the watcher thread (glfwEnable)
+//========================================================================
+
+void _glfwStartHotReload( void )
+{
+    if( _glfwReload.Active )
+    {
+        return;
+    }
+
+    // The mutex is created once and kept until glfwTerminate, as other
+    // threads reading images may be using it at any time
+    if( !_glfwReload.Mutex )
+    {
+        _glfwReload.Mutex = glfwCreateMutex();
+        if( !_glfwReload.Mutex )
+        {
+            return;
+        }
+    }
+
+    glfwLockMutex( _glfwReload.Mutex );
+    _glfwReload.Quit = GL_FALSE;
+    _glfwReload.NextID = 0;
+    _glfwReload.PollTime = _glfwPlatformGetTime();
+    _glfwReload.Watcher = _glfwPlatformCreateWatcher();
+    glfwUnlockMutex( _glfwReload.Mutex );
+
+    _glfwReload.Thread = glfwCreateThread( ReloadThread, NULL );
+    if( _glfwReload.Thread < 0 )
+    {
+        if( _glfwReload.Watcher >= 0 )
+        {
+            _glfwPlatformDestroyWatcher( _glfwReload.Watcher );
+        }
+        _glfwReload.Watcher = -1;
+        return;
+    }
+
+    glfwSetThreadName( _glfwReload.Thread, "glfw-reload" );
+
+    glfwLockMutex( _glfwReload.Mutex );
+    _glfwReload.Active = GL_TRUE;
+    glfwUnlockMutex( _glfwReload.Mutex );
+}
+
+
+//========================================================================
+// Stop the watcher thread and forget all watches (glfwDisable)
+//========================================================================
+
+void _glfwStopHotReload( void )
+{
+    _GLFWwatch *watch;
+    _GLFWreload *result;
+
+    if( !_glfwReload.Active )
+    {
+        return;
+    }
+
+    // No watches are added once Active is cleared
+    glfwLockMutex( _glfwReload.Mutex );
+    _glfwReload.Active = GL_FALSE;
+    _glfwReload.Quit = GL_TRUE;
+    glfwUnlockMutex( _glfwReload.Mutex );
+
+    glfwWaitThread( _glfwReload.Thread, GLFW_WAIT );
+    _glfwReload.Thread = -1;
+
+    glfwLockMutex( _glfwReload.Mutex );
+
+    if( _glfwReload.Watcher >= 0 )
+    {
+        _glfwPlatformDestroyWatcher( _glfwReload.Watcher );
+    }
+    _glfwReload.Watcher = -1;
+
+    while( _glfwReload.FirstWatch )
+    {
+        watch = _glfwReload.FirstWatch;
+        _glfwReload.FirstWatch = watch->Next;
+        free( watch->Path );
+        free( watch );
+    }
+
+    while( _glfwReload.FirstResult )
+    {
+        result = _glfwReload.FirstResult;
+        _glfwReload.FirstResult = result->Next;
+        FreeResult( result );
+    }
+    _glfwReload.LastResult = NULL;
+
+    free( _glfwReload.PolledPath );
+    _glfwReload.PolledPath = NULL;
+
+    glfwUnlockMutex( _glfwReload.Mutex );
+}
+
+
+//========================================================================
+// Stop the watcher thread and destroy the mutex (glfwTerminate)
+//========================================================================
+
+void _glfwTerminateHotReload( void )
+{
+    _glfwStopHotReload();
+
+    if( _glfwReload.Mutex )
+    {
+        glfwDestroyMutex( _glfwReload.Mutex );
+        _glfwReload.Mutex = NULL;
+    }
+}
+
+
+
+//************************************************************************
+//****                    GLFW user functions                         ****
+//************************************************************************
+
+//========================================================================
+// Get the next reloaded image. The image belongs to the caller, and the
+// name is valid until the next call.
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwPollImageReload( GLFWimage *img,
+    const char **name, GLuint *texture )
+{
+    _GLFWreload *result;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwReload.Active )
+    {
+        return GL_FALSE;
+    }
+
+    glfwLockMutex( _glfwReload.Mutex );
+
+    result = _glfwReload.FirstResult;
+    if( result )
+    {
+        _glfwReload.FirstResult = result->Next;
+        if( _glfwReload.FirstResult == NULL )
+        {
+            _glfwReload.LastResult = NULL;
+        }
+    }
+
+    glfwUnlockMutex( _glfwReload.Mutex );
+
+    if( result == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    free( _glfwReload.PolledPath );
+    _glfwReload.PolledPath = result->Path;
+
+    *img = result->Image;
+    if( name )
+    {
+        *name = result->Path;
+    }
+    if( texture )
+    {
+        *texture = result->Texture;
+    }
+
+    free( result );
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Upload all reloaded images that belong to textures. Returns the number
+// of textures that were updated.
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwReloadTextures( void )
+{
+    _GLFWreload **prev, *result, *ready, *next;
+    GLint binding;
+    int count;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwWin.opened || !_glfwReload.Active )
+    {
+        return 0;
+    }
+
+    // Take the texture images out of the queue, leaving the rest to
+    // glfwPollImageReload
+    ready = NULL;
+
+    glfwLockMutex( _glfwReload.Mutex );
+
+    prev = &_glfwReload.FirstResult;
+    _glfwReload.LastResult = NULL;
+    while( *prev )
+    {
+        result = *prev;
+        if( result->Texture )
+        {
+            *prev = result->Next;
+            result->Next = ready;
+            ready = result;
+            continue;
+        }
+
+        _glfwReload.LastResult = result;
+        prev = &result->Next;
+    }
+
+    glfwUnlockMutex( _glfwReload.Mutex );
+
+    if( ready == NULL )
+    {
+        return 0;
+    }
+
+    glGetIntegerv( GL_TEXTURE_BINDING_2D, &binding );
+
+    count = 0;
+    for( result = ready;  result;  result = next )
+    {
+        next = result->Next;
+
+        // The application may have deleted the texture
+        if( glIsTexture( result->Texture ) )
+        {
+            glBindTexture( GL_TEXTURE_2D, result->Texture );
+            if( glfwLoadTextureImage2D( &result->Image, result->Flags ) )
+            {
+                count ++;
+            }
+        }
+        else
+        {
+            _glfwUnwatchTexture( result->Texture );
+        }
+
+        FreeResult( result );
+    }
+
+    glBindTexture( GL_TEXTURE_2D, (GLuint) binding );
+
+    return count;
+}
+
+
+//========================================================================
+// Stop watching a file read by glfwReadImage, and drop any reloaded
+// images of it that have not been polled yet
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwUnwatchImage( const char *name )
+{
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwReload.Active || !name )
+    {
+        return;
+    }
+
+    RemoveWatches( 0, name );
+}
@@ -0,0 +1,401 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Any
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+//========================================================================
+// Description:
+//
+// This module resizes images with a separable filter: rows are resampled
+// horizontally into a temporary buffer, which is then resampled
+// vertically. For each output column (and row) the filter is evaluated
+// once up front, giving a table of source positions and fixed-point
+// weights, so the inner loops are plain integer multiply-adds over
+// contiguous memory that compilers can vectorize.
+//
+// When shrinking, the filter is widened by the scale factor so that every
+// source pixel contributes (no aliasing). Source pixels beyond the image
+// edges are clamped to the edge: horizontally by padding each source row
+// with copies of its edge pixels, vertically by clamping the row index of
+// each tap.
+//
+//========================================================================
+
+#include "internal.h"
+
+#include <math.h>
+
+
+// Fractional bits of the filter weights
+#define _GLFW_WEIGHT_BITS   14
+#define _GLFW_WEIGHT_ONE    (1 << _GLFW_WEIGHT_BITS)
+
+// Fractional bits kept between the two passes
+#define _GLFW_PASS_BITS     7
+
+#ifndef M_PI
+ #define M_PI 3.14159265358979323846
+#endif
+
+
+//------------------------------------------------------------------------
+// Precomputed filter for one direction
+//------------------------------------------------------------------------
+typedef struct {
+    int     Taps;           // Weights per output pixel
+    int    *First;          // First source pixel for each output pixel
+    int    *Weights;        // Taps weights for each output pixel
+} _GLFWfiltertable;
+
+
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+//========================================================================
+// Filter kernels
+//========================================================================
+
+static double BoxKernel( double x )
+{
+    return ( x >= -0.5 && x < 0.5 ) ? 1.0 : 0.0;
+}
+
+static double TriangleKernel( double x )
+{
+    x = fabs( x );
+    return x < 1.0 ? 1.0 - x : 0.0;
+}
+
+static double LanczosKernel( double x )
+{
+    x = fabs( x );
+    if( x < 1e-8 )
+    {
+        return 1.0;
+    }
+    if( x >= 3.0 )
+    {
+        return 0.0;
+    }
+
+    return 3.0 * sin( M_PI * x ) * sin( M_PI * x / 3.0 ) / ( M_PI * M_PI * x * x );
+}
+
+
+//========================================================================
+// Free a filter table
+//========================================================================
+
+static void FreeFilterTable( _GLFWfiltertable *table )
+{
+    free( table->First );
+    free( table->Weights );
+}
+
+
+//========================================================================
+// Compute the filter table for resampling srcSize pixels to dstSize
+//========================================================================
+
+static int BuildFilterTable( _GLFWfiltertable *table, int srcSize,
+    int dstSize, int filter )
+{
+    double (*kernel)( double );
+    double radius, scale, support, center, sum, *weights;
+    int i, j, first, total, largest;
+    int *w;
+
+    switch( filter )
+    {
+        case GLFW_BOX_FILTER:
+            kernel = BoxKernel;
+            radius = 0.5;
+            break;
+        case GLFW_TRIANGLE_FILTER:
+            kernel = TriangleKernel;
+            radius = 1.0;
+            break;
+        case GLFW_LANCZOS_FILTER:
+            kernel = LanczosKernel;
+            radius = 3.0;
+            break;
+        default:
+            return GL_FALSE;
+    }
+
+    // Widen the kernel when shrinking
+    scale = (double) dstSize / (double) srcSize;
+    if( scale > 1.0 )
+    {
+        scale = 1.0;
+    }
+    support = radius / scale;
+
+    table->Taps = (int) ceil( support * 2.0 ) + 1;
+    table->First = (int *) malloc( dstSize * sizeof(int) );
+    table->Weights = (int *) malloc( dstSize * table->Taps * sizeof(int) );
+    weights = (double *) malloc( table->Taps * sizeof(double) );
+    if( table->First == NULL || table->Weights == NULL || weights == NULL )
+    {
+        FreeFilterTable( table );
+        free( weights );
+        return GL_FALSE;
+    }
+
+    for( i = 0; i < dstSize; i ++ )
+    {
+        // Center of the output pixel in source pixel coordinates
+        center = ( i + 0.5 ) * srcSize / dstSize - 0.5;
+        first = (int) ceil( center - support - 1e-9 );
+
+        sum = 0.0;
+        for( j = 0; j < table->Taps; j ++ )
+        {
+            weights[ j ] = kernel( ( first + j - center ) * scale );
+            sum += weights[ j ];
+        }
+
+        // Normalize to fixed point, giving any rounding error to the
+        // largest weight so that flat areas stay flat
+        w = table->Weights + i * table->Taps;
+        total = 0;
+        largest = 0;
+        for( j = 0; j < table->Taps; j ++ )
+        {
+            w[ j ] = (int) floor( weights[ j ] / sum * _GLFW_WEIGHT_ONE + 0.5 );
+            total += w[ j ];
+            if( w[ j ] > w[ largest ] )
+            {
+                largest = j;
+            }
+        }
+        w[ largest ] += _GLFW_WEIGHT_ONE - total;
+
+        table->First[ i ] = first;
+    }
+
+    free( weights );
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Clamp a source position to the image
+//========================================================================
+
+static int ClampIndex( int i, int size )
+{
+    return i < 0 ? 0 : ( i >= size ? size - 1 : i );
+}
+
+
+//========================================================================
+// Resample rows horizontally into the (wider, fixed-point) temporary
+// buffer. Each row is first copied into a buffer padded with copies of
+// its edge pixels, so that the taps of every output pixel read one
+// contiguous span without any clamping.
+//========================================================================
+
+static void ResampleRows( const unsigned char *src, int srcWidth,
+    int height, int srcStride, int *dst, int dstWidth, int bpp,
+    const _GLFWfiltertable *table, unsigned char *padded, int before,
+    int after )
+{
+    const unsigned char *p;
+    const int *w;
+    int x, y, i, j, k, *out;
+    int sum[ 4 ];
+
+    const int rowsize = srcWidth * bpp;
+    const int span = table->Taps * bpp;
+    const int shift = _GLFW_WEIGHT_BITS - _GLFW_PASS_BITS;
+
+    for( y = 0; y < height; y ++ )
+    {
+        memcpy( padded + before * bpp, src + y * srcStride, rowsize );
+        for( i = 0; i < before; i ++ )
+        {
+            memcpy( padded + i * bpp, padded + before * bpp, bpp );
+        }
+        for( i = 0; i < after; i ++ )
+        {
+            memcpy( padded + before * bpp + rowsize + i * bpp,
+                    padded + before * bpp + rowsize - bpp, bpp );
+        }
+
+        out = dst + y * dstWidth * bpp;
+
+        for( x = 0; x < dstWidth; x ++ )
+        {
+            p = padded + ( table->First[ x ] + before ) * bpp;
+            w = table->Weights + x * table->Taps;
+
+            for( k = 0; k < bpp; k ++ )
+            {
+                sum[ k ] = 1 << ( shift - 1 );
+            }
+
+            for( j = 0, i = 0; i < span; j ++, i += bpp )
+            {
+                for( k = 0; k < bpp; k ++ )
+                {
+                    sum[ k ] += w[ j ] * p[ i + k ];
+                }
+            }
+
+            for( k = 0; k < bpp; k ++ )
+            {
+                *out ++ = sum[ k ] >> shift;
+            }
+        }
+    }
+}
+
+
+//========================================================================
+// Resample the temporary buffer vertically into the destination
+//========================================================================
+
+static void ResampleColumns( const int *src, int srcHeight, int width,
+    unsigned char *dst, int dstHeight, int dstStride, int *accum,
+    const _GLFWfiltertable *table )
+{
+    const int *row;
+    const int *w;
+    int x, y, j, value, weight;
+    unsigned char *out;
+
+    const int shift = _GLFW_WEIGHT_BITS + _GLFW_PASS_BITS;
+
+    for( y = 0; y < dstHeight; y ++ )
+    {
+        w = table->Weights + y * table->Taps;
+
+        // Accumulate whole source rows, which keeps the inner loop
+        // running over contiguous memory
+        for( x = 0; x < width; x ++ )
+        {
+            accum[ x ] = 1 << ( shift - 1 );
+        }
+
+        for( j = 0; j < table->Taps; j ++ )
+        {
+            weight = w[ j ];
+            if( weight == 0 )
+            {
+                continue;
+            }
+
+            row = src + ClampIndex( table->First[ y ] + j, srcHeight ) * width;
+            for( x = 0; x < width; x ++ )
+            {
+                accum[ x ] += weight * row[ x ];
+            }
+        }
+
+        out = dst + y * dstStride;
+        for( x = 0; x < width; x ++ )
+        {
+            value = accum[ x ] >> shift;
+            out[ x ] = (unsigned char) ( value < 0 ? 0 :
+                                         ( value > 255 ? 255 : value ) );
+        }
+    }
+}
+
+
+//========================================================================
+// Resize pixel data with the given filter
+//========================================================================
+
+int _glfwResampleImage( const unsigned char *src, int srcWidth,
+    int srcHeight, int srcStride, unsigned char *dst, int dstWidth,
+    int dstHeight, int dstStride, int bpp, int filter )
+{
+    _GLFWfiltertable horizontal, vertical;
+    int *temp, *accum, before, after;
+    unsigned char *padded;
+
+    // The horizontal pass keeps one accumulator per component
+    if( bpp < 1 || bpp > 4 )
+    {
+        return GL_FALSE;
+    }
+
+    if( !BuildFilterTable( &horizontal, srcWidth, dstWidth, filter ) )
+    {
+        return GL_FALSE;
+    }
+
+    if( !BuildFilterTable( &vertical, srcHeight, dstHeight, filter ) )
+    {
+        FreeFilterTable( &horizontal );
+        return GL_FALSE;
+    }
+
+    // Source pixels that the horizontal taps reach beyond each edge (the
+    // first positions only ever increase)
+    before = -horizontal.First[ 0 ];
+    if( before < 0 )
+    {
+        before = 0;
+    }
+    after = horizontal.First[ dstWidth - 1 ] + horizontal.Taps - srcWidth;
+    if( after < 0 )
+    {
+        after = 0;
+    }
+
+    temp = (int *) malloc( dstWidth * srcHeight * bpp * sizeof(int) );
+    accum = (int *) malloc( dstWidth * bpp * sizeof(int) );
+    padded = (unsigned char *) malloc( ( before + srcWidth + after ) * bpp );
+    if( temp == NULL || accum == NULL || padded == NULL )
+    {
+        free( temp );
+        free( accum );
+        free( padded );
+        FreeFilterTable( &horizontal );
+        FreeFilterTable( &vertical );
+        return GL_FALSE;
+    }
+
+    ResampleRows( src, srcWidth, srcHeight, srcStride, temp, dstWidth, bpp,
+                  &horizontal, padded, before, after );
+    ResampleColumns( temp, srcHeight, dstWidth * bpp, dst, dstHeight,
+                     dstStride, accum, &vertical );
+
+    free( temp );
+    free( accum );
+    free( padded );
+    FreeFilterTable( &horizontal );
+    FreeFilterTable( &vertical );
+
+    return GL_TRUE;
+}
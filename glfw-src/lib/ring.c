@@ -0,0 +1,527 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Any
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+
+//========================================================================
+// Description:
+//
+// This module implements a bounded ring buffer for passing fixed size
+// elements from exactly one producer thread to exactly one consumer
+// thread without locking. The producer only writes the tail index and
+// the consumer only writes the head index; each lives on its own cache
+// line together with a private copy of the other index, which is only
+// refreshed when the ring looks full (or empty), so the two threads do
+// not fight over the same cache lines while there is room to work.
+//
+// The blocking glfwPushRing and glfwPopRing wait on a condition variable
+// only once the ring is actually full or empty. A thread that is about to
+// wait raises a flag before checking the ring a last time, and the other
+// side only takes the ring mutex if it is the one to clear that flag, so
+// rings that never block never touch the mutex and each wait costs at
+// most one wakeup.
+//
+//========================================================================
+
+#include "internal.h"
+
+
+// Size of the padding that keeps the indices on separate cache lines
+#define _GLFW_CACHE_LINE_SIZE 64
+
+
+//------------------------------------------------------------------------
+// Ring buffer
+//------------------------------------------------------------------------
+typedef struct {
+    char                  Pad0[ _GLFW_CACHE_LINE_SIZE ];
+
+    // Consumer side: next element to pop and last seen tail
+    volatile unsigned int Head;
+    unsigned int          CachedTail;
+    char                  Pad1[ _GLFW_CACHE_LINE_SIZE ];
+
+    // Producer side: next free element and last seen head
+    volatile unsigned int Tail;
+    unsigned int          CachedHead;
+    char                  Pad2[ _GLFW_CACHE_LINE_SIZE ];
+
+    // Element size in bytes, capacity (a power of two) and elements
+    int                   Size;
+    unsigned int          Capacity;
+    unsigned char         *Data;
+
+    // Parking of a blocked producer or consumer (Waiting is GL_TRUE while
+    // one of them may be about to sleep)
+    GLFWmutex             Lock;
+    GLFWcond              Cond;
+    volatile int          Waiting;
+} _GLFWring;
+
+
+
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+//========================================================================
+// Read an index written by the other thread, ordering it before any
+// following reads of the elements
+//========================================================================
+
+static unsigned int LoadAcquire( volatile unsigned int *index )
+{
+#if defined(__ATOMIC_ACQUIRE)
+    return __atomic_load_n( index, __ATOMIC_ACQUIRE );
+#else
+    unsigned int value = *index;
+    _glfwPlatformMemoryBarrier();
+    return value;
+#endif
+}
+
+
+//========================================================================
+// Publish an index, ordering it after any preceding accesses to the
+// elements
+//========================================================================
+
+static void StoreRelease( volatile unsigned int *index, unsigned int value )
+{
+#if defined(__ATOMIC_RELEASE)
+    __atomic_store_n( index, value, __ATOMIC_RELEASE );
+#else
+    _glfwPlatformMemoryBarrier();
+    *index = value;
+#endif
+}
+
+
+//========================================================================
+// Wake the other side if it is waiting for the ring to change
+//========================================================================
+
+static void WakeRing( _GLFWring *ring )
+{
+    // The index store must be visible before the flag is read, or a
+    // thread that is just about to wait could miss it
+    _glfwPlatformMemoryBarrier();
+
+    if( ring->Waiting &&
+        _glfwPlatformAtomicCompareAndSwap( &ring->Waiting, GL_TRUE, GL_FALSE ) )
+    {
+        _glfwPlatformLockMutex( ring->Lock );
+        _glfwPlatformBroadcastCond( ring->Cond );
+        _glfwPlatformUnlockMutex( ring->Lock );
+    }
+}
+
+
+//========================================================================
+// Push up to count elements, returning the number pushed (the caller
+// wakes the consumer)
+//========================================================================
+
+static int PushElements( _GLFWring *ring, const unsigned char *elements,
+                         int count )
+{
+    unsigned int tail, index, first;
+    int available;
+
+    tail = ring->Tail;
+    available = (int) (ring->Capacity - (tail - ring->CachedHead));
+    if( available < count )
+    {
+        ring->CachedHead = LoadAcquire( &ring->Head );
+        available = (int) (ring->Capacity - (tail - ring->CachedHead));
+    }
+
+    if( count > available )
+    {
+        count = available;
+    }
+    if( count <= 0 )
+    {
+        return 0;
+    }
+
+    // Copy in at most two pieces, as the elements may wrap around
+    index = tail & (ring->Capacity - 1);
+    first = ring->Capacity - index;
+    if( first > (unsigned int) count )
+    {
+        first = (unsigned int) count;
+    }
+
+    memcpy( ring->Data + index * ring->Size, elements, first * ring->Size );
+    memcpy( ring->Data, elements + first * ring->Size,
+            (count - first) * ring->Size );
+
+    StoreRelease( &ring->Tail, tail + count );
+
+    return count;
+}
+
+
+//========================================================================
+// Pop up to count elements, returning the number popped (the caller
+// wakes the producer)
+//========================================================================
+
+static int PopElements( _GLFWring *ring, unsigned char *elements,
+                        int count )
+{
+    unsigned int head, index, first;
+    int available;
+
+    head = ring->Head;
+    available = (int) (ring->CachedTail - head);
+    if( available < count )
+    {
+        ring->CachedTail = LoadAcquire( &ring->Tail );
+        available = (int) (ring->CachedTail - head);
+    }
+
+    if( count > available )
+    {
+        count = available;
+    }
+    if( count <= 0 )
+    {
+        return 0;
+    }
+
+    index = head & (ring->Capacity - 1);
+    first = ring->Capacity - index;
+    if( first > (unsigned int) count )
+    {
+        first = (unsigned int) count;
+    }
+
+    memcpy( elements, ring->Data + index * ring->Size, first * ring->Size );
+    memcpy( elements + first * ring->Size, ring->Data,
+            (count - first) * ring->Size );
+
+    StoreRelease( &ring->Head, head + count );
+
+    return count;
+}
+
+
+//========================================================================
+// Wait until an element has been pushed or popped, or the timeout has
+// passed. The transfer is retried after raising the flag, so that a
+// change made just before that is not missed
+//========================================================================
+
+static int WaitRing( _GLFWring *ring, void *element, int push,
+                     double timeout )
+{
+    double deadline = GLFW_INFINITY;
+    int result;
+
+    if( timeout < GLFW_INFINITY )
+    {
+        deadline = _glfwPlatformGetTime() + timeout;
+    }
+
+    _glfwPlatformLockMutex( ring->Lock );
+
+    for( ;; )
+    {
+        // The flag is cleared by every wakeup, so raise it again
+        ring->Waiting = GL_TRUE;
+        _glfwPlatformMemoryBarrier();
+
+        if( push )
+        {
+            result = PushElements( ring, (const unsigned char *) element, 1 );
+        }
+        else
+        {
+            result = PopElements( ring, (unsigned char *) element, 1 );
+        }
+
+        if( result || _glfwPlatformGetTime() >= deadline )
+        {
+            break;
+        }
+
+        _glfwPlatformWaitCondUntil( ring->Cond, ring->Lock, deadline );
+    }
+
+    // The flag is left raised, as the other side may have started waiting
+    // since it was raised here; that costs at most one needless wakeup
+    _glfwPlatformUnlockMutex( ring->Lock );
+
+    if( !result )
+    {
+        return GL_FALSE;
+    }
+
+    WakeRing( ring );
+    return GL_TRUE;
+}
+
+
+
+//************************************************************************
+//****                    GLFW user functions                         ****
+//************************************************************************
+
+//========================================================================
+// Create a ring buffer for elements of the given size in bytes. The
+// capacity is rounded up to a power of two
+//========================================================================
+
+GLFWAPI GLFWring GLFWAPIENTRY glfwCreateRing( int size, int capacity )
+{
+    _GLFWring *ring;
+    unsigned int actual;
+
+    if( !_glfwInitialized || size <= 0 || capacity <= 0 ||
+        capacity > (1 << 30) )
+    {
+        return NULL;
+    }
+
+    actual = 1;
+    while( actual < (unsigned int) capacity )
+    {
+        actual <<= 1;
+    }
+
+    ring = (_GLFWring *) malloc( sizeof( _GLFWring ) );
+    if( !ring )
+    {
+        return NULL;
+    }
+    memset( ring, 0, sizeof( _GLFWring ) );
+
+    ring->Size = size;
+    ring->Capacity = actual;
+    ring->Data = (unsigned char *) malloc( (size_t) actual * size );
+    ring->Lock = _glfwPlatformCreateMutex();
+    ring->Cond = _glfwPlatformCreateCond();
+
+    if( !ring->Data || !ring->Lock || !ring->Cond )
+    {
+        if( ring->Lock )
+        {
+            _glfwPlatformDestroyMutex( ring->Lock );
+        }
+        if( ring->Cond )
+        {
+            _glfwPlatformDestroyCond( ring->Cond );
+        }
+        free( ring->Data );
+        free( ring );
+        return NULL;
+    }
+
+    return (GLFWring) ring;
+}
+
+
+//========================================================================
+// Destroy a ring buffer (nobody may be using it)
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwDestroyRing( GLFWring ring )
+{
+    _GLFWring *r = (_GLFWring *) ring;
+
+    if( !_glfwInitialized || !r )
+    {
+        return;
+    }
+
+    _glfwPlatformDestroyCond( r->Cond );
+    _glfwPlatformDestroyMutex( r->Lock );
+    free( r->Data );
+    free( r );
+}
+
+
+//========================================================================
+// Push an element if the ring is not full (producer thread only)
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwTryPushRing( GLFWring ring,
+                                          const void *element )
+{
+    if( !_glfwInitialized || !ring || !element )
+    {
+        return GL_FALSE;
+    }
+
+    if( !PushElements( (_GLFWring *) ring,
+                       (const unsigned char *) element, 1 ) )
+    {
+        return GL_FALSE;
+    }
+
+    WakeRing( (_GLFWring *) ring );
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Pop an element if the ring is not empty (consumer thread only)
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwTryPopRing( GLFWring ring, void *element )
+{
+    if( !_glfwInitialized || !ring || !element )
+    {
+        return GL_FALSE;
+    }
+
+    if( !PopElements( (_GLFWring *) ring, (unsigned char *) element, 1 ) )
+    {
+        return GL_FALSE;
+    }
+
+    WakeRing( (_GLFWring *) ring );
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Push as many of the elements as there is room for and return how many
+// were pushed (producer thread only)
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwPushRingBatch( GLFWring ring,
+                                            const void *elements,
+                                            int count )
+{
+    int result;
+
+    if( !_glfwInitialized || !ring || !elements )
+    {
+        return 0;
+    }
+
+    result = PushElements( (_GLFWring *) ring,
+                           (const unsigned char *) elements, count );
+    if( result )
+    {
+        WakeRing( (_GLFWring *) ring );
+    }
+
+    return result;
+}
+
+
+//========================================================================
+// Pop up to count elements and return how many were popped (consumer
+// thread only)
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwPopRingBatch( GLFWring ring, void *elements,
+                                           int count )
+{
+    int result;
+
+    if( !_glfwInitialized || !ring || !elements )
+    {
+        return 0;
+    }
+
+    result = PopElements( (_GLFWring *) ring,
+                          (unsigned char *) elements, count );
+    if( result )
+    {
+        WakeRing( (_GLFWring *) ring );
+    }
+
+    return result;
+}
+
+
+//========================================================================
+// Push an element, waiting up to timeout seconds for room if the ring is
+// full (producer thread only)
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwPushRing( GLFWring ring, const void *element,
+                                       double timeout )
+{
+    _GLFWring *r = (_GLFWring *) ring;
+
+    if( !_glfwInitialized || !r || !element )
+    {
+        return GL_FALSE;
+    }
+
+    if( PushElements( r, (const unsigned char *) element, 1 ) )
+    {
+        WakeRing( r );
+        return GL_TRUE;
+    }
+
+    if( timeout <= 0.0 )
+    {
+        return GL_FALSE;
+    }
+
+    return WaitRing( r, (void *) element, GL_TRUE, timeout );
+}
+
+
+//========================================================================
+// Pop an element, waiting up to timeout seconds for one if the ring is
+// empty (consumer thread only)
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwPopRing( GLFWring ring, void *element,
+                                      double timeout )
+{
+    _GLFWring *r = (_GLFWring *) ring;
+
+    if( !_glfwInitialized || !r || !element )
+    {
+        return GL_FALSE;
+    }
+
+    if( PopElements( r, (unsigned char *) element, 1 ) )
+    {
+        WakeRing( r );
+        return GL_TRUE;
+    }
+
+    if( timeout <= 0.0 )
+    {
+        return GL_FALSE;
+    }
+
+    return WaitRing( r, element, GL_FALSE, timeout );
+}
+
@@ -0,0 +1,821 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Any
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+
+
+//========================================================================
+// Description:
+//
+// This module implements barriers, reader-writer locks, semaphores and
+// events. All of them keep their state in a single integer that is only
+// changed with atomic operations, so a thread that does not have to
+// wait never takes a lock or makes a system call.
+//
+// Threads that do have to wait sleep on a wait queue: a sequence number
+// that is bumped whenever the object changes, and a count of sleepers.
+// Where the platform can sleep on an address (futexes on Linux) the
+// sequence number is waited on directly; elsewhere a mutex and condition
+// variable stand in. Either way the sequence number is sampled before
+// the object is checked a last time, so a change that happens in between
+// makes the sleep return at once, and nobody is woken while the count of
+// sleepers is zero.
+//
+// pthread_barrier_wait cannot time out and pthread_rwlock only takes
+// deadlines on the realtime clock, so neither is used.
+//
+//========================================================================
+
+#include "internal.h"
+
+#include <limits.h>
+
+
+// Largest number of threads a barrier can wait for
+#define _GLFW_BARRIER_MAX_COUNT 0xffff
+
+
+//------------------------------------------------------------------------
+// Wait queue
+//------------------------------------------------------------------------
+typedef struct {
+    volatile int Sequence;
+    volatile int Sleepers;
+
+    // Only used where the platform cannot sleep on Sequence itself
+    GLFWmutex    Lock;
+    GLFWcond     Cond;
+} _GLFWwaitqueue;
+
+
+//------------------------------------------------------------------------
+// Barrier (State holds the generation above the low 16 bits and the
+// number of threads that have arrived in them)
+//------------------------------------------------------------------------
+typedef struct {
+    int            Count;
+    volatile int   State;
+    _GLFWwaitqueue Queue;
+} _GLFWbarrier;
+
+
+//------------------------------------------------------------------------
+// Reader-writer lock (State is the number of readers, or -1 while a
+// writer holds it)
+//------------------------------------------------------------------------
+typedef struct {
+    volatile int   State;
+    volatile int   Writers;
+    _GLFWwaitqueue Queue;
+} _GLFWrwlock;
+
+
+//------------------------------------------------------------------------
+// Semaphore
+//------------------------------------------------------------------------
+typedef struct {
+    volatile int   Count;
+    _GLFWwaitqueue Queue;
+} _GLFWsemaphore;
+
+
+//------------------------------------------------------------------------
+// Event
+//------------------------------------------------------------------------
+typedef struct {
+    int            ManualReset;
+    volatile int   Signaled;
+    _GLFWwaitqueue Queue;
+} _GLFWthreadevent;
+
+
+//------------------------------------------------------------------------
+// Barrier generation a thread is waiting for the end of
+//------------------------------------------------------------------------
+typedef struct {
+    _GLFWbarrier *Barrier;
+    int           Generation;
+} _GLFWbarrierwait;
+
+
+// Function that tries to take an object without waiting
+typedef int (* _GLFWtryfun)( void *object );
+
+
+
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+//========================================================================
+// Initialize a wait queue
+//========================================================================
+
+static int InitQueue( _GLFWwaitqueue *queue )
+{
+    queue->Sequence = 0;
+    queue->Sleepers = 0;
+    queue->Lock = _glfwPlatformCreateMutex();
+    queue->Cond = _glfwPlatformCreateCond();
+
+    if( !queue->Lock || !queue->Cond )
+    {
+        if( queue->Lock )
+        {
+            _glfwPlatformDestroyMutex( queue->Lock );
+        }
+        if( queue->Cond )
+        {
+            _glfwPlatformDestroyCond( queue->Cond );
+        }
+        return GL_FALSE;
+    }
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Free the resources of a wait queue
+//========================================================================
+
+static void TerminateQueue( _GLFWwaitqueue *queue )
+{
+    _glfwPlatformDestroyCond( queue->Cond );
+    _glfwPlatformDestroyMutex( queue->Lock );
+}
+
+
+//========================================================================
+// Sleep for at most timeout seconds, or until the queue has been woken
+// since the sequence number was sampled
+//========================================================================
+
+static void SleepQueue( _GLFWwaitqueue *queue, int sequence, double timeout )
+{
+    if( _glfwPlatformWaitAddress( &queue->Sequence, sequence, timeout ) )
+    {
+        return;
+    }
+
+    _glfwPlatformLockMutex( queue->Lock );
+    if( queue->Sequence == sequence )
+    {
+        _glfwPlatformWaitCond( queue->Cond, queue->Lock, timeout );
+    }
+    _glfwPlatformUnlockMutex( queue->Lock );
+}
+
+
+//========================================================================
+// Wake up to count sleepers after the object has changed
+//========================================================================
+
+static void WakeQueue( _GLFWwaitqueue *queue, int count )
+{
+    // This is a full barrier, so the change to the object is visible
+    // before the sleepers are counted
+    _glfwPlatformAtomicAdd( &queue->Sequence, 1 );
+
+    if( queue->Sleepers == 0 )
+    {
+        return;
+    }
+
+    if( _glfwPlatformWakeAddress( &queue->Sequence, count ) )
+    {
+        return;
+    }
+
+    _glfwPlatformLockMutex( queue->Lock );
+    if( count == 1 )
+    {
+        _glfwPlatformSignalCond( queue->Cond );
+    }
+    else
+    {
+        _glfwPlatformBroadcastCond( queue->Cond );
+    }
+    _glfwPlatformUnlockMutex( queue->Lock );
+}
+
+
+//========================================================================
+// Take an object, sleeping on its wait queue until it can be taken or
+// the timeout has passed. Returns GL_FALSE on timeout
+//========================================================================
+
+static int WaitQueue( _GLFWwaitqueue *queue, _GLFWtryfun tryfun, void *object,
+                      double timeout )
+{
+    double deadline = GLFW_INFINITY, remaining = GLFW_INFINITY;
+    int sequence;
+
+    if( tryfun( object ) )
+    {
+        return GL_TRUE;
+    }
+
+    if( timeout < GLFW_INFINITY )
+    {
+        deadline = _glfwPlatformGetTime() + timeout;
+    }
+
+    for( ;; )
+    {
+        _glfwPlatformAtomicAdd( &queue->Sleepers, 1 );
+        sequence = queue->Sequence;
+        _glfwPlatformMemoryBarrier();
+
+        if( tryfun( object ) )
+        {
+            break;
+        }
+
+        if( timeout < GLFW_INFINITY )
+        {
+            remaining = deadline - _glfwPlatformGetTime();
+            if( remaining <= 0.0 )
+            {
+                _glfwPlatformAtomicAdd( &queue->Sleepers, -1 );
+                return GL_FALSE;
+            }
+        }
+
+        SleepQueue( queue, sequence, remaining );
+        _glfwPlatformAtomicAdd( &queue->Sleepers, -1 );
+    }
+
+    _glfwPlatformAtomicAdd( &queue->Sleepers, -1 );
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Check whether a barrier generation has ended
+//========================================================================
+
+static int TryBarrier( void *object )
+{
+    _GLFWbarrierwait *wait = (_GLFWbarrierwait *) object;
+
+    return (wait->Barrier->State >> 16) != wait->Generation;
+}
+
+
+//========================================================================
+// Try to take a reader-writer lock for reading. Readers stay out while
+// a writer is waiting, so that writers are not starved
+//========================================================================
+
+static int TryReadLock( void *object )
+{
+    _GLFWrwlock *lock = (_GLFWrwlock *) object;
+    int state;
+
+    for( ;; )
+    {
+        state = lock->State;
+        if( state < 0 || lock->Writers > 0 )
+        {
+            return GL_FALSE;
+        }
+
+        if( _glfwPlatformAtomicCompareAndSwap( &lock->State, state,
+                                               state + 1 ) )
+        {
+            return GL_TRUE;
+        }
+    }
+}
+
+
+//========================================================================
+// Try to take a reader-writer lock for writing
+//========================================================================
+
+static int TryWriteLock( void *object )
+{
+    _GLFWrwlock *lock = (_GLFWrwlock *) object;
+
+    return lock->State == 0 &&
+           _glfwPlatformAtomicCompareAndSwap( &lock->State, 0, -1 );
+}
+
+
+//========================================================================
+// Try to decrement a semaphore
+//========================================================================
+
+static int TrySemaphore( void *object )
+{
+    _GLFWsemaphore *semaphore = (_GLFWsemaphore *) object;
+    int count;
+
+    for( ;; )
+    {
+        count = semaphore->Count;
+        if( count <= 0 )
+        {
+            return GL_FALSE;
+        }
+
+        if( _glfwPlatformAtomicCompareAndSwap( &semaphore->Count, count,
+                                               count - 1 ) )
+        {
+            return GL_TRUE;
+        }
+    }
+}
+
+
+//========================================================================
+// Check whether an event is signaled, resetting it if it resets itself
+//========================================================================
+
+static int TryThreadEvent( void *object )
+{
+    _GLFWthreadevent *event = (_GLFWthreadevent *) object;
+
+    if( event->ManualReset )
+    {
+        return event->Signaled;
+    }
+
+    return event->Signaled &&
+           _glfwPlatformAtomicCompareAndSwap( &event->Signaled,
+                                              GL_TRUE, GL_FALSE );
+}
+
+
+
+//************************************************************************
+//****                    GLFW user functions                         ****
+//************************************************************************
+
+//========================================================================
+// Create a barrier for the given number of threads
+//========================================================================
+
+GLFWAPI GLFWbarrier GLFWAPIENTRY glfwCreateBarrier( int count )
+{
+    _GLFWbarrier *barrier;
+
+    if( !_glfwInitialized || count < 1 || count > _GLFW_BARRIER_MAX_COUNT )
+    {
+        return NULL;
+    }
+
+    barrier = (_GLFWbarrier *) malloc( sizeof( _GLFWbarrier ) );
+    if( !barrier )
+    {
+        return NULL;
+    }
+
+    barrier->Count = count;
+    barrier->State = 0;
+
+    if( !InitQueue( &barrier->Queue ) )
+    {
+        free( barrier );
+        return NULL;
+    }
+
+    return (GLFWbarrier) barrier;
+}
+
+
+//========================================================================
+// Destroy a barrier (nobody may be waiting on it)
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwDestroyBarrier( GLFWbarrier barrier )
+{
+    _GLFWbarrier *b = (_GLFWbarrier *) barrier;
+
+    if( !_glfwInitialized || !b )
+    {
+        return;
+    }
+
+    TerminateQueue( &b->Queue );
+    free( b );
+}
+
+
+//========================================================================
+// Wait until the given number of threads have reached the barrier, or
+// the timeout has passed. A thread that times out no longer counts as
+// having arrived. Returns GL_FALSE on timeout
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwWaitBarrier( GLFWbarrier barrier,
+                                          double timeout )
+{
+    _GLFWbarrier *b = (_GLFWbarrier *) barrier;
+    _GLFWbarrierwait wait;
+    int state, next;
+
+    if( !_glfwInitialized || !b )
+    {
+        return GL_FALSE;
+    }
+
+    // Arrive, or release the waiting threads if this is the last one
+    do
+    {
+        state = b->State;
+        wait.Barrier = b;
+        wait.Generation = state >> 16;
+
+        if( (state & 0xffff) + 1 == b->Count )
+        {
+            next = ((wait.Generation + 1) & 0x7fff) << 16;
+        }
+        else
+        {
+            next = state + 1;
+        }
+    }
+    while( !_glfwPlatformAtomicCompareAndSwap( &b->State, state, next ) );
+
+    if( (next & 0xffff) == 0 )
+    {
+        WakeQueue( &b->Queue, INT_MAX );
+        return GL_TRUE;
+    }
+
+    if( WaitQueue( &b->Queue, TryBarrier, &wait, timeout ) )
+    {
+        return GL_TRUE;
+    }
+
+    // Leave again, unless the barrier was released in the meantime
+    for( ;; )
+    {
+        state = b->State;
+        if( (state >> 16) != wait.Generation )
+        {
+            return GL_TRUE;
+        }
+
+        if( _glfwPlatformAtomicCompareAndSwap( &b->State, state,
+                                               state - 1 ) )
+        {
+            return GL_FALSE;
+        }
+    }
+}
+
+
+//========================================================================
+// Create a reader-writer lock
+//========================================================================
+
+GLFWAPI GLFWrwlock GLFWAPIENTRY glfwCreateRWLock( void )
+{
+    _GLFWrwlock *lock;
+
+    if( !_glfwInitialized )
+    {
+        return NULL;
+    }
+
+    lock = (_GLFWrwlock *) malloc( sizeof( _GLFWrwlock ) );
+    if( !lock )
+    {
+        return NULL;
+    }
+
+    lock->State = 0;
+    lock->Writers = 0;
+
+    if( !InitQueue( &lock->Queue ) )
+    {
+        free( lock );
+        return NULL;
+    }
+
+    return (GLFWrwlock) lock;
+}
+
+
+//========================================================================
+// Destroy a reader-writer lock (nobody may hold it)
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwDestroyRWLock( GLFWrwlock lock )
+{
+    _GLFWrwlock *l = (_GLFWrwlock *) lock;
+
+    if( !_glfwInitialized || !l )
+    {
+        return;
+    }
+
+    TerminateQueue( &l->Queue );
+    free( l );
+}
+
+
+//========================================================================
+// Lock a reader-writer lock for reading. Returns GL_FALSE on timeout
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwReadLockRWLock( GLFWrwlock lock,
+                                             double timeout )
+{
+    _GLFWrwlock *l = (_GLFWrwlock *) lock;
+
+    if( !_glfwInitialized || !l )
+    {
+        return GL_FALSE;
+    }
+
+    return WaitQueue( &l->Queue, TryReadLock, l, timeout );
+}
+
+
+//========================================================================
+// Lock a reader-writer lock for writing. Returns GL_FALSE on timeout
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwWriteLockRWLock( GLFWrwlock lock,
+                                              double timeout )
+{
+    _GLFWrwlock *l = (_GLFWrwlock *) lock;
+    int result;
+
+    if( !_glfwInitialized || !l )
+    {
+        return GL_FALSE;
+    }
+
+    if( TryWriteLock( l ) )
+    {
+        return GL_TRUE;
+    }
+
+    // Hold off new readers while waiting
+    _glfwPlatformAtomicAdd( &l->Writers, 1 );
+    result = WaitQueue( &l->Queue, TryWriteLock, l, timeout );
+
+    if( _glfwPlatformAtomicAdd( &l->Writers, -1 ) == 0 && !result )
+    {
+        // Readers held off by this writer may go ahead now
+        WakeQueue( &l->Queue, INT_MAX );
+    }
+
+    return result;
+}
+
+
+//========================================================================
+// Unlock a reader-writer lock, whichever way it was locked
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwUnlockRWLock( GLFWrwlock lock )
+{
+    _GLFWrwlock *l = (_GLFWrwlock *) lock;
+
+    if( !_glfwInitialized || !l )
+    {
+        return;
+    }
+
+    if( l->State < 0 )
+    {
+        (void) _glfwPlatformAtomicCompareAndSwap( &l->State, -1, 0 );
+    }
+    else if( _glfwPlatformAtomicAdd( &l->State, -1 ) != 0 )
+    {
+        // Other readers still hold it, so nobody can take it yet
+        return;
+    }
+
+    WakeQueue( &l->Queue, INT_MAX );
+}
+
+
+//========================================================================
+// Create a semaphore with the given initial count
+//========================================================================
+
+GLFWAPI GLFWsemaphore GLFWAPIENTRY glfwCreateSemaphore( int count )
+{
+    _GLFWsemaphore *semaphore;
+
+    if( !_glfwInitialized || count < 0 )
+    {
+        return NULL;
+    }
+
+    semaphore = (_GLFWsemaphore *) malloc( sizeof( _GLFWsemaphore ) );
+    if( !semaphore )
+    {
+        return NULL;
+    }
+
+    semaphore->Count = count;
+
+    if( !InitQueue( &semaphore->Queue ) )
+    {
+        free( semaphore );
+        return NULL;
+    }
+
+    return (GLFWsemaphore) semaphore;
+}
+
+
+//========================================================================
+// Destroy a semaphore (nobody may be waiting on it)
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwDestroySemaphore( GLFWsemaphore semaphore )
+{
+    _GLFWsemaphore *s = (_GLFWsemaphore *) semaphore;
+
+    if( !_glfwInitialized || !s )
+    {
+        return;
+    }
+
+    TerminateQueue( &s->Queue );
+    free( s );
+}
+
+
+//========================================================================
+// Wait until the count of a semaphore is positive and decrement it.
+// Returns GL_FALSE on timeout
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwWaitSemaphore( GLFWsemaphore semaphore,
+                                            double timeout )
+{
+    _GLFWsemaphore *s = (_GLFWsemaphore *) semaphore;
+
+    if( !_glfwInitialized || !s )
+    {
+        return GL_FALSE;
+    }
+
+    return WaitQueue( &s->Queue, TrySemaphore, s, timeout );
+}
+
+
+//========================================================================
+// Add to the count of a semaphore, waking as many waiting threads
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwPostSemaphore( GLFWsemaphore semaphore,
+                                             int count )
+{
+    _GLFWsemaphore *s = (_GLFWsemaphore *) semaphore;
+
+    if( !_glfwInitialized || !s || count < 1 )
+    {
+        return;
+    }
+
+    _glfwPlatformAtomicAdd( &s->Count, count );
+    WakeQueue( &s->Queue, count );
+}
+
+
+//========================================================================
+// Create an event. A manual reset event stays signaled until it is
+// reset, while any other event is reset by the thread it releases
+//========================================================================
+
+GLFWAPI GLFWthreadevent GLFWAPIENTRY glfwCreateThreadEvent( int manualreset,
+                                                            int signaled )
+{
+    _GLFWthreadevent *event;
+
+    if( !_glfwInitialized )
+    {
+        return NULL;
+    }
+
+    event = (_GLFWthreadevent *) malloc( sizeof( _GLFWthreadevent ) );
+    if( !event )
+    {
+        return NULL;
+    }
+
+    event->ManualReset = manualreset ? GL_TRUE : GL_FALSE;
+    event->Signaled = signaled ? GL_TRUE : GL_FALSE;
+
+    if( !InitQueue( &event->Queue ) )
+    {
+        free( event );
+        return NULL;
+    }
+
+    return (GLFWthreadevent) event;
+}
+
+
+//========================================================================
+// Destroy an event (nobody may be waiting on it)
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwDestroyThreadEvent( GLFWthreadevent event )
+{
+    _GLFWthreadevent *e = (_GLFWthreadevent *) event;
+
+    if( !_glfwInitialized || !e )
+    {
+        return;
+    }
+
+    TerminateQueue( &e->Queue );
+    free( e );
+}
+
+
+//========================================================================
+// Wait until an event is signaled. Returns GL_FALSE on timeout
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwWaitThreadEvent( GLFWthreadevent event,
+                                              double timeout )
+{
+    _GLFWthreadevent *e = (_GLFWthreadevent *) event;
+
+    if( !_glfwInitialized || !e )
+    {
+        return GL_FALSE;
+    }
+
+    return WaitQueue( &e->Queue, TryThreadEvent, e, timeout );
+}
+
+
+//========================================================================
+// Signal an event, releasing all waiting threads if it is manual reset
+// and one of them otherwise
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwSetThreadEvent( GLFWthreadevent event )
+{
+    _GLFWthreadevent *e = (_GLFWthreadevent *) event;
+
+    if( !_glfwInitialized || !e )
+    {
+        return;
+    }
+
+    if( e->Signaled )
+    {
+        return;
+    }
+
+    e->Signaled = GL_TRUE;
+    WakeQueue( &e->Queue, e->ManualReset ? INT_MAX : 1 );
+}
+
+
+//========================================================================
+// Reset an event
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwResetThreadEvent( GLFWthreadevent event )
+{
+    _GLFWthreadevent *e = (_GLFWthreadevent *) event;
+
+    if( !_glfwInitialized || !e )
+    {
+        return;
+    }
+
+    e->Signaled = GL_FALSE;
+}
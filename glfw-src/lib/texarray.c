@@ -0,0 +1,525 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Any
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+//========================================================================
+// Description:
+//
+// This module uploads a set of equally sized images (animation frames,
+// terrain layers etc.) as the layers of a single texture. With
+// GL_EXT_texture_array (core in OpenGL 3.0), storage for all layers and
+// mipmap levels is specified once and each layer is then uploaded with
+// glTexSubImage3D, to the texture bound to GL_TEXTURE_2D_ARRAY_EXT.
+//
+// Without texture arrays (or with GLFW_TEXTURE_ATLAS_BIT), the layers are
+// instead laid out in a grid in the texture bound to GL_TEXTURE_2D. The
+// grid has C columns and R rows, where C is the smallest power of two with
+// C * C >= count and R is the smallest power of two with C * R >= count.
+// Layer i is placed in column i % C and row i / C, with row 0 at the
+// bottom of the texture.
+//
+// Mipmaps are built in software one layer at a time, so that layers never
+// bleed into each other in the coarser levels.
+//
+// The file variant decodes the images on as many threads as there are
+// processors before uploading them.
+//
+//========================================================================
+
+#include "internal.h"
+
+
+// GL_EXT_texture_array tokens
+#ifndef GL_EXT_texture_array
+ #define GL_TEXTURE_2D_ARRAY_EXT          0x8C1A
+ #define GL_MAX_ARRAY_TEXTURE_LAYERS_EXT  0x88FF
+#endif // GL_EXT_texture_array
+
+// GL_TEXTURE_MAX_LEVEL is an OpenGL 1.2 token
+#ifndef GL_VERSION_1_2
+ #define GL_TEXTURE_MAX_LEVEL       0x813D
+#endif // GL_VERSION_1_2
+
+
+//------------------------------------------------------------------------
+// Shared state of the threads decoding a list of files
+//------------------------------------------------------------------------
+typedef struct {
+    const char    **Names;
+    GLFWimage      *Layers;
+    int             Count;
+    int             Flags;
+    int             Next;
+    int             Failed;
+    GLFWmutex       Mutex;
+} _GLFWarraydecode;
+
+
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+//========================================================================
+// Look for texture array support (called on first use in each context)
+//========================================================================
+
+static void InitTextureArrays( void )
+{
+    _glfwTex.HasTextureArray = GL_FALSE;
+
+    if( _glfwWin.glMajor >= 3 ||
+        glfwExtensionSupported( "GL_EXT_texture_array" ) )
+    {
+        _glfwTex.TexImage3D = (_GLFWteximage3dfun)
+            glfwGetProcAddress( "glTexImage3D" );
+        _glfwTex.TexSubImage3D = (_GLFWtexsubimage3dfun)
+            glfwGetProcAddress( "glTexSubImage3D" );
+
+        // OpenGL 1.1 implementations may only have the EXT entry points
+        if( !_glfwTex.TexImage3D || !_glfwTex.TexSubImage3D )
+        {
+            _glfwTex.TexImage3D = (_GLFWteximage3dfun)
+                glfwGetProcAddress( "glTexImage3DEXT" );
+            _glfwTex.TexSubImage3D = (_GLFWtexsubimage3dfun)
+                glfwGetProcAddress( "glTexSubImage3DEXT" );
+        }
+
+        if( _glfwTex.TexImage3D && _glfwTex.TexSubImage3D )
+        {
+            _glfwTex.HasTextureArray = GL_TRUE;
+        }
+    }
+
+    _glfwTex.ArrayInitialized = GL_TRUE;
+}
+
+
+//========================================================================
+// Check that all layers can share one texture
+//========================================================================
+
+static int CheckLayers( const GLFWimage *layers, int count )
+{
+    int i;
+
+    for( i = 0; i < count; i ++ )
+    {
+        if( layers[ i ].Data == NULL ||
+            layers[ i ].Format == GL_COLOR_INDEX ||
+            layers[ i ].Width != layers[ 0 ].Width ||
+            layers[ i ].Height != layers[ 0 ].Height ||
+            layers[ i ].Format != layers[ 0 ].Format ||
+            layers[ i ].BytesPerPixel != layers[ 0 ].BytesPerPixel )
+        {
+            return GL_FALSE;
+        }
+    }
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Return the number of levels in a full mipmap chain
+//========================================================================
+
+static int CountLevels( int width, int height )
+{
+    int levels = 1;
+
+    while( width > 1 || height > 1 )
+    {
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        levels ++;
+    }
+
+    return levels;
+}
+
+
+//========================================================================
+// Upload all levels of a layer, building the mipmaps in scratch memory.
+// Layers go to an array texture, or to a cell of an atlas with the given
+// number of columns
+//========================================================================
+
+static void UploadLayer( const GLFWimage *img, int layer, int levels,
+                         GLubyte *scratch, int columns )
+{
+    int level, width, height, stride, alignment;
+    GLubyte *data;
+
+    alignment = _glfwGetRowAlignment( img );
+    stride = (img->Width * img->BytesPerPixel + alignment - 1) /
+             alignment * alignment;
+    glPixelStorei( GL_UNPACK_ALIGNMENT, alignment );
+
+    // The mipmaps are built in place, so leave the image alone
+    data = img->Data;
+    if( levels > 1 )
+    {
+        memcpy( scratch, img->Data, (size_t) img->Height * stride );
+        data = scratch;
+    }
+
+    width = img->Width;
+    height = img->Height;
+    for( level = 0; level < levels; level ++ )
+    {
+        if( level > 0 )
+        {
+            _glfwHalveImage( data, &width, &height, img->BytesPerPixel,
+                             &stride, alignment );
+        }
+
+        if( columns == 0 )
+        {
+            _glfwTex.TexSubImage3D( GL_TEXTURE_2D_ARRAY_EXT, level,
+                                    0, 0, layer, width, height, 1,
+                                    img->Format, GL_UNSIGNED_BYTE, data );
+        }
+        else
+        {
+            glTexSubImage2D( GL_TEXTURE_2D, level,
+                             (layer % columns) * width,
+                             (layer / columns) * height,
+                             width, height, img->Format,
+                             GL_UNSIGNED_BYTE, data );
+        }
+    }
+}
+
+
+//========================================================================
+// Upload the layers to the texture bound to GL_TEXTURE_2D_ARRAY_EXT
+//========================================================================
+
+static int UploadTextureArray( GLFWimage *layers, int count, int levels,
+                               GLubyte *scratch )
+{
+    GLint maxLayers;
+    int   i, level, width, height, format;
+
+    glGetIntegerv( GL_MAX_ARRAY_TEXTURE_LAYERS_EXT, &maxLayers );
+    if( count > maxLayers )
+    {
+        return GL_FALSE;
+    }
+
+    format = layers[ 0 ].Format;
+
+    // Specify storage for all levels before uploading any layer
+    width = layers[ 0 ].Width;
+    height = layers[ 0 ].Height;
+    for( level = 0; level < levels; level ++ )
+    {
+        _glfwTex.TexImage3D( GL_TEXTURE_2D_ARRAY_EXT, level, format,
+                             width, height, count, 0, format,
+                             GL_UNSIGNED_BYTE, NULL );
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+
+    for( i = 0; i < count; i ++ )
+    {
+        UploadLayer( &layers[ i ], i, levels, scratch, 0 );
+    }
+
+    _glfwTrackTexture( GL_TEXTURE_2D_ARRAY_EXT, format,
+                       layers[ 0 ].BytesPerPixel );
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Upload the layers as a grid to the texture bound to GL_TEXTURE_2D
+//========================================================================
+
+static int UploadTextureAtlas( GLFWimage *layers, int count, int levels,
+                               GLubyte *scratch )
+{
+    GLint maxSize;
+    int   i, level, columns, rows, width, height, format;
+
+    columns = 1;
+    while( columns * columns < count )
+    {
+        columns *= 2;
+    }
+    rows = 1;
+    while( columns * rows < count )
+    {
+        rows *= 2;
+    }
+
+    glGetIntegerv( GL_MAX_TEXTURE_SIZE, &maxSize );
+    if( columns * layers[ 0 ].Width > maxSize ||
+        rows * layers[ 0 ].Height > maxSize )
+    {
+        return GL_FALSE;
+    }
+
+    // Format specification is different for OpenGL 1.0
+    format = layers[ 0 ].Format;
+    if( _glfwWin.glMajor == 1 && _glfwWin.glMinor == 0 )
+    {
+        format = layers[ 0 ].BytesPerPixel;
+    }
+
+    // Levels where a layer would be narrower than one texel are left out,
+    // since its cells would no longer line up with the atlas levels
+    width = layers[ 0 ].Width < layers[ 0 ].Height ?
+            layers[ 0 ].Width : layers[ 0 ].Height;
+    if( levels > CountLevels( width, width ) )
+    {
+        levels = CountLevels( width, width );
+    }
+
+    // Each level has the size OpenGL expects from the atlas, which for
+    // layers that are not a power of two leaves a few unused texels
+    width = columns * layers[ 0 ].Width;
+    height = rows * layers[ 0 ].Height;
+    for( level = 0; level < levels; level ++ )
+    {
+        glTexImage2D( GL_TEXTURE_2D, level, format, width, height, 0,
+                      layers[ 0 ].Format, GL_UNSIGNED_BYTE, NULL );
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+
+    // The atlas may have more levels than its layers, which would leave the
+    // texture incomplete
+    if( levels > 1 && (_glfwWin.glMajor > 1 || _glfwWin.glMinor >= 2) )
+    {
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1 );
+    }
+
+    for( i = 0; i < count; i ++ )
+    {
+        UploadLayer( &layers[ i ], i, levels, scratch, columns );
+    }
+
+    _glfwTrackTexture( GL_TEXTURE_2D, format, layers[ 0 ].BytesPerPixel );
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Decoding thread: read files until there are none left
+//========================================================================
+
+static void GLFWCALL DecodeThread( void *arg )
+{
+    _GLFWarraydecode *decode = (_GLFWarraydecode *) arg;
+    int i;
+
+    for( ;; )
+    {
+        glfwLockMutex( decode->Mutex );
+        i = decode->Failed ? decode->Count : decode->Next ++;
+        glfwUnlockMutex( decode->Mutex );
+
+        if( i >= decode->Count )
+        {
+            return;
+        }
+
+        // Layers cannot be reloaded into the array, so they are not
+        // watched
+        if( !_glfwReadImage( decode->Names[ i ], &decode->Layers[ i ],
+                             decode->Flags ) )
+        {
+            glfwLockMutex( decode->Mutex );
+            decode->Failed = GL_TRUE;
+            glfwUnlockMutex( decode->Mutex );
+        }
+    }
+}
+
+
+//************************************************************************
+//****                    GLFW user functions                         ****
+//************************************************************************
+
+//========================================================================
+// Upload equally sized images as the layers of one texture. Returns the
+// target the texture was uploaded to (GL_TEXTURE_2D_ARRAY_EXT, or
+// GL_TEXTURE_2D for an atlas), or zero on failure
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwLoadTextureArray( GLFWimage *layers, int count,
+    int flags )
+{
+    GLint   UnpackAlignment;
+    int     levels, target, ok;
+    long    size;
+    GLubyte *scratch;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwWin.opened )
+    {
+        return GL_FALSE;
+    }
+
+    if( layers == NULL || count < 1 || !CheckLayers( layers, count ) )
+    {
+        return GL_FALSE;
+    }
+
+    if( !_glfwTex.ArrayInitialized )
+    {
+        InitTextureArrays();
+    }
+
+    levels = 1;
+    scratch = NULL;
+    if( flags & GLFW_BUILD_MIPMAPS_BIT )
+    {
+        levels = CountLevels( layers[ 0 ].Width, layers[ 0 ].Height );
+
+        // Row alignment may differ between layers, so allow for padding
+        size = (long) layers[ 0 ].Height *
+               ((layers[ 0 ].Width * layers[ 0 ].BytesPerPixel + 3) & ~3);
+        scratch = (GLubyte *) malloc( size );
+        if( scratch == NULL )
+        {
+            return GL_FALSE;
+        }
+    }
+
+    glGetIntegerv( GL_UNPACK_ALIGNMENT, &UnpackAlignment );
+
+    if( _glfwTex.HasTextureArray && !(flags & GLFW_TEXTURE_ATLAS_BIT) )
+    {
+        target = GL_TEXTURE_2D_ARRAY_EXT;
+        ok = UploadTextureArray( layers, count, levels, scratch );
+    }
+    else
+    {
+        target = GL_TEXTURE_2D;
+        ok = UploadTextureAtlas( layers, count, levels, scratch );
+    }
+
+    glPixelStorei( GL_UNPACK_ALIGNMENT, UnpackAlignment );
+
+    free( scratch );
+
+    return ok ? target : GL_FALSE;
+}
+
+
+//========================================================================
+// Read a list of image files in parallel and upload them as the layers of
+// one texture (see glfwLoadTextureArray)
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwLoadTextureArrayFiles( const char **names,
+    int count, int flags )
+{
+    _GLFWarraydecode decode;
+    GLFWthread threads[ 16 ];
+    int i, threadCount, target;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwWin.opened )
+    {
+        return GL_FALSE;
+    }
+
+    if( names == NULL || count < 1 )
+    {
+        return GL_FALSE;
+    }
+
+    decode.Layers = (GLFWimage *) calloc( count, sizeof(GLFWimage) );
+    if( decode.Layers == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    decode.Mutex = glfwCreateMutex();
+    if( decode.Mutex == NULL )
+    {
+        free( decode.Layers );
+        return GL_FALSE;
+    }
+
+    // Indexed layers could not be uploaded anyway
+    decode.Names  = names;
+    decode.Count  = count;
+    decode.Flags  = flags & ~(GLFW_BUILD_MIPMAPS_BIT | GLFW_INDEXED_BIT |
+                              GLFW_TEXTURE_ATLAS_BIT);
+    decode.Next   = 0;
+    decode.Failed = GL_FALSE;
+
+    // The calling thread decodes as well
+    threadCount = _glfwGetUsableProcessors() - 1;
+    if( threadCount > count - 1 )
+    {
+        threadCount = count - 1;
+    }
+    if( threadCount > (int) (sizeof(threads) / sizeof(threads[0])) )
+    {
+        threadCount = (int) (sizeof(threads) / sizeof(threads[0]));
+    }
+
+    for( i = 0; i < threadCount; i ++ )
+    {
+        threads[ i ] = glfwCreateThread( DecodeThread, &decode );
+    }
+
+    DecodeThread( &decode );
+
+    for( i = 0; i < threadCount; i ++ )
+    {
+        if( threads[ i ] >= 0 )
+        {
+            glfwWaitThread( threads[ i ], GLFW_WAIT );
+        }
+    }
+
+    glfwDestroyMutex( decode.Mutex );
+
+    target = GL_FALSE;
+    if( !decode.Failed )
+    {
+        target = glfwLoadTextureArray( decode.Layers, count, flags );
+    }
+
+    for( i = 0; i < count; i ++ )
+    {
+        glfwFreeImage( &decode.Layers[ i ] );
+    }
+    free( decode.Layers );
+
+    return target;
+}
@@ -0,0 +1,986 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Any
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+//========================================================================
+// Description:
+//
+// This module handles progressive (streamed) texture uploads. Uploading a
+// large texture in one go can stall the frame it happens in, so instead
+// the complete mipmap chain is built in system memory, the coarsest level
+// is uploaded immediately, and the remaining levels are uploaded in bands
+// of rows by glfwUpdateTextureStreams, which is meant to be called once
+// per frame with a time budget.
+//
+// GL_TEXTURE_BASE_LEVEL is clamped to the finest level that has been
+// completely uploaded, so the texture is always complete and sharpens as
+// more levels arrive.
+//
+// When GLFW_TEXTURE_ACCOUNTING is enabled, the memory used by textures
+// loaded through GLFW (all mipmap levels) is recorded, and textures are
+// kept in least recently used order and hashed by name. If a budget is
+// set and exceeded, the eviction callback is called for the coldest
+// textures until memory use is back within budget.
+//
+//========================================================================
+
+#include "internal.h"
+
+
+// GL_TEXTURE_BASE_LEVEL and GL_TEXTURE_MAX_LEVEL are OpenGL 1.2 tokens
+#ifndef GL_VERSION_1_2
+ #define GL_TEXTURE_BASE_LEVEL      0x813C
+ #define GL_TEXTURE_MAX_LEVEL       0x813D
+ #define GL_TEXTURE_DEPTH           0x8071
+#endif // GL_VERSION_1_2
+
+// GL_EXT_texture_array tokens
+#ifndef GL_EXT_texture_array
+ #define GL_TEXTURE_2D_ARRAY_EXT          0x8C1A
+ #define GL_TEXTURE_BINDING_2D_ARRAY_EXT  0x8C1D
+#endif // GL_EXT_texture_array
+
+// Compressed texture queries are OpenGL 1.3 tokens
+#ifndef GL_VERSION_1_3
+ #define GL_TEXTURE_COMPRESSED_IMAGE_SIZE 0x86A0
+ #define GL_TEXTURE_COMPRESSED      0x86A1
+#endif // GL_VERSION_1_3
+
+// We want to be able to disable automatic mipmap generation
+#ifndef GL_SGIS_generate_mipmap
+ #define GL_GENERATE_MIPMAP_SGIS    0x8191
+#endif // GL_SGIS_generate_mipmap
+
+// Preferred number of bytes to upload in each glTexSubImage2D call
+#define _GLFW_STREAM_BAND_SIZE 65536
+
+// Initial number of texture record hash buckets (a power of two)
+#define _GLFW_TEXTURE_BUCKETS 64
+
+
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+//========================================================================
+// Unlink and free a texture stream
+//========================================================================
+
+static void RemoveTextureStream( _GLFWtexstream *stream )
+{
+    _GLFWtexstream **prev;
+
+    for( prev = &_glfwTex.FirstStream; *prev; prev = &(*prev)->Next )
+    {
+        if( *prev == stream )
+        {
+            *prev = stream->Next;
+            break;
+        }
+    }
+
+    free( stream->Data[ 0 ] );
+    free( stream );
+}
+
+
+//========================================================================
+// Find the stream targeting the specified texture object
+//========================================================================
+
+static _GLFWtexstream * FindTextureStream( GLuint texture )
+{
+    _GLFWtexstream *stream;
+
+    for( stream = _glfwTex.FirstStream; stream; stream = stream->Next )
+    {
+        if( stream->Texture == texture )
+        {
+            return stream;
+        }
+    }
+
+    return NULL;
+}
+
+
+//========================================================================
+// Upload the next band of rows of a stream (texture must be bound)
+// Returns the number of bytes uploaded
+//========================================================================
+
+static long UploadTextureBand( _GLFWtexstream *stream )
+{
+    int  level, width, rows, rowsize;
+    long bytes;
+
+    level = stream->Level;
+    width = stream->Width[ level ];
+    rowsize = width * stream->BytesPerPixel;
+
+    // Upload as many rows as fit within a band (at least one row)
+    rows = _GLFW_STREAM_BAND_SIZE / rowsize;
+    if( rows < 1 )
+    {
+        rows = 1;
+    }
+    if( rows > stream->Height[ level ] - stream->Row )
+    {
+        rows = stream->Height[ level ] - stream->Row;
+    }
+
+    glTexSubImage2D( GL_TEXTURE_2D, level, 0, stream->Row, width, rows,
+        stream->Format, GL_UNSIGNED_BYTE,
+        (void*) (stream->Data[ level ] + stream->Row * rowsize) );
+
+    bytes = (long) rows * rowsize;
+    stream->UploadedBytes += bytes;
+    stream->Row += rows;
+
+    // Level complete? Then let the texture sample from it
+    if( stream->Row == stream->Height[ level ] )
+    {
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level );
+
+        stream->Level --;
+        stream->Row = 0;
+    }
+
+    return bytes;
+}
+
+
+//========================================================================
+// Return the hash bucket of a texture name. Names are usually handed out
+// in sequence, which the odd multiplier spreads over all buckets
+//========================================================================
+
+static _GLFWtexrecord ** GetTextureBucket( GLuint texture )
+{
+    unsigned int hash;
+
+    hash = (unsigned int) texture * 2654435761U;
+    return &_glfwTex.Buckets[ hash & (_glfwTex.BucketCount - 1) ];
+}
+
+
+//========================================================================
+// Find the memory record of the specified texture object
+//========================================================================
+
+static _GLFWtexrecord * FindTextureRecord( GLuint texture )
+{
+    _GLFWtexrecord *record;
+
+    if( _glfwTex.Buckets == NULL )
+    {
+        return NULL;
+    }
+
+    for( record = *GetTextureBucket( texture ); record;
+         record = record->NextInBucket )
+    {
+        if( record->Texture == texture )
+        {
+            return record;
+        }
+    }
+
+    return NULL;
+}
+
+
+//========================================================================
+// Make room for at least as many memory records as there are buckets,
+// keeping the average bucket short. Returns GL_FALSE if there is no table
+//========================================================================
+
+static int GrowTextureBuckets( void )
+{
+    _GLFWtexrecord **buckets, **bucket, *record;
+    int            count;
+
+    if( _glfwTex.Buckets && _glfwTex.TextureCount < _glfwTex.BucketCount )
+    {
+        return GL_TRUE;
+    }
+
+    count = _glfwTex.Buckets ? _glfwTex.BucketCount * 2
+                             : _GLFW_TEXTURE_BUCKETS;
+    buckets = (_GLFWtexrecord **) calloc( count, sizeof(_GLFWtexrecord *) );
+    if( buckets == NULL )
+    {
+        // Longer chains are better than losing track of textures
+        return _glfwTex.Buckets != NULL;
+    }
+
+    free( _glfwTex.Buckets );
+    _glfwTex.Buckets = buckets;
+    _glfwTex.BucketCount = count;
+
+    // Rehash all records, which are all on the LRU list
+    for( record = _glfwTex.MostRecent; record; record = record->Next )
+    {
+        bucket = GetTextureBucket( record->Texture );
+        record->NextInBucket = *bucket;
+        *bucket = record;
+    }
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Unlink a memory record from the LRU list
+//========================================================================
+
+static void UnlinkTextureRecord( _GLFWtexrecord *record )
+{
+    if( record->Prev )
+    {
+        record->Prev->Next = record->Next;
+    }
+    else
+    {
+        _glfwTex.MostRecent = record->Next;
+    }
+
+    if( record->Next )
+    {
+        record->Next->Prev = record->Prev;
+    }
+    else
+    {
+        _glfwTex.LeastRecent = record->Prev;
+    }
+}
+
+
+//========================================================================
+// Insert a memory record at the most recently used end of the LRU list
+//========================================================================
+
+static void LinkTextureRecord( _GLFWtexrecord *record )
+{
+    record->Prev = NULL;
+    record->Next = _glfwTex.MostRecent;
+
+    if( _glfwTex.MostRecent )
+    {
+        _glfwTex.MostRecent->Prev = record;
+    }
+    else
+    {
+        _glfwTex.LeastRecent = record;
+    }
+
+    _glfwTex.MostRecent = record;
+}
+
+
+//========================================================================
+// Unlink and free a memory record
+//========================================================================
+
+static void RemoveTextureRecord( _GLFWtexrecord *record )
+{
+    _GLFWtexrecord **bucket;
+
+    for( bucket = GetTextureBucket( record->Texture ); *bucket;
+         bucket = &(*bucket)->NextInBucket )
+    {
+        if( *bucket == record )
+        {
+            *bucket = record->NextInBucket;
+            break;
+        }
+    }
+
+    UnlinkTextureRecord( record );
+
+    _glfwTex.UsedBytes -= record->Bytes;
+    _glfwTex.TextureCount --;
+
+    free( record );
+}
+
+
+//========================================================================
+// Ask the application to evict the least recently used textures until
+// memory use is within budget
+//========================================================================
+
+static void EnforceTextureBudget( void )
+{
+    _GLFWtexrecord *record;
+    GLuint texture;
+    long   bytes;
+    int    count;
+
+    // Eviction is only possible with the help of the application, and the
+    // callback must not cause recursive eviction
+    if( !_glfwTex.EvictCallback || _glfwTex.Evicting ||
+        _glfwTex.BudgetBytes <= 0 )
+    {
+        return;
+    }
+
+    _glfwTex.Evicting = GL_TRUE;
+
+    // Visit each texture at most once, as the callback may reload evicted
+    // textures at a lower resolution
+    count = _glfwTex.TextureCount;
+    while( _glfwTex.UsedBytes > _glfwTex.BudgetBytes &&
+           _glfwTex.LeastRecent && count -- > 0 )
+    {
+        record = _glfwTex.LeastRecent;
+        texture = record->Texture;
+        bytes = record->Bytes;
+
+        RemoveTextureRecord( record );
+        _glfwTex.EvictionCount ++;
+
+        _glfwTex.EvictCallback( texture, bytes );
+    }
+
+    _glfwTex.Evicting = GL_FALSE;
+}
+
+
+//========================================================================
+// Record the memory used by the texture currently bound to target
+// (GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY_EXT), which has just been
+// specified with the given format and bytes per pixel
+//========================================================================
+
+void _glfwTrackTexture( GLenum target, int format, int bpp )
+{
+    GLint  texture, width, height, depth, compressed, size;
+    int    level, hasCompression;
+    long   bytes;
+    _GLFWtexrecord *record, **bucket;
+
+    if( !_glfwTex.Accounting )
+    {
+        return;
+    }
+
+    glGetIntegerv( target == GL_TEXTURE_2D_ARRAY_EXT ?
+                   GL_TEXTURE_BINDING_2D_ARRAY_EXT : GL_TEXTURE_BINDING_2D,
+                   &texture );
+    if( texture == 0 )
+    {
+        return;
+    }
+
+    hasCompression = _glfwWin.glMajor > 1 || _glfwWin.glMinor >= 3;
+
+    // Sum up all specified mipmap levels, whether uploaded by GLFW or
+    // generated by the driver
+    bytes = 0;
+    compressed = GL_FALSE;
+    for( level = 0; level < _GLFW_MAX_TEXTURE_LEVELS; ++ level )
+    {
+        glGetTexLevelParameteriv( target, level, GL_TEXTURE_WIDTH, &width );
+        glGetTexLevelParameteriv( target, level, GL_TEXTURE_HEIGHT, &height );
+        if( width < 1 || height < 1 )
+        {
+            break;
+        }
+
+        // Array layers do not shrink with the level
+        depth = 1;
+        if( target == GL_TEXTURE_2D_ARRAY_EXT )
+        {
+            glGetTexLevelParameteriv( target, level, GL_TEXTURE_DEPTH,
+                &depth );
+        }
+
+        if( hasCompression )
+        {
+            glGetTexLevelParameteriv( target, level,
+                GL_TEXTURE_COMPRESSED, &compressed );
+        }
+
+        if( compressed )
+        {
+            glGetTexLevelParameteriv( target, level,
+                GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size );
+            bytes += size;
+        }
+        else
+        {
+            bytes += (long) width * height * depth * bpp;
+        }
+
+        if( width == 1 && height == 1 )
+        {
+            level ++;
+            break;
+        }
+    }
+
+    // Texture names are often reused, so update any existing record
+    record = FindTextureRecord( (GLuint) texture );
+    if( record )
+    {
+        UnlinkTextureRecord( record );
+        _glfwTex.UsedBytes -= record->Bytes;
+    }
+    else
+    {
+        if( !GrowTextureBuckets() )
+        {
+            return;
+        }
+
+        record = (_GLFWtexrecord *) malloc( sizeof(_GLFWtexrecord) );
+        if( record == NULL )
+        {
+            return;
+        }
+
+        record->Texture = (GLuint) texture;
+        bucket = GetTextureBucket( record->Texture );
+        record->NextInBucket = *bucket;
+        *bucket = record;
+        _glfwTex.TextureCount ++;
+    }
+
+    record->Format = format;
+    record->Compressed = compressed ? GL_TRUE : GL_FALSE;
+    record->Levels = level;
+    record->Bytes = bytes;
+
+    LinkTextureRecord( record );
+    _glfwTex.UsedBytes += bytes;
+
+    EnforceTextureBudget();
+}
+
+
+//========================================================================
+// Free all texture memory records
+//========================================================================
+
+void _glfwClearTextureRecords( void )
+{
+    while( _glfwTex.MostRecent )
+    {
+        RemoveTextureRecord( _glfwTex.MostRecent );
+    }
+
+    free( _glfwTex.Buckets );
+    _glfwTex.Buckets = NULL;
+    _glfwTex.BucketCount = 0;
+}
+
+
+//========================================================================
+// Free all texture streams, memory records, file watches and scratch
+// memory, and forget context entry points (called when the OpenGL context
+// goes away)
+//========================================================================
+
+void _glfwClearTextures( void )
+{
+    while( _glfwTex.FirstStream )
+    {
+        RemoveTextureStream( _glfwTex.FirstStream );
+    }
+
+    _glfwClearTextureRecords();
+    _glfwUnwatchTextures();
+
+    free( _glfwTex.Scratch );
+    _glfwTex.Scratch = NULL;
+    _glfwTex.ScratchSize = 0;
+
+    // The next context may have other entry points
+    _glfwTex.ArrayInitialized = GL_FALSE;
+}
+
+
+//************************************************************************
+//****                    GLFW user functions                         ****
+//************************************************************************
+
+//========================================================================
+// Begin streaming an image object to the currently bound texture
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwStreamTextureImage2D( GLFWimage *img, int flags )
+{
+    GLint   texture, UnpackAlignment, UnpackRowLength;
+    GLint   UnpackSkipPixels, UnpackSkipRows;
+    int     levels, level, width, height, stride, alignment, bpp, m;
+    long    size, total;
+    unsigned char *data, *scratch;
+    _GLFWtexstream *stream, **last;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwWin.opened )
+    {
+        return GL_FALSE;
+    }
+
+    // Base level clamping requires OpenGL 1.2, so upload directly instead,
+    // as is done for indexed images
+    if( ( _glfwWin.glMajor == 1 && _glfwWin.glMinor < 2 ) ||
+        img->Format == GL_COLOR_INDEX )
+    {
+        return glfwLoadTextureImage2D( img, flags | GLFW_BUILD_MIPMAPS_BIT );
+    }
+
+    // Streams are identified by texture object, so one must be bound
+    glGetIntegerv( GL_TEXTURE_BINDING_2D, &texture );
+    if( texture == 0 || img->Width < 1 || img->Height < 1 )
+    {
+        return GL_FALSE;
+    }
+
+    // Any previous stream to this texture is superseded
+    glfwCancelTextureStream( (GLuint) texture );
+
+    bpp = img->BytesPerPixel;
+
+    // Count levels and the size of the complete (tightly packed) chain
+    width = img->Width;
+    height = img->Height;
+    levels = 0;
+    total = 0;
+    do
+    {
+        total += (long) width * height * bpp;
+        levels ++;
+        if( width <= 1 && height <= 1 )
+        {
+            break;
+        }
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    while( levels < _GLFW_MAX_TEXTURE_LEVELS );
+
+    stream = (_GLFWtexstream *) malloc( sizeof(_GLFWtexstream) );
+    if( stream == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    data = (unsigned char *) malloc( total );
+    size = (long) img->Width * img->Height * bpp;
+    scratch = (unsigned char *) malloc( size );
+    if( data == NULL || scratch == NULL )
+    {
+        free( scratch );
+        free( data );
+        free( stream );
+        return GL_FALSE;
+    }
+
+    // Gather level 0 into the scratch buffer with tightly packed rows
+    alignment = _glfwGetRowAlignment( img );
+    stride = (img->Width * bpp + alignment - 1) / alignment * alignment;
+    for( m = 0; m < img->Height; ++ m )
+    {
+        memcpy( scratch + m * img->Width * bpp, img->Data + m * stride,
+                img->Width * bpp );
+    }
+
+    // Build the mipmap chain, storing each level after the previous one
+    width = img->Width;
+    height = img->Height;
+    stride = width * bpp;
+    for( level = 0; level < levels; ++ level )
+    {
+        stream->Width[ level ] = width;
+        stream->Height[ level ] = height;
+        stream->Data[ level ] = data;
+        size = (long) width * height * bpp;
+        memcpy( data, scratch, size );
+        data += size;
+
+        if( !_glfwHalveImage( scratch, &width, &height, bpp, &stride, 1 ) )
+        {
+            break;
+        }
+    }
+    free( scratch );
+
+    stream->Texture = (GLuint) texture;
+    stream->Format = img->Format;
+    stream->BytesPerPixel = bpp;
+    stream->Levels = levels;
+    stream->Level = levels - 2;
+    stream->Row = 0;
+    stream->TotalBytes = total;
+    stream->UploadedBytes = size;
+
+    glGetIntegerv( GL_UNPACK_ALIGNMENT, &UnpackAlignment );
+    glGetIntegerv( GL_UNPACK_ROW_LENGTH, &UnpackRowLength );
+    glGetIntegerv( GL_UNPACK_SKIP_PIXELS, &UnpackSkipPixels );
+    glGetIntegerv( GL_UNPACK_SKIP_ROWS, &UnpackSkipRows );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, 0 );
+    glPixelStorei( GL_UNPACK_SKIP_PIXELS, 0 );
+    glPixelStorei( GL_UNPACK_SKIP_ROWS, 0 );
+
+    // Levels generated by the driver would overwrite the streamed ones
+    if( _glfwWin.has_GL_SGIS_generate_mipmap )
+    {
+        glTexParameteri( GL_TEXTURE_2D, GL_GENERATE_MIPMAP_SGIS, GL_FALSE );
+    }
+
+    // Allocate all levels, but only fill in the coarsest one right away
+    for( level = 0; level < levels; ++ level )
+    {
+        glTexImage2D( GL_TEXTURE_2D, level, img->Format,
+            stream->Width[ level ], stream->Height[ level ], 0,
+            img->Format, GL_UNSIGNED_BYTE,
+            level == levels - 1 ? (void*) stream->Data[ level ] : NULL );
+    }
+
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, levels - 1 );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1 );
+
+    glPixelStorei( GL_UNPACK_ALIGNMENT, UnpackAlignment );
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, UnpackRowLength );
+    glPixelStorei( GL_UNPACK_SKIP_PIXELS, UnpackSkipPixels );
+    glPixelStorei( GL_UNPACK_SKIP_ROWS, UnpackSkipRows );
+
+    // All levels are allocated now, so record their memory use
+    _glfwTrackTexture( GL_TEXTURE_2D, img->Format, bpp );
+
+    // A single level image is already complete
+    if( levels == 1 )
+    {
+        free( stream->Data[ 0 ] );
+        free( stream );
+        return GL_TRUE;
+    }
+
+    // Append the stream, so that streams are serviced in FIFO order
+    for( last = &_glfwTex.FirstStream; *last; last = &(*last)->Next )
+        ;
+    stream->Next = NULL;
+    *last = stream;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Upload pending texture data for at most the specified number of
+// microseconds. Returns the number of bytes uploaded.
+//========================================================================
+
+GLFWAPI long GLFWAPIENTRY glfwUpdateTextureStreams( int budget )
+{
+    GLint   texture, UnpackAlignment, UnpackRowLength;
+    GLint   UnpackSkipPixels, UnpackSkipRows;
+    double  t0;
+    long    bytes;
+    _GLFWtexstream *stream;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || !_glfwWin.opened )
+    {
+        return 0;
+    }
+
+    if( _glfwTex.FirstStream == NULL )
+    {
+        return 0;
+    }
+
+    t0 = _glfwPlatformGetTime();
+
+    glGetIntegerv( GL_TEXTURE_BINDING_2D, &texture );
+    glGetIntegerv( GL_UNPACK_ALIGNMENT, &UnpackAlignment );
+    glGetIntegerv( GL_UNPACK_ROW_LENGTH, &UnpackRowLength );
+    glGetIntegerv( GL_UNPACK_SKIP_PIXELS, &UnpackSkipPixels );
+    glGetIntegerv( GL_UNPACK_SKIP_ROWS, &UnpackSkipRows );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, 0 );
+    glPixelStorei( GL_UNPACK_SKIP_PIXELS, 0 );
+    glPixelStorei( GL_UNPACK_SKIP_ROWS, 0 );
+
+    // Always upload at least one band, so that streams make progress even
+    // with a zero budget
+    bytes = 0;
+    while( _glfwTex.FirstStream )
+    {
+        stream = _glfwTex.FirstStream;
+
+        glBindTexture( GL_TEXTURE_2D, stream->Texture );
+        bytes += UploadTextureBand( stream );
+
+        if( stream->Level < 0 )
+        {
+            RemoveTextureStream( stream );
+        }
+
+        if( (_glfwPlatformGetTime() - t0) * 1000000.0 >= (double) budget )
+        {
+            break;
+        }
+    }
+
+    glBindTexture( GL_TEXTURE_2D, (GLuint) texture );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, UnpackAlignment );
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, UnpackRowLength );
+    glPixelStorei( GL_UNPACK_SKIP_PIXELS, UnpackSkipPixels );
+    glPixelStorei( GL_UNPACK_SKIP_ROWS, UnpackSkipRows );
+
+    return bytes;
+}
+
+
+//========================================================================
+// Return the fraction of a texture that has been uploaded (a texture
+// that is not being streamed is considered fully resident)
+//========================================================================
+
+GLFWAPI double GLFWAPIENTRY glfwGetTextureStreamProgress( GLuint texture )
+{
+    _GLFWtexstream *stream;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return 0.0;
+    }
+
+    stream = FindTextureStream( texture );
+    if( stream == NULL )
+    {
+        return 1.0;
+    }
+
+    return (double) stream->UploadedBytes / (double) stream->TotalBytes;
+}
+
+
+//========================================================================
+// Stop streaming to a texture (levels uploaded so far are kept)
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwCancelTextureStream( GLuint texture )
+{
+    _GLFWtexstream *stream;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return;
+    }
+
+    stream = FindTextureStream( texture );
+    if( stream != NULL )
+    {
+        RemoveTextureStream( stream );
+    }
+}
+
+
+//========================================================================
+// Set the texture memory budget in bytes (zero means no budget)
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwSetTextureBudget( long bytes )
+{
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return;
+    }
+
+    _glfwTex.BudgetBytes = bytes > 0 ? bytes : 0;
+
+    EnforceTextureBudget();
+}
+
+
+//========================================================================
+// Set callback function for texture eviction
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwSetTextureEvictCallback( GLFWtextureevictfun cbfun )
+{
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return;
+    }
+
+    _glfwTex.EvictCallback = cbfun;
+
+    // The budget may already be exceeded
+    EnforceTextureBudget();
+}
+
+
+//========================================================================
+// Mark a texture as most recently used
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwTouchTexture( GLuint texture )
+{
+    _GLFWtexrecord *record;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return;
+    }
+
+    record = FindTextureRecord( texture );
+    if( record && record != _glfwTex.MostRecent )
+    {
+        UnlinkTextureRecord( record );
+        LinkTextureRecord( record );
+    }
+}
+
+
+//========================================================================
+// Stop accounting for and reloading a texture (call this when deleting it)
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwForgetTexture( GLuint texture )
+{
+    _GLFWtexrecord *record;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return;
+    }
+
+    record = FindTextureRecord( texture );
+    if( record )
+    {
+        RemoveTextureRecord( record );
+    }
+
+    // Stop reloading the texture from its file
+    _glfwUnwatchTexture( texture );
+}
+
+
+//========================================================================
+// Return the memory used by a texture (zero if it is not accounted for)
+//========================================================================
+
+GLFWAPI long GLFWAPIENTRY glfwGetTextureMemory( GLuint texture, int *format, int *compressed )
+{
+    _GLFWtexrecord *record;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return 0;
+    }
+
+    record = FindTextureRecord( texture );
+    if( record == NULL )
+    {
+        return 0;
+    }
+
+    if( format )
+    {
+        *format = record->Format;
+    }
+    if( compressed )
+    {
+        *compressed = record->Compressed;
+    }
+
+    return record->Bytes;
+}
+
+
+//========================================================================
+// Get the least recently used textures, coldest first. Returns the
+// number of texture names written to the list.
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwGetLeastRecentTextures( GLuint *list, int maxcount )
+{
+    _GLFWtexrecord *record;
+    int count;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return 0;
+    }
+
+    count = 0;
+    for( record = _glfwTex.LeastRecent; record && count < maxcount;
+         record = record->Prev )
+    {
+        list[ count ++ ] = record->Texture;
+    }
+
+    return count;
+}
+
+
+//========================================================================
+// Get texture memory counters (any pointer may be NULL)
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwGetTextureMemoryStats( long *used, long *budget, int *count, long *evictions )
+{
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return;
+    }
+
+    if( used )
+    {
+        *used = _glfwTex.UsedBytes;
+    }
+    if( budget )
+    {
+        *budget = _glfwTex.BudgetBytes;
+    }
+    if( count )
+    {
+        *count = _glfwTex.TextureCount;
+    }
+    if( evictions )
+    {
+        *evictions = _glfwTex.EvictionCount;
+    }
+}
@@ -31,17 +31,30 @@
 //========================================================================
 // Description:
 //
-// TGA format image file loader. This module supports version 1 Targa
+// TGA format image file loader and writer. This module supports version 1 Targa
 // images, with these restrictions:
 //  - Pixel format may only be 8, 24 or 32 bits
 //  - Colormaps must be no longer than 256 entries
 //
+// Colormapped images are normally expanded to true color. With
+// GLFW_INDEXED_BIT they are kept as 8-bit indices plus a palette instead.
+//
+// Images are written as run-length encoded true color (24 or 32 bits),
+// grayscale (8 bits) or colormapped (8 bits) Targa images.
+//
 //========================================================================
 
 
 #include "internal.h"
 
 
+// BGR/BGRA pixel formats are OpenGL 1.2 tokens
+#ifndef GL_VERSION_1_2
+ #define GL_BGR                     0x80E0
+ #define GL_BGRA                    0x80E1
+#endif // GL_VERSION_1_2
+
+
 //************************************************************************
 //****            GLFW internal functions & declarations              ****
 //************************************************************************
@@ -204,9 +217,9 @@ static void ReadTGA_RLE( unsigned char *buf, int size, int bpp,
 int _glfwReadTGA( _GLFWstream *s, GLFWimage *img, int flags )
 {
     _tga_header_t h;
-    unsigned char *cmap, *pix, tmp, *src, *dst;
+    unsigned char *cmap, *pix, tmp, *src, *dst, *palette;
     int cmapsize, pixsize, pixsize2;
-    int bpp, bpp2, k, m, n, swapx, swapy;
+    int bpp, bpp2, cmapbpp, k, m, n, swapx, swapy, indexed;
 
     // Read TGA header
     if( !ReadTGAHeader( s, &h ) )
@@ -247,8 +260,11 @@ int _glfwReadTGA( _GLFWstream *s, GLFWimage *img, int flags )
     // Bytes per pixel (pixel data - unexpanded)
     bpp = (h.bitsperpixel + 7) / 8;
 
+    // Should colormap indices be kept as they are?
+    indexed = cmap && bpp == 1 && (flags & GLFW_INDEXED_BIT);
+
     // Bytes per pixel (expanded pixels - not colormap indeces)
-    if( cmap )
+    if( cmap && !indexed )
     {
         bpp2 = (h.cmapentrysize + 7) / 8;
     }
@@ -342,25 +358,40 @@ int _glfwReadTGA( _GLFWstream *s, GLFWimage *img, int flags )
                 dst -= 2*bpp;
             }
             src += ((h.width+1)/2)*bpp;
-            dst += ((3*h.width+1)/2)*bpp;
+            dst += (h.width + h.width/2)*bpp;
         }
     }
 
     // Convert BGR/BGRA to RGB/RGBA, and optionally colormap indeces to
     // RGB/RGBA values
+    palette = NULL;
+    cmapbpp = (h.cmapentrysize + 7) / 8;
     if( cmap )
     {
         // Convert colormap pixel format (BGR -> RGB or BGRA -> RGBA)
-        if( bpp2 == 3 || bpp2 == 4 )
+        for( n = 0; n < h.cmaplen; n ++ )
         {
-            for( n = 0; n < h.cmaplen; n ++ )
-            {
-                tmp                = cmap[ n*bpp2 ];
-                cmap[ n*bpp2 ]     = cmap[ n*bpp2 + 2 ];
-                cmap[ n*bpp2 + 2 ] = tmp;
-            }
+            tmp                   = cmap[ n*cmapbpp ];
+            cmap[ n*cmapbpp ]     = cmap[ n*cmapbpp + 2 ];
+            cmap[ n*cmapbpp + 2 ] = tmp;
         }
-
+    }
+    if( indexed )
+    {
+        // Keep the colormap as a full 256 entry palette, so that any index
+        // can be looked up
+        palette = (unsigned char *) calloc( 256, cmapbpp );
+        if( palette == NULL )
+        {
+            free( cmap );
+            free( pix );
+            return 0;
+        }
+        memcpy( palette, cmap, h.cmaplen * cmapbpp );
+        free( cmap );
+    }
+    else if( cmap )
+    {
         // Convert pixel data to RGB/RGBA data
         for( m = h.width * h.height - 1; m >= 0; m -- )
         {
@@ -398,7 +429,234 @@ int _glfwReadTGA( _GLFWstream *s, GLFWimage *img, int flags )
     img->Height        = h.height;
     img->BytesPerPixel = bpp2;
     img->Data          = pix;
+    img->Palette       = palette;
+    img->PaletteSize   = palette ? h.cmaplen : 0;
+    img->PaletteFormat = palette ? (cmapbpp == 4 ? GL_RGBA : GL_RGB) : 0;
 
     return 1;
 }
 
+
+//========================================================================
+// Compare two pixels
+//========================================================================
+
+static int PixelsEqual( const unsigned char *a, const unsigned char *b,
+    int bpp )
+{
+    unsigned int x, y;
+
+    // Compare 32-bit pixels as whole words
+    if( bpp == 4 )
+    {
+        memcpy( &x, a, 4 );
+        memcpy( &y, b, 4 );
+        return x == y;
+    }
+
+    return memcmp( a, b, bpp ) == 0;
+}
+
+
+//========================================================================
+// Run-length encode pixels with TGA packets (also used by the frame
+// recorder). Returns the number of bytes written to dst, which must hold
+// at least n*(bpp+1) bytes.
+//========================================================================
+
+int _glfwEncodeRLE( unsigned char *dst, const unsigned char *src, int n,
+    int bpp )
+{
+    unsigned char *start;
+    int i, j, run;
+
+    start = dst;
+    i = 0;
+    while( i < n )
+    {
+        // Measure the run of identical pixels starting here
+        run = 1;
+        while( i + run < n && run < 128 &&
+               PixelsEqual( src + i*bpp, src + (i+run)*bpp, bpp ) )
+        {
+            run ++;
+        }
+
+        if( run > 1 )
+        {
+            // Run-length packet
+            *dst ++ = (unsigned char) (0x80 | (run - 1));
+            memcpy( dst, src + i*bpp, bpp );
+            dst += bpp;
+            i += run;
+        }
+        else
+        {
+            // Raw packet, ending where the next run begins
+            j = i + 1;
+            while( j < n && j - i < 128 &&
+                   !(j + 1 < n &&
+                     PixelsEqual( src + j*bpp, src + (j+1)*bpp, bpp )) )
+            {
+                j ++;
+            }
+
+            *dst ++ = (unsigned char) (j - i - 1);
+            memcpy( dst, src + i*bpp, (j - i) * bpp );
+            dst += (j - i) * bpp;
+            i = j;
+        }
+    }
+
+    return (int) (dst - start);
+}
+
+
+//========================================================================
+// Write a TGA image to a file
+//========================================================================
+
+int _glfwWriteTGA( FILE *f, const GLFWimage *img, int flags )
+{
+    unsigned char hdr[ 18 ], *row, *packets;
+    const unsigned char *src;
+    int bpp, stride, alignment, swaprb, m, n, size, cmapbpp;
+
+    // Get the TGA pixel layout of the image format
+    bpp = img->BytesPerPixel;
+    cmapbpp = 0;
+    switch( img->Format )
+    {
+        case GL_LUMINANCE:
+        case GL_ALPHA:
+            swaprb = 0;
+            break;
+        case GL_COLOR_INDEX:
+            if( img->Palette == NULL || img->PaletteSize < 1 ||
+                img->PaletteSize > 256 )
+            {
+                return 0;
+            }
+            cmapbpp = img->PaletteFormat == GL_RGBA ? 4 : 3;
+            swaprb = 0;
+            break;
+        case GL_RGB:
+        case GL_RGBA:
+            swaprb = 1;
+            break;
+        case GL_BGR:
+        case GL_BGRA:
+            swaprb = 0;
+            break;
+        default:
+            return 0;
+    }
+    if( (bpp != 1 && bpp != 3 && bpp != 4) ||
+        (bpp == 1) != (img->Format == GL_LUMINANCE ||
+                       img->Format == GL_ALPHA ||
+                       img->Format == GL_COLOR_INDEX) ||
+        img->Width < 1 || img->Width > 65535 ||
+        img->Height < 1 || img->Height > 65535 )
+    {
+        return 0;
+    }
+
+    alignment = _glfwGetRowAlignment( img );
+    stride = (img->Width * bpp + alignment - 1) / alignment * alignment;
+
+    // Allocate memory for a converted row and its packets
+    row = (unsigned char *) malloc( img->Width * bpp > 256 * 4 ?
+                                    img->Width * bpp : 256 * 4 );
+    packets = (unsigned char *) malloc( img->Width * (bpp + 1) );
+    if( row == NULL || packets == NULL )
+    {
+        free( row );
+        free( packets );
+        return 0;
+    }
+
+    // Write TGA header (endian independent)
+    memset( hdr, 0, sizeof(hdr) );
+    hdr[2]  = bpp == 1 ? _TGA_IMAGETYPE_GRAY_RLE : _TGA_IMAGETYPE_TC_RLE;
+    if( cmapbpp )
+    {
+        hdr[1] = _TGA_CMAPTYPE_PRESENT;
+        hdr[2] = _TGA_IMAGETYPE_CMAP_RLE;
+        hdr[5] = (unsigned char) (img->PaletteSize & 255);
+        hdr[6] = (unsigned char) (img->PaletteSize >> 8);
+        hdr[7] = (unsigned char) (cmapbpp * 8);
+    }
+    hdr[12] = (unsigned char) (img->Width & 255);
+    hdr[13] = (unsigned char) (img->Width >> 8);
+    hdr[14] = (unsigned char) (img->Height & 255);
+    hdr[15] = (unsigned char) (img->Height >> 8);
+    hdr[16] = (unsigned char) (bpp * 8);
+    hdr[17] = (unsigned char) ((bpp == 4 || cmapbpp == 4 ? 8 : 0) |
+              (((flags & GLFW_ORIGIN_UL_BIT) ? _TGA_ORIGIN_UL :
+                _TGA_ORIGIN_BL) << _TGA_IMAGEINFO_ORIGIN_SHIFT));
+    if( fwrite( hdr, 1, 18, f ) != 18 )
+    {
+        free( row );
+        free( packets );
+        return 0;
+    }
+
+    // Write the colormap (RGB/RGBA -> BGR/BGRA)
+    if( cmapbpp )
+    {
+        for( n = 0; n < img->PaletteSize * cmapbpp; n += cmapbpp )
+        {
+            row[ n ]     = img->Palette[ n + 2 ];
+            row[ n + 1 ] = img->Palette[ n + 1 ];
+            row[ n + 2 ] = img->Palette[ n ];
+            if( cmapbpp == 4 )
+            {
+                row[ n + 3 ] = img->Palette[ n + 3 ];
+            }
+        }
+
+        size = img->PaletteSize * cmapbpp;
+        if( (int) fwrite( row, 1, size, f ) != size )
+        {
+            free( row );
+            free( packets );
+            return 0;
+        }
+    }
+
+    // Rows are stored in image order, as the origin is recorded in the
+    // header
+    for( m = 0; m < img->Height; m ++ )
+    {
+        src = img->Data + m * stride;
+
+        // Convert RGB/RGBA to BGR/BGRA
+        if( swaprb )
+        {
+            for( n = 0; n < img->Width * bpp; n += bpp )
+            {
+                row[ n ]     = src[ n + 2 ];
+                row[ n + 1 ] = src[ n + 1 ];
+                row[ n + 2 ] = src[ n ];
+                if( bpp == 4 )
+                {
+                    row[ n + 3 ] = src[ n + 3 ];
+                }
+            }
+            src = row;
+        }
+
+        size = _glfwEncodeRLE( packets, src, img->Width, bpp );
+        if( (int) fwrite( packets, 1, size, f ) != size )
+        {
+            free( row );
+            free( packets );
+            return 0;
+        }
+    }
+
+    free( row );
+    free( packets );
+
+    return 1;
+}
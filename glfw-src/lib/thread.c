@@ -37,59 +37,241 @@
 //************************************************************************
 
 //========================================================================
-// Find pointer to thread with a matching ID
+// Initialize the thread table and return the record of the main thread,
+// which always lives in slot zero and has the ID zero
+//========================================================================
+
+_GLFWthread * _glfwInitThreadTable( void )
+{
+    _GLFWthread *t;
+
+    memset( _glfwThrd.FirstChunk, 0, sizeof(_glfwThrd.FirstChunk) );
+    memset( _glfwThrd.Chunks, 0, sizeof(_glfwThrd.Chunks) );
+    _glfwThrd.Chunks[ 0 ] = _glfwThrd.FirstChunk;
+    _glfwThrd.SlotCount   = 1;
+    _glfwThrd.FirstFree   = -1;
+
+    t = &_glfwThrd.FirstChunk[ 0 ];
+    t->Slot       = 0;
+    t->Generation = 0;
+    t->NextFree   = -1;
+    t->Function   = NULL;
+    t->Arg        = NULL;
+    t->ID         = 0;
+
+    // The main thread counts as created when GLFW was initialized
+    t->CreationTime = 0.0;
+    t->StartTime    = 0.0;
+
+    return t;
+}
+
+
+//========================================================================
+// Free all dynamically allocated chunks of the thread table
+//========================================================================
+
+void _glfwTerminateThreadTable( void )
+{
+    int i;
+
+    for( i = 1; i < _GLFW_THREAD_CHUNKS; i ++ )
+    {
+        if( _glfwThrd.Chunks[ i ] != NULL )
+        {
+            free( (void *) _glfwThrd.Chunks[ i ] );
+            _glfwThrd.Chunks[ i ] = NULL;
+        }
+    }
+
+    _glfwThrd.SlotCount = 1;
+    _glfwThrd.FirstFree = -1;
+}
+
+
+//========================================================================
+// Return the thread record in the given slot
+//========================================================================
+
+_GLFWthread * _glfwGetThreadSlot( int slot )
+{
+    return &_glfwThrd.Chunks[ slot / _GLFW_THREAD_CHUNK_SIZE ]
+                            [ slot % _GLFW_THREAD_CHUNK_SIZE ];
+}
+
+
+//========================================================================
+// Find pointer to thread with a matching ID. This does not need the
+// critical section, as chunks are never moved or freed while GLFW is
+// initialized, but the caller must re-check the ID of the record after
+// reading anything else from it.
 //========================================================================
 
 _GLFWthread * _glfwGetThreadPointer( int ID )
 {
     _GLFWthread *t;
+    int         slot;
+
+    if( ID < 0 )
+    {
+        return NULL;
+    }
+
+    slot = ID & _GLFW_THREAD_SLOT_MASK;
+    if( slot >= _glfwThrd.SlotCount )
+    {
+        return NULL;
+    }
+
+    t = _glfwGetThreadSlot( slot );
+    if( t->ID != ID )
+    {
+        return NULL;
+    }
+
+    return t;
+}
+
+
+//========================================================================
+// Allocate a thread record (must be called inside the critical section).
+// The record is not visible to ID lookups until it is published.
+//========================================================================
+
+_GLFWthread * _glfwAllocThread( GLFWthreadfun fun, void *arg )
+{
+    _GLFWthread *t;
+    int         slot, chunk;
 
-    for( t = &_glfwThrd.First; t != NULL; t = t->Next )
+    if( _glfwThrd.FirstFree >= 0 )
     {
-        if( t->ID == ID )
+        // Reuse the most recently freed slot
+        t = _glfwGetThreadSlot( _glfwThrd.FirstFree );
+        _glfwThrd.FirstFree = t->NextFree;
+    }
+    else
+    {
+        slot  = _glfwThrd.SlotCount;
+        chunk = slot / _GLFW_THREAD_CHUNK_SIZE;
+        if( chunk >= _GLFW_THREAD_CHUNKS )
+        {
+            return NULL;
+        }
+
+        if( _glfwThrd.Chunks[ chunk ] == NULL )
         {
-            break;
+            _glfwThrd.Chunks[ chunk ] = (_GLFWthread *)
+                calloc( _GLFW_THREAD_CHUNK_SIZE, sizeof(_GLFWthread) );
+            if( _glfwThrd.Chunks[ chunk ] == NULL )
+            {
+                return NULL;
+            }
         }
+
+        t = _glfwGetThreadSlot( slot );
+        t->ID         = -1;
+        t->Slot       = slot;
+        t->Generation = 0;
+
+        // Make the new record visible to lock-free lookups only once it
+        // has been fully initialized
+        _glfwPlatformMemoryBarrier();
+        _glfwThrd.SlotCount = slot + 1;
     }
 
+    t->NextFree = -1;
+    t->Finished = GL_FALSE;
+    t->Function = fun;
+    t->Arg      = arg;
+
+    t->CreationTime = _glfwPlatformGetTime();
+    t->StartTime    = _glfwGetSteadyTime();
+
     return t;
 }
 
 
 //========================================================================
-// Append thread to thread list
+// Make a newly created thread visible to ID lookups (must be called
+// inside the critical section). If the thread has already finished, its
+// record is released at once.
 //========================================================================
 
-void _glfwAppendThread( _GLFWthread * t )
+GLFWthread _glfwPublishThread( _GLFWthread * t )
 {
-    _GLFWthread *t_tmp;
+    GLFWthread ID;
 
-    t_tmp = &_glfwThrd.First;
-    while( t_tmp->Next != NULL )
+    ID = _GLFW_THREAD_ID( t->Slot, t->Generation );
+
+    if( t->Finished )
+    {
+        _glfwFreeThread( t );
+    }
+    else
     {
-        t_tmp = t_tmp->Next;
+        _glfwPlatformMemoryBarrier();
+        t->ID = ID;
     }
-    t_tmp->Next = t;
-    t->Previous = t_tmp;
-    t->Next     = NULL;
+
+    return ID;
 }
 
 
 //========================================================================
-// Remove thread from thread list
+// Called by a thread when its thread function has returned (must be
+// called inside the critical section)
 //========================================================================
 
-void _glfwRemoveThread( _GLFWthread * t )
+void _glfwFinishThread( _GLFWthread * t )
 {
-    if( t->Previous != NULL )
+    if( t->ID >= 0 )
+    {
+        _glfwFreeThread( t );
+    }
+    else
     {
-        t->Previous->Next = t->Next;
+        // The creating thread has not published this thread yet, so let
+        // it free the record instead
+        t->Finished = GL_TRUE;
     }
-    if( t->Next != NULL )
+}
+
+
+//========================================================================
+// Return a thread record to the free list (must be called inside the
+// critical section). Bumping the generation invalidates the old ID.
+//========================================================================
+
+void _glfwFreeThread( _GLFWthread * t )
+{
+    t->ID = -1;
+    _glfwPlatformMemoryBarrier();
+
+    t->Generation = (t->Generation + 1) & _GLFW_THREAD_GENERATION_MASK;
+    t->Function   = NULL;
+    t->Arg        = NULL;
+    t->NextFree   = _glfwThrd.FirstFree;
+    _glfwThrd.FirstFree = t->Slot;
+}
+
+
+//========================================================================
+// Return the number of processors this process may actually use, which
+// is what worker thread counts should be based on
+//========================================================================
+
+int _glfwGetUsableProcessors( void )
+{
+    GLFWcputopology topology;
+
+    memset( &topology, 0, sizeof( GLFWcputopology ) );
+    if( !_glfwPlatformGetCPUTopology( &topology ) ||
+        topology.UsableCount < 1 )
     {
-        t->Next->Previous = t->Previous;
+        return _glfwPlatformGetNumberOfProcessors();
     }
-    free( (void *) t );
+
+    return topology.UsableCount;
 }
 
 
@@ -177,6 +359,120 @@ GLFWAPI GLFWthread GLFWAPIENTRY glfwGetThreadID( void )
 }
 
 
+//========================================================================
+// Restrict a thread to the processors whose bits are set in a mask (bit
+// N is processor N; only the first 32 processors can be selected)
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwSetThreadAffinity( GLFWthread ID,
+                                                unsigned int mask )
+{
+    // Is GLFW initialized?
+    if( !_glfwInitialized || mask == 0 )
+    {
+        return GL_FALSE;
+    }
+
+    return _glfwPlatformSetThreadAffinity( ID, mask );
+}
+
+
+//========================================================================
+// Change the scheduling priority of a thread
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwSetThreadPriority( GLFWthread ID, int priority )
+{
+    // Is GLFW initialized?
+    if( !_glfwInitialized )
+    {
+        return GL_FALSE;
+    }
+
+    if( priority != GLFW_THREAD_PRIORITY_LOW &&
+        priority != GLFW_THREAD_PRIORITY_NORMAL &&
+        priority != GLFW_THREAD_PRIORITY_HIGH &&
+        priority != GLFW_THREAD_PRIORITY_REALTIME )
+    {
+        return GL_FALSE;
+    }
+
+    return _glfwPlatformSetThreadPriority( ID, priority );
+}
+
+
+//========================================================================
+// Name a thread, for debuggers and profilers
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwSetThreadName( GLFWthread ID, const char *name )
+{
+    // Is GLFW initialized?
+    if( !_glfwInitialized || name == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    return _glfwPlatformSetThreadName( ID, name );
+}
+
+
+//========================================================================
+// Get the creation time, CPU time and context switch counts of a thread.
+// Nothing is tracked while threads run, so this is only as expensive as
+// the system calls it makes
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwGetThreadStats( GLFWthread ID,
+                                            GLFWthreadstats *stats )
+{
+    // Is GLFW initialized?
+    if( !_glfwInitialized || stats == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    stats->CreationTime        = 0.0;
+    stats->RunTime             = 0.0;
+    stats->CPUTime             = -1.0;
+    stats->VoluntarySwitches   = -1;
+    stats->InvoluntarySwitches = -1;
+
+    return _glfwPlatformGetThreadStats( ID, stats );
+}
+
+
+//========================================================================
+// Get the IDs of all running threads, including the main thread. Returns
+// the number of IDs stored in the list
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwGetThreads( GLFWthread *list, int maxcount )
+{
+    _GLFWthread *t;
+    int         i, count = 0;
+
+    // Is GLFW initialized?
+    if( !_glfwInitialized || list == NULL )
+    {
+        return 0;
+    }
+
+    ENTER_THREAD_CRITICAL_SECTION
+    for( i = 0; i < _glfwThrd.SlotCount && count < maxcount; i ++ )
+    {
+        t = _glfwGetThreadSlot( i );
+        if( t->ID >= 0 )
+        {
+            list[ count ++ ] = t->ID;
+        }
+    }
+    LEAVE_THREAD_CRITICAL_SECTION
+
+    return count;
+}
+
+
 //========================================================================
 // Create a mutual exclusion object
 //========================================================================
@@ -290,6 +586,24 @@ GLFWAPI void GLFWAPIENTRY glfwWaitCond( GLFWcond cond, GLFWmutex mutex,
 }
 
 
+//========================================================================
+// Wait for a condition to be raised or the timer (see glfwGetTime) to
+// reach a given value
+//========================================================================
+
+GLFWAPI void GLFWAPIENTRY glfwWaitCondUntil( GLFWcond cond, GLFWmutex mutex,
+                                             double time )
+{
+    // Initialized & valid condition variable and mutex?
+    if( !_glfwInitialized || !cond || !mutex )
+    {
+        return;
+    }
+
+    _glfwPlatformWaitCondUntil( cond, mutex, time );
+}
+
+
 //========================================================================
 // Signal a condition to one waiting thread
 //========================================================================
@@ -339,3 +653,23 @@ GLFWAPI int GLFWAPIENTRY glfwGetNumberOfProcessors( void )
     return _glfwPlatformGetNumberOfProcessors();
 }
 
+
+//========================================================================
+// Describe the processors that this process may actually use, as limited
+// by affinity masks and CPU quotas, and how they share cores and caches.
+// UsableCount is the number to size thread pools by
+//========================================================================
+
+GLFWAPI int GLFWAPIENTRY glfwGetCPUTopology( GLFWcputopology *topology )
+{
+    // Is GLFW initialized?
+    if( !_glfwInitialized || topology == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    memset( topology, 0, sizeof( GLFWcputopology ) );
+
+    return _glfwPlatformGetCPUTopology( topology );
+}
+
@@ -31,6 +31,22 @@
 #include "internal.h"
 
 
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+//========================================================================
+// Return the time in seconds since glfwInit, which glfwSetTime does not
+// change
+//========================================================================
+
+double _glfwGetSteadyTime( void )
+{
+    return _glfwPlatformGetTime() + _glfwTimerOffset;
+}
+
+
+
 //************************************************************************
 //****                    GLFW user functions                         ****
 //************************************************************************
@@ -63,6 +79,7 @@ GLFWAPI void GLFWAPIENTRY glfwSetTime( double time )
         return;
     }
 
+    _glfwTimerOffset += _glfwPlatformGetTime() - time;
     _glfwPlatformSetTime( time );
 }
 
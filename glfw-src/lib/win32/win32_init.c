@@ -144,19 +144,23 @@ static void _glfwFreeLibraries( void )
 
 static void _glfwInitThreads( void )
 {
-    // Initialize critical section handle
-    InitializeCriticalSection( &_glfwThrd.CriticalSection );
-
-    // The first thread (the main thread) has ID 0
-    _glfwThrd.NextID = 0;
+    _GLFWthread *t;
 
-    // Fill out information about the main thread (this thread)
-    _glfwThrd.First.ID       = _glfwThrd.NextID ++;
-    _glfwThrd.First.Function = NULL;
-    _glfwThrd.First.Handle   = GetCurrentThread();
-    _glfwThrd.First.WinID    = GetCurrentThreadId();
-    _glfwThrd.First.Previous = NULL;
-    _glfwThrd.First.Next     = NULL;
+    // Initialize critical section handle and thread record index
+    InitializeCriticalSection( &_glfwThrd.CriticalSection );
+    _glfwThrd.TlsIndex = TlsAlloc();
+
+    // Fill out information about the main thread (this thread), which
+    // always has ID 0
+    t = _glfwInitThreadTable();
+    t->WinID  = GetCurrentThreadId();
+
+    // GetCurrentThread returns a pseudo handle that means whichever
+    // thread uses it, so get a real one for other threads to use
+    DuplicateHandle( GetCurrentProcess(), GetCurrentThread(),
+                     GetCurrentProcess(), &t->Handle,
+                     0, FALSE, DUPLICATE_SAME_ACCESS );
+    TlsSetValue( _glfwThrd.TlsIndex, (LPVOID) t );
 }
 
 
@@ -166,18 +170,21 @@ static void _glfwInitThreads( void )
 
 static void _glfwTerminateThreads( void )
 {
-    _GLFWthread *t, *t_next;
+    _GLFWthread *t;
+    int         i;
 
     // Enter critical section
     ENTER_THREAD_CRITICAL_SECTION
 
     // Kill all threads (NOTE: THE USER SHOULD WAIT FOR ALL THREADS TO
     // DIE, _BEFORE_ CALLING glfwTerminate()!!!)
-    t = _glfwThrd.First.Next;
-    while( t != NULL )
+    for( i = 1; i < _glfwThrd.SlotCount; i ++ )
     {
-        // Get pointer to next thread
-        t_next = t->Next;
+        t = _glfwGetThreadSlot( i );
+        if( t->ID < 0 )
+        {
+            continue;
+        }
 
         // Simply murder the process, no mercy!
         if( TerminateThread( t->Handle, 0 ) )
@@ -185,19 +192,23 @@ static void _glfwTerminateThreads( void )
             // Close thread handle
             CloseHandle( t->Handle );
 
-            // Free memory allocated for this thread
-            free( (void *) t );
+            // Release the thread record
+            _glfwFreeThread( t );
         }
-
-        // Select next thread in list
-        t = t_next;
     }
 
+    // Close the real handle of the main thread
+    CloseHandle( _glfwGetThreadSlot( 0 )->Handle );
+
+    // Free memory allocated for the thread table
+    _glfwTerminateThreadTable();
+
     // Leave critical section
     LEAVE_THREAD_CRITICAL_SECTION
 
-    // Delete critical section handle
+    // Delete critical section handle and thread record index
     DeleteCriticalSection( &_glfwThrd.CriticalSection );
+    TlsFree( _glfwThrd.TlsIndex );
 }
 
 
@@ -331,7 +342,7 @@ int _glfwPlatformInit( void )
 int _glfwPlatformTerminate( void )
 {
     // Only the main thread is allowed to do this...
-    if( GetCurrentThreadId() != _glfwThrd.First.WinID )
+    if( GetCurrentThreadId() != _glfwThrd.FirstChunk[ 0 ].WinID )
     {
         return GL_FALSE;
     }
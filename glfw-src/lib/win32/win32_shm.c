@@ -0,0 +1,163 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Win32/WGL
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+#include "internal.h"
+
+
+//************************************************************************
+//****               Platform implementation functions                ****
+//************************************************************************
+
+//========================================================================
+// Create and map a named file mapping backed by the paging file
+//========================================================================
+
+int _glfwPlatformOpenSharedMemory( _GLFWsharedmem *mem, const char *name,
+    long size )
+{
+    HANDLE mapping;
+    void *data;
+
+    // Accept POSIX style names
+    if( name[ 0 ] == '/' )
+    {
+        name ++;
+    }
+
+    mapping = CreateFileMappingA( INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                  0, (DWORD) size, name );
+    if( mapping == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    data = MapViewOfFile( mapping, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T) size );
+    if( data == NULL )
+    {
+        CloseHandle( mapping );
+        return GL_FALSE;
+    }
+
+    mem->Data = data;
+    mem->Size = size;
+    mem->Name = NULL;
+    mem->Handle = (void *) mapping;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Unmap a file mapping. It goes away with the last process using it.
+//========================================================================
+
+void _glfwPlatformCloseSharedMemory( _GLFWsharedmem *mem )
+{
+    if( mem->Data != NULL )
+    {
+        UnmapViewOfFile( mem->Data );
+        CloseHandle( (HANDLE) mem->Handle );
+    }
+
+    memset( mem, 0, sizeof(_GLFWsharedmem) );
+}
+
+
+//========================================================================
+// Map a file read-only
+//========================================================================
+
+int _glfwPlatformMapFile( _GLFWsharedmem *mem, const char *name )
+{
+    HANDLE file, mapping;
+    DWORD size;
+    void *data;
+
+    memset( mem, 0, sizeof(_GLFWsharedmem) );
+
+    file = CreateFileA( name, GENERIC_READ, FILE_SHARE_READ, NULL,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    if( file == INVALID_HANDLE_VALUE )
+    {
+        return GL_FALSE;
+    }
+
+    size = GetFileSize( file, NULL );
+    if( size == 0 || size == INVALID_FILE_SIZE )
+    {
+        CloseHandle( file );
+        return GL_FALSE;
+    }
+
+    // The mapping keeps the file open
+    mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+    CloseHandle( file );
+    if( mapping == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+    if( data == NULL )
+    {
+        CloseHandle( mapping );
+        return GL_FALSE;
+    }
+
+    mem->Data = data;
+    mem->Size = (long) size;
+    mem->Handle = (void *) mapping;
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Unmap a file mapped by _glfwPlatformMapFile
+//========================================================================
+
+void _glfwPlatformUnmapFile( _GLFWsharedmem *mem )
+{
+    _glfwPlatformCloseSharedMemory( mem );
+}
+
+
+//========================================================================
+// Order memory accesses seen by other processes
+//========================================================================
+
+void _glfwPlatformMemoryBarrier( void )
+{
+    static LONG volatile barrier;
+
+    // Interlocked functions are full barriers
+    InterlockedExchange( (LONG *) &barrier, 0 );
+}
+
@@ -65,25 +65,17 @@ typedef struct {
 
 DWORD WINAPI _glfwNewThread( LPVOID lpParam )
 {
-    GLFWthreadfun threadfun;
-    _GLFWthread   *t;
+    _GLFWthread *t = (_GLFWthread *) lpParam;
 
-    // Get pointer to thread information for current thread
-    t = _glfwGetThreadPointer( _glfwPlatformGetThreadID() );
-    if( t == NULL )
-    {
-        return 0;
-    }
-
-    // Get user thread function pointer
-    threadfun = t->Function;
+    // Remember the thread record for glfwGetThreadID
+    TlsSetValue( _glfwThrd.TlsIndex, (LPVOID) t );
 
     // Call the user thread function
-    threadfun( (void *) lpParam );
+    t->Function( t->Arg );
 
-    // Remove thread from thread list
+    // Release the thread record
     ENTER_THREAD_CRITICAL_SECTION
-    _glfwRemoveThread( t );
+    _glfwFinishThread( t );
     LEAVE_THREAD_CRITICAL_SECTION
 
     // When the thread function returns, the thread will die...
@@ -91,6 +83,26 @@ DWORD WINAPI _glfwNewThread( LPVOID lpParam )
 }
 
 
+//========================================================================
+// Find the record of a thread, including that of the calling thread
+// before its ID has been published. Must be called inside the thread
+// critical section
+//========================================================================
+
+static _GLFWthread * GetThreadRecord( GLFWthread ID )
+{
+    _GLFWthread *t;
+
+    t = (_GLFWthread *) TlsGetValue( _glfwThrd.TlsIndex );
+    if( t != NULL && _GLFW_THREAD_ID( t->Slot, t->Generation ) == ID )
+    {
+        return t;
+    }
+
+    return _glfwGetThreadPointer( ID );
+}
+
+
 
 //************************************************************************
 //****                     GLFW user functions                        ****
@@ -103,62 +115,45 @@ DWORD WINAPI _glfwNewThread( LPVOID lpParam )
 GLFWthread _glfwPlatformCreateThread( GLFWthreadfun fun, void *arg )
 {
     GLFWthread  ID;
-    _GLFWthread *t, *t_tmp;
+    _GLFWthread *t;
     HANDLE      hThread;
     DWORD       dwThreadId;
 
-    // Enter critical section
+    // Allocate a thread record
     ENTER_THREAD_CRITICAL_SECTION
-
-    // Create a new thread information memory area
-    t = (_GLFWthread *) malloc( sizeof(_GLFWthread) );
+    t = _glfwAllocThread( fun, arg );
+    LEAVE_THREAD_CRITICAL_SECTION
     if( t == NULL )
     {
-        // Leave critical section
-        LEAVE_THREAD_CRITICAL_SECTION
         return -1;
     }
 
-    // Get a new unique thread id
-    ID = _glfwThrd.NextID ++;
-
-    // Store thread information in the thread list
-    t->Function = fun;
-    t->ID       = ID;
-
     // Create thread
     hThread = CreateThread(
         NULL,              // Default security attributes
         0,                 // Default stack size (1 MB)
         _glfwNewThread,    // Thread function (a wrapper function)
-        (LPVOID)arg,       // Argument to thread is the user argument
+        (LPVOID)t,         // Argument to thread is the thread record
         0,                 // Default creation flags
         &dwThreadId        // Returned thread identifier
     );
 
+    ENTER_THREAD_CRITICAL_SECTION
+
     // Did the thread creation fail?
     if( hThread == NULL )
     {
-        free( (void *) t );
+        _glfwFreeThread( t );
         LEAVE_THREAD_CRITICAL_SECTION
         return -1;
     }
 
-    // Store more thread information in the thread list
+    // Store more thread information and make the thread visible to
+    // glfwWaitThread and glfwDestroyThread
     t->Handle = hThread;
     t->WinID  = dwThreadId;
+    ID = _glfwPublishThread( t );
 
-    // Append thread to thread list
-    t_tmp = &_glfwThrd.First;
-    while( t_tmp->Next != NULL )
-    {
-        t_tmp = t_tmp->Next;
-    }
-    t_tmp->Next = t;
-    t->Previous = t_tmp;
-    t->Next     = NULL;
-
-    // Leave critical section
     LEAVE_THREAD_CRITICAL_SECTION
 
     // Return the GLFW thread ID
@@ -192,8 +187,8 @@ void _glfwPlatformDestroyThread( GLFWthread ID )
         // Close thread handle
         CloseHandle( t->Handle );
 
-        // Remove thread from thread list
-        _glfwRemoveThread( t );
+        // Release the thread record
+        _glfwFreeThread( t );
     }
 
     // Leave critical section
@@ -211,24 +206,23 @@ int _glfwPlatformWaitThread( GLFWthread ID, int waitmode )
     HANDLE      hThread;
     _GLFWthread *t;
 
-    // Enter critical section
-    ENTER_THREAD_CRITICAL_SECTION
-
     // Get thread information pointer
     t = _glfwGetThreadPointer( ID );
 
     // Is the thread already dead?
     if( t == NULL )
     {
-        LEAVE_THREAD_CRITICAL_SECTION
         return GL_TRUE;
     }
 
-    // Get thread handle
+    // Get thread handle, and make sure the record was not reused for
+    // another thread while reading it
     hThread = t->Handle;
-
-    // Leave critical section
-    LEAVE_THREAD_CRITICAL_SECTION
+    _glfwPlatformMemoryBarrier();
+    if( t->ID != ID )
+    {
+        return GL_TRUE;
+    }
 
     // Wait for thread to die
     if( waitmode == GLFW_WAIT )
@@ -260,31 +254,169 @@ int _glfwPlatformWaitThread( GLFWthread ID, int waitmode )
 GLFWthread _glfwPlatformGetThreadID( void )
 {
     _GLFWthread *t;
-    GLFWthread  ID = -1;
-    DWORD       WinID;
 
-    // Get Windows thread ID
-    WinID = GetCurrentThreadId();
+    // Get the thread record of this thread
+    t = (_GLFWthread *) TlsGetValue( _glfwThrd.TlsIndex );
+    if( t == NULL )
+    {
+        return -1;
+    }
+
+    // The record may not have been published yet, so build the ID
+    return _GLFW_THREAD_ID( t->Slot, t->Generation );
+}
+
+
+//========================================================================
+// Restrict a thread to the processors in a mask
+//========================================================================
+
+int _glfwPlatformSetThreadAffinity( GLFWthread ID, unsigned int mask )
+{
+    _GLFWthread *t;
+    int         result = GL_FALSE;
 
-    // Enter critical section (to avoid an inconsistent thread list)
     ENTER_THREAD_CRITICAL_SECTION
+    t = GetThreadRecord( ID );
+    if( t != NULL && SetThreadAffinityMask( t->Handle, mask ) != 0 )
+    {
+        result = GL_TRUE;
+    }
+    LEAVE_THREAD_CRITICAL_SECTION
 
-    // Loop through entire list of threads to find the matching Windows
-    // thread ID
-    for( t = &_glfwThrd.First; t != NULL; t = t->Next )
+    return result;
+}
+
+
+//========================================================================
+// Change the scheduling priority of a thread
+//========================================================================
+
+int _glfwPlatformSetThreadPriority( GLFWthread ID, int priority )
+{
+    _GLFWthread *t;
+    int         level, result = GL_FALSE;
+
+    switch( priority )
     {
-        if( t->WinID == WinID )
-        {
-            ID = t->ID;
+        case GLFW_THREAD_PRIORITY_LOW:
+            level = THREAD_PRIORITY_BELOW_NORMAL;
+            break;
+        case GLFW_THREAD_PRIORITY_HIGH:
+            level = THREAD_PRIORITY_HIGHEST;
+            break;
+        case GLFW_THREAD_PRIORITY_REALTIME:
+            level = THREAD_PRIORITY_TIME_CRITICAL;
+            break;
+        default:
+            level = THREAD_PRIORITY_NORMAL;
             break;
-        }
     }
 
-    // Leave critical section
+    ENTER_THREAD_CRITICAL_SECTION
+    t = GetThreadRecord( ID );
+    if( t != NULL && SetThreadPriority( t->Handle, level ) )
+    {
+        result = GL_TRUE;
+    }
     LEAVE_THREAD_CRITICAL_SECTION
 
-    // Return the found GLFW thread identifier
-    return ID;
+    return result;
+}
+
+
+//========================================================================
+// Name a thread for debuggers and profilers. SetThreadDescription is
+// only available on Windows 10 and later, so it is looked up at runtime
+//========================================================================
+
+typedef HRESULT (WINAPI * SETTHREADDESCRIPTION_T)( HANDLE, const WCHAR * );
+
+int _glfwPlatformSetThreadName( GLFWthread ID, const char *name )
+{
+    SETTHREADDESCRIPTION_T setThreadDescription;
+    _GLFWthread *t;
+    WCHAR       *wideName;
+    int         length, result = GL_FALSE;
+
+    setThreadDescription = (SETTHREADDESCRIPTION_T)
+        GetProcAddress( GetModuleHandleA( "kernel32.dll" ),
+                        "SetThreadDescription" );
+    if( setThreadDescription == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    length = MultiByteToWideChar( CP_UTF8, 0, name, -1, NULL, 0 );
+    if( length == 0 )
+    {
+        return GL_FALSE;
+    }
+
+    wideName = (WCHAR *) malloc( length * sizeof( WCHAR ) );
+    if( wideName == NULL )
+    {
+        return GL_FALSE;
+    }
+    MultiByteToWideChar( CP_UTF8, 0, name, -1, wideName, length );
+
+    ENTER_THREAD_CRITICAL_SECTION
+    t = GetThreadRecord( ID );
+    if( t != NULL && SUCCEEDED( setThreadDescription( t->Handle, wideName ) ) )
+    {
+        result = GL_TRUE;
+    }
+    LEAVE_THREAD_CRITICAL_SECTION
+
+    free( wideName );
+    return result;
+}
+
+
+//========================================================================
+// Get the CPU time of a thread. Windows has no per-thread context switch
+// counts short of NtQuerySystemInformation, so they are left unknown
+//========================================================================
+
+int _glfwPlatformGetThreadStats( GLFWthread ID, GLFWthreadstats *stats )
+{
+    _GLFWthread *t;
+    HANDLE      handle;
+    FILETIME    creationTime, exitTime, kernelTime, userTime;
+
+    ENTER_THREAD_CRITICAL_SECTION
+
+    t = GetThreadRecord( ID );
+    if( t == NULL )
+    {
+        LEAVE_THREAD_CRITICAL_SECTION
+        return GL_FALSE;
+    }
+
+    stats->CreationTime = t->CreationTime;
+    stats->RunTime      = _glfwGetSteadyTime() - t->StartTime;
+
+    // The handle of the calling thread may not have been stored yet
+    handle = t->Handle;
+    if( t == (_GLFWthread *) TlsGetValue( _glfwThrd.TlsIndex ) )
+    {
+        handle = GetCurrentThread();
+    }
+
+    // Kernel and user times are in units of 100 nanoseconds
+    if( GetThreadTimes( handle, &creationTime, &exitTime,
+                        &kernelTime, &userTime ) )
+    {
+        stats->CPUTime =
+            ((double) kernelTime.dwHighDateTime * 4294967296.0 +
+             (double) kernelTime.dwLowDateTime +
+             (double) userTime.dwHighDateTime * 4294967296.0 +
+             (double) userTime.dwLowDateTime) * 1e-7;
+    }
+
+    LEAVE_THREAD_CRITICAL_SECTION
+
+    return GL_TRUE;
 }
 
 
@@ -448,6 +580,30 @@ void _glfwPlatformWaitCond( GLFWcond cond, GLFWmutex mutex, double timeout )
 }
 
 
+//========================================================================
+// Wait for a condition to be raised or the timer to reach a given value
+//========================================================================
+
+void _glfwPlatformWaitCondUntil( GLFWcond cond, GLFWmutex mutex,
+                                 double time )
+{
+    double timeout = GLFW_INFINITY;
+
+    // Turn the timer value into a timeout, as the system waits only
+    // support those
+    if( time < GLFW_INFINITY )
+    {
+        timeout = time - _glfwPlatformGetTime();
+        if( timeout < 0.0 )
+        {
+            timeout = 0.0;
+        }
+    }
+
+    _glfwPlatformWaitCond( cond, mutex, timeout );
+}
+
+
 //========================================================================
 // Signal a condition to one waiting thread
 //========================================================================
@@ -504,3 +660,184 @@ int _glfwPlatformGetNumberOfProcessors( void )
     return (int) si.dwNumberOfProcessors;
 }
 
+
+//========================================================================
+// Describe the processors this process may use. The affinity mask of the
+// process limits the usable processors, and GetLogicalProcessorInformation
+// (Windows XP SP3 and later, so it is looked up at runtime) tells which
+// of them share a core or a cache. The structure is declared here as old
+// <windows.h>'s do not have it
+//========================================================================
+
+#define _GLFW_RELATION_PROCESSOR_CORE 0
+#define _GLFW_RELATION_CACHE          2
+
+typedef struct {
+    ULONG_PTR ProcessorMask;
+    DWORD     Relationship;
+    union {
+        struct {
+            BYTE  Level;
+            BYTE  Associativity;
+            WORD  LineSize;
+            DWORD Size;
+            DWORD Type;
+        } Cache;
+        ULONGLONG Reserved[ 2 ];
+    } Info;
+} _GLFWprocessorinfo;
+
+typedef BOOL (WINAPI * GETLOGICALPROCESSORINFORMATION_T)( _GLFWprocessorinfo *, DWORD * );
+
+int _glfwPlatformGetCPUTopology( GLFWcputopology *topology )
+{
+    GETLOGICALPROCESSORINFORMATION_T getLogicalProcessorInformation;
+    _GLFWprocessorinfo *info;
+    DWORD_PTR          processMask, systemMask;
+    DWORD              size;
+    unsigned int       mask;
+    int                i, count, *groupCount;
+    unsigned int       *groupMasks;
+
+    topology->OnlineCount = _glfwPlatformGetNumberOfProcessors();
+    topology->UsableCount = topology->OnlineCount;
+
+    // Find the processors in the affinity mask of the process
+    if( GetProcessAffinityMask( GetCurrentProcess(), &processMask,
+                                &systemMask ) )
+    {
+        topology->UsableMask = (unsigned int) processMask;
+        for( count = 0; processMask != 0; processMask >>= 1 )
+        {
+            count += (int) (processMask & 1);
+        }
+        topology->UsableCount = count;
+    }
+    else
+    {
+        for( i = 0; i < topology->OnlineCount && i < 32; i ++ )
+        {
+            topology->UsableMask |= 1U << i;
+        }
+    }
+
+    // Without topology information, every processor is a core
+    topology->CoreCount = topology->UsableCount;
+
+    getLogicalProcessorInformation = (GETLOGICALPROCESSORINFORMATION_T)
+        GetProcAddress( GetModuleHandleA( "kernel32.dll" ),
+                        "GetLogicalProcessorInformation" );
+    if( getLogicalProcessorInformation == NULL )
+    {
+        return GL_TRUE;
+    }
+
+    size = 0;
+    getLogicalProcessorInformation( NULL, &size );
+    info = (_GLFWprocessorinfo *) malloc( size );
+    if( info == NULL )
+    {
+        return GL_TRUE;
+    }
+
+    if( !getLogicalProcessorInformation( info, &size ) )
+    {
+        free( info );
+        return GL_TRUE;
+    }
+
+    // Each entry describes one core or cache and the processors in it;
+    // only the ones with usable processors are counted
+    topology->CoreCount = 0;
+    for( i = 0; i < (int) (size / sizeof( _GLFWprocessorinfo )); i ++ )
+    {
+        mask = (unsigned int) info[ i ].ProcessorMask & topology->UsableMask;
+        if( mask == 0 )
+        {
+            continue;
+        }
+
+        if( info[ i ].Relationship == _GLFW_RELATION_PROCESSOR_CORE )
+        {
+            groupCount = &topology->CoreCount;
+            groupMasks = topology->CoreMasks;
+        }
+        else if( info[ i ].Relationship == _GLFW_RELATION_CACHE &&
+                 info[ i ].Info.Cache.Level == 2 )
+        {
+            groupCount = &topology->L2GroupCount;
+            groupMasks = topology->L2Masks;
+        }
+        else if( info[ i ].Relationship == _GLFW_RELATION_CACHE &&
+                 info[ i ].Info.Cache.Level == 3 )
+        {
+            groupCount = &topology->L3GroupCount;
+            groupMasks = topology->L3Masks;
+        }
+        else
+        {
+            continue;
+        }
+
+        if( *groupCount < GLFW_MAX_CPU_GROUPS )
+        {
+            groupMasks[ *groupCount ] = mask;
+        }
+        (*groupCount) ++;
+    }
+
+    if( topology->CoreCount == 0 )
+    {
+        topology->CoreCount = topology->UsableCount;
+    }
+
+    free( info );
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Atomically add to an integer and return the new value
+//========================================================================
+
+int _glfwPlatformAtomicAdd( volatile int *value, int delta )
+{
+    return (int) InterlockedExchangeAdd( (LONG volatile *) value,
+                                         (LONG) delta ) + delta;
+}
+
+
+//========================================================================
+// Atomically replace an integer if it still has the expected value
+//========================================================================
+
+int _glfwPlatformAtomicCompareAndSwap( volatile int *value, int expected,
+                                       int desired )
+{
+    return InterlockedCompareExchange( (LONG volatile *) value,
+                                       (LONG) desired,
+                                       (LONG) expected ) == (LONG) expected ?
+           GL_TRUE : GL_FALSE;
+}
+
+
+//========================================================================
+// Sleep while an integer still has the given value. Windows has no such
+// wait before Windows 8, so callers fall back on a condition variable
+//========================================================================
+
+int _glfwPlatformWaitAddress( volatile int *address, int value,
+                              double timeout )
+{
+    return GL_FALSE;
+}
+
+
+//========================================================================
+// Wake threads sleeping on an integer (see _glfwPlatformWaitAddress)
+//========================================================================
+
+int _glfwPlatformWakeAddress( volatile int *address, int count )
+{
+    return GL_FALSE;
+}
@@ -0,0 +1,77 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Win32/WGL
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+#include "internal.h"
+
+
+//************************************************************************
+//****               Platform implementation functions                ****
+//************************************************************************
+
+// There is no file system watcher on this platform yet, so hot reloading
+// polls the modification times of watched files instead
+
+//========================================================================
+// Create a file system watcher
+//========================================================================
+
+int _glfwPlatformCreateWatcher( void )
+{
+    return -1;
+}
+
+
+//========================================================================
+// Destroy a file system watcher
+//========================================================================
+
+void _glfwPlatformDestroyWatcher( int watcher )
+{
+}
+
+
+//========================================================================
+// Watch a directory for changed files
+//========================================================================
+
+int _glfwPlatformWatchDirectory( int watcher, const char *path )
+{
+    return -1;
+}
+
+
+//========================================================================
+// Wait for changes and report them
+//========================================================================
+
+int _glfwPlatformWaitWatcher( int watcher, double timeout, _GLFWwatchfun fun )
+{
+    return -1;
+}
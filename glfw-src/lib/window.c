@@ -681,6 +681,12 @@ GLFWAPI void GLFWAPIENTRY glfwCloseWindow( void )
     // Show mouse pointer again (if hidden)
     glfwEnable( GLFW_MOUSE_CURSOR );
 
+    // Deliver pending frame captures while the context is still there
+    _glfwTerminateCapture();
+
+    // Pending texture streams and memory records die with the context
+    _glfwClearTextures();
+
     _glfwPlatformCloseWindow();
 
     memset( &_glfwWin, 0, sizeof(_glfwWin) );
@@ -814,8 +820,14 @@ GLFWAPI void GLFWAPIENTRY glfwSwapBuffers( void )
         return;
     }
 
+    // Read back the finished frame if it is being recorded
+    _glfwRecordFrame();
+
     _glfwPlatformSwapBuffers();
 
+    // Deliver frame captures whose read-back has completed
+    _glfwServiceCaptures();
+
     // Check for window messages
     if( _glfwWin.autoPollEvents )
     {
@@ -53,6 +53,18 @@
  #include <sched.h>
 #endif
 
+// Linux futexes for GLFW_FUTEX_SYNC mutexes and their condition variables
+#if defined( _GLFW_HAS_PTHREAD ) && defined( _GLFW_HAS_FUTEX )
+ #include <linux/futex.h>
+ #include <sys/syscall.h>
+#endif
+
+// Kernel thread IDs, for per-thread nice values on Linux
+#if defined( _GLFW_HAS_PTHREAD ) && defined( _GLFW_HAS_GETTID )
+ #include <sys/syscall.h>
+ #include <sys/resource.h>
+#endif
+
 // We need declarations for GLX version 1.3 or above even if the server doesn't
 // support version 1.3
 #ifndef GLX_VERSION_1_3
@@ -414,12 +426,20 @@ struct _GLFWthread_struct {
 
 // ========= PLATFORM INDEPENDENT MANDATORY PART =========================
 
-    // Pointer to previous and next threads in linked list
-    _GLFWthread   *Previous, *Next;
-
-    // GLFW user side thread information
-    GLFWthread    ID;
+    // GLFW user side thread information (ID is -1 while the record is
+    // unused or the thread is still being created)
+    volatile GLFWthread ID;
     GLFWthreadfun Function;
+    void          *Arg;
+
+    // Position in the thread table
+    int           Slot, Generation, NextFree;
+    int           Finished;
+
+    // Time of creation, in glfwGetTime time and on the clock that
+    // glfwSetTime does not move (for measuring how long it has run)
+    double        CreationTime;
+    double        StartTime;
 
 // ========= PLATFORM SPECIFIC PART ======================================
 
@@ -428,6 +448,54 @@ struct _GLFWthread_struct {
     pthread_t     PosixID;
 #endif
 
+    // Kernel thread ID (zero until the thread has started running)
+#ifdef _GLFW_HAS_GETTID
+    volatile pid_t KernelID;
+#endif
+
+};
+
+
+//------------------------------------------------------------------------
+// Mutex or condition variable object (allocated from fixed size chunks)
+//------------------------------------------------------------------------
+#define _GLFW_SYNC_CHUNK_SIZE 64
+
+#define _GLFW_SYNC_MUTEX       1
+#define _GLFW_SYNC_COND        2
+#define _GLFW_SYNC_FUTEX_MUTEX 3
+#define _GLFW_SYNC_FUTEX_COND  4
+#define _GLFW_SYNC_NEW_COND    5
+
+typedef struct _GLFWsync_struct _GLFWsync;
+
+struct _GLFWsync_struct {
+    int           Type;
+    union {
+        _GLFWsync *NextFree;
+#ifdef _GLFW_HAS_PTHREAD
+        pthread_mutex_t Mutex;
+        pthread_cond_t  Cond;
+#endif
+        // Futex mutex state is 0 when unlocked, 1 when locked and 2 when
+        // locked with waiters; Spin is the adaptive spin estimate
+        struct {
+            volatile int State;
+            int          Spin;
+        } FutexMutex;
+        // Futex condition variables wait for Sequence to change
+        struct {
+            volatile int Sequence;
+            volatile int Waiters;
+        } FutexCond;
+    } u;
+};
+
+typedef struct _GLFWsyncchunk_struct _GLFWsyncchunk;
+
+struct _GLFWsyncchunk_struct {
+    _GLFWsyncchunk *Next;
+    _GLFWsync      Objects[ _GLFW_SYNC_CHUNK_SIZE ];
 };
 
 
@@ -438,19 +506,31 @@ GLFWGLOBAL struct {
 
 // ========= PLATFORM INDEPENDENT MANDATORY PART =========================
 
-    // Next thread ID to use (increments for every created thread)
-    GLFWthread       NextID;
+    // Thread table chunks (the first chunk is static, and its first
+    // record is always the main thread)
+    _GLFWthread      FirstChunk[ _GLFW_THREAD_CHUNK_SIZE ];
+    _GLFWthread      *Chunks[ _GLFW_THREAD_CHUNKS ];
 
-    // First thread in linked list (always the main thread)
-    _GLFWthread      First;
+    // Number of slots in use and head of the free slot list
+    volatile int     SlotCount;
+    int              FirstFree;
 
 // ========= PLATFORM SPECIFIC PART ======================================
 
-    // Critical section lock
+    // Critical section lock and thread record of the current thread
 #ifdef _GLFW_HAS_PTHREAD
     pthread_mutex_t  CriticalSection;
+    pthread_key_t    Key;
 #endif
 
+    // Mutex and condition variable chunks and free objects, the longest
+    // a futex mutex may spin before it sleeps and whether timed waits use
+    // the monotonic clock
+    _GLFWsyncchunk   *SyncChunks;
+    _GLFWsync        *FreeSync;
+    int              SpinLimit;
+    int              CondMonotonic;
+
 } _glfwThrd;
 
 
@@ -497,6 +577,14 @@ void _glfwSetVideoModeMODE( int screen, int mode, int rate );
 void _glfwSetVideoMode( int screen, int *width, int *height, int *rate );
 void _glfwRestoreVideoMode( void );
 
+// Mutex and condition variable objects
+void _glfwInitSyncObjects( void );
+void _glfwTerminateSyncObjects( void );
+#ifdef _GLFW_HAS_PTHREAD
+void _glfwInitCond( pthread_cond_t *cond );
+void _glfwGetCondDeadline( double timeout, struct timespec *deadline );
+#endif
+
 // Joystick input
 void _glfwInitJoysticks( void );
 void _glfwTerminateJoysticks( void );
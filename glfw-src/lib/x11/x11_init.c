@@ -42,22 +42,26 @@
 
 static void initThreads( void )
 {
-    // Initialize critical section handle
+    _GLFWthread *t;
+
+    // Initialize critical section handle and thread record key
 #ifdef _GLFW_HAS_PTHREAD
     (void) pthread_mutex_init( &_glfwThrd.CriticalSection, NULL );
+    (void) pthread_key_create( &_glfwThrd.Key, NULL );
 #endif
 
-    // The first thread (the main thread) has ID 0
-    _glfwThrd.NextID = 0;
-
-    // Fill out information about the main thread (this thread)
-    _glfwThrd.First.ID       = _glfwThrd.NextID++;
-    _glfwThrd.First.Function = NULL;
-    _glfwThrd.First.Previous = NULL;
-    _glfwThrd.First.Next     = NULL;
+    // Fill out information about the main thread (this thread), which
+    // always has ID 0
+    t = _glfwInitThreadTable();
 #ifdef _GLFW_HAS_PTHREAD
-    _glfwThrd.First.PosixID  = pthread_self();
+    t->PosixID = pthread_self();
+    pthread_setspecific( _glfwThrd.Key, t );
 #endif
+#ifdef _GLFW_HAS_GETTID
+    t->KernelID = (pid_t) syscall( SYS_gettid );
+#endif
+
+    _glfwInitSyncObjects();
 }
 
 
@@ -69,34 +73,36 @@ static void terminateThreads( void )
 {
 #ifdef _GLFW_HAS_PTHREAD
 
-    _GLFWthread *t, *t_next;
+    _GLFWthread *t;
+    int         i;
 
     // Enter critical section
     ENTER_THREAD_CRITICAL_SECTION
 
     // Kill all threads (NOTE: THE USER SHOULD WAIT FOR ALL THREADS TO
     // DIE, _BEFORE_ CALLING glfwTerminate()!!!)
-    t = _glfwThrd.First.Next;
-    while( t != NULL )
+    for( i = 1; i < _glfwThrd.SlotCount; i ++ )
     {
-        // Get pointer to next thread
-        t_next = t->Next;
-
-        // Simply murder the process, no mercy!
-        pthread_kill( t->PosixID, SIGKILL );
-
-        // Free memory allocated for this thread
-        free( (void *) t );
-
-        // Select next thread in list
-        t = t_next;
+        t = _glfwGetThreadSlot( i );
+        if( t->ID >= 0 )
+        {
+            // Simply murder the process, no mercy!
+            pthread_kill( t->PosixID, SIGKILL );
+            _glfwFreeThread( t );
+        }
     }
 
+    // Free memory allocated for the thread table and for mutexes and
+    // condition variables
+    _glfwTerminateThreadTable();
+    _glfwTerminateSyncObjects();
+
     // Leave critical section
     LEAVE_THREAD_CRITICAL_SECTION
 
-    // Delete critical section handle
+    // Delete critical section handle and thread record key
     pthread_mutex_destroy( &_glfwThrd.CriticalSection );
+    pthread_key_delete( _glfwThrd.Key );
 
 #endif // _GLFW_HAS_PTHREAD
 }
@@ -256,7 +262,7 @@ int _glfwPlatformTerminate( void )
 {
 #ifdef _GLFW_HAS_PTHREAD
     // Only the main thread is allowed to do this...
-    if( pthread_self() != _glfwThrd.First.PosixID )
+    if( pthread_self() != _glfwThrd.FirstChunk[ 0 ].PosixID )
     {
         return GL_FALSE;
     }
@@ -28,66 +28,875 @@
 //
 //========================================================================
 
+// pthread_setaffinity_np, pthread_setname_np and RUSAGE_THREAD are GNU
+// extensions
+#if defined( _GLFW_HAS_PTHREAD_SETAFFINITY ) || \
+    defined( _GLFW_HAS_PTHREAD_SETNAME ) || defined( _GLFW_HAS_GETTID )
+ #define _GNU_SOURCE
+#endif
+
 #include "internal.h"
 
+#include <limits.h>
+#include <time.h>
+
+
+
+//************************************************************************
+//****                  GLFW internal functions                       ****
+//************************************************************************
+
+#ifdef _GLFW_HAS_PTHREAD
+
+//========================================================================
+// This is simply a "wrapper" for calling the user thread function. The
+// argument is the thread record allocated by _glfwPlatformCreateThread.
+//========================================================================
+
+void * _glfwNewThread( void * arg )
+{
+    _GLFWthread *t = (_GLFWthread *) arg;
+
+    // Remember the thread record for glfwGetThreadID
+    pthread_setspecific( _glfwThrd.Key, t );
+
+#ifdef _GLFW_HAS_GETTID
+    // Make the kernel thread ID known to glfwSetThreadPriority
+    t->KernelID = (pid_t) syscall( SYS_gettid );
+#endif
+
+    // Call the user thread function
+    t->Function( t->Arg );
+
+    // Release the thread record
+    ENTER_THREAD_CRITICAL_SECTION
+    _glfwFinishThread( t );
+    LEAVE_THREAD_CRITICAL_SECTION
+
+    // When the thread function returns, the thread will die...
+    return NULL;
+}
+
+
+//========================================================================
+// Find the record of a thread, including that of the calling thread
+// before its ID has been published. Must be called inside the thread
+// critical section
+//========================================================================
+
+static _GLFWthread * GetThreadRecord( GLFWthread ID )
+{
+    _GLFWthread *t;
+
+    t = (_GLFWthread *) pthread_getspecific( _glfwThrd.Key );
+    if( t != NULL && _GLFW_THREAD_ID( t->Slot, t->Generation ) == ID )
+    {
+        return t;
+    }
+
+    return _glfwGetThreadPointer( ID );
+}
+
+
+//========================================================================
+// Allocate a mutex or condition variable object from the free list,
+// adding a new chunk of objects when the list is empty
+//========================================================================
+
+static _GLFWsync * AllocSync( int type )
+{
+    _GLFWsyncchunk *chunk;
+    _GLFWsync      *s;
+    int            i;
+
+    ENTER_THREAD_CRITICAL_SECTION
+
+    if( !_glfwThrd.FreeSync )
+    {
+        chunk = (_GLFWsyncchunk *) malloc( sizeof( _GLFWsyncchunk ) );
+        if( !chunk )
+        {
+            LEAVE_THREAD_CRITICAL_SECTION
+            return NULL;
+        }
+
+        chunk->Next = _glfwThrd.SyncChunks;
+        _glfwThrd.SyncChunks = chunk;
+
+        for( i = _GLFW_SYNC_CHUNK_SIZE - 1; i >= 0; i -- )
+        {
+            chunk->Objects[ i ].Type = 0;
+            chunk->Objects[ i ].u.NextFree = _glfwThrd.FreeSync;
+            _glfwThrd.FreeSync = &chunk->Objects[ i ];
+        }
+    }
+
+    s = _glfwThrd.FreeSync;
+    _glfwThrd.FreeSync = s->u.NextFree;
+    s->Type = type;
+
+    LEAVE_THREAD_CRITICAL_SECTION
+
+    return s;
+}
+
+
+//========================================================================
+// Return a mutex or condition variable object to the free list
+//========================================================================
+
+static void FreeSync( _GLFWsync *s )
+{
+    ENTER_THREAD_CRITICAL_SECTION
+
+    s->Type = 0;
+    s->u.NextFree = _glfwThrd.FreeSync;
+    _glfwThrd.FreeSync = s;
+
+    LEAVE_THREAD_CRITICAL_SECTION
+}
+
+
+//========================================================================
+// Read the clock that condition variable deadlines are measured on
+//========================================================================
+
+static void GetCondClock( struct timespec *now )
+{
+    struct timeval tv;
+
+#if defined( _POSIX_CLOCK_SELECTION ) && defined( _POSIX_MONOTONIC_CLOCK )
+    if( _glfwThrd.CondMonotonic )
+    {
+        clock_gettime( CLOCK_MONOTONIC, now );
+        return;
+    }
+#endif
+
+    gettimeofday( &tv, NULL );
+    now->tv_sec = tv.tv_sec;
+    now->tv_nsec = tv.tv_usec * 1000L;
+}
+
+
+//========================================================================
+// Compute the deadline for a wait of the given number of seconds
+//========================================================================
+
+void _glfwGetCondDeadline( double timeout, struct timespec *deadline )
+{
+    long long nsec;
+
+    if( timeout < 0.0 )
+    {
+        timeout = 0.0;
+    }
+
+    nsec = (long long) (timeout * 1e9);
+
+    GetCondClock( deadline );
+    deadline->tv_sec += (time_t) (nsec / 1000000000LL);
+    deadline->tv_nsec += (long) (nsec % 1000000000LL);
+    if( deadline->tv_nsec >= 1000000000L )
+    {
+        deadline->tv_nsec -= 1000000000L;
+        deadline->tv_sec ++;
+    }
+}
+
+
+//========================================================================
+// Initialize a POSIX condition variable that measures timeouts on the
+// clock used by _glfwGetCondDeadline
+//========================================================================
+
+void _glfwInitCond( pthread_cond_t *cond )
+{
+#if defined( _POSIX_CLOCK_SELECTION ) && defined( _POSIX_MONOTONIC_CLOCK )
+    pthread_condattr_t attr;
+
+    if( _glfwThrd.CondMonotonic )
+    {
+        (void) pthread_condattr_init( &attr );
+        (void) pthread_condattr_setclock( &attr, CLOCK_MONOTONIC );
+        (void) pthread_cond_init( cond, &attr );
+        (void) pthread_condattr_destroy( &attr );
+        return;
+    }
+#endif
+
+    (void) pthread_cond_init( cond, NULL );
+}
+
+
+//========================================================================
+// Compute the deadline for a wait on a given GLFW timer value
+//========================================================================
+
+static void GetTimerDeadline( double time, struct timespec *deadline )
+{
+    long long raw;
+
+#if defined( _POSIX_TIMERS ) && defined( _POSIX_MONOTONIC_CLOCK )
+    // When both use the monotonic clock, the deadline is simply the raw
+    // timer value, which avoids the drift of a relative wait
+    if( _glfwThrd.CondMonotonic && _glfwLibrary.Timer.monotonic )
+    {
+        raw = _glfwLibrary.Timer.base + (long long) (time * 1e9);
+        if( raw < 0 )
+        {
+            raw = 0;
+        }
+
+        deadline->tv_sec = (time_t) (raw / 1000000000LL);
+        deadline->tv_nsec = (long) (raw % 1000000000LL);
+        return;
+    }
+#endif
+
+    _glfwGetCondDeadline( time - _glfwPlatformGetTime(), deadline );
+}
+
+
+#ifdef _GLFW_HAS_FUTEX
+
+#ifndef FUTEX_PRIVATE_FLAG
+ #define FUTEX_WAIT_PRIVATE FUTEX_WAIT
+ #define FUTEX_WAKE_PRIVATE FUTEX_WAKE
+#endif
+
+// Upper bound on the adaptive spin of a contended futex mutex
+#define _GLFW_FUTEX_SPIN_LIMIT 100
+
+#if defined(__GNUC__) && ( defined(__i386__) || defined(__x86_64__) )
+ #define _GLFW_SPIN_PAUSE() __asm__ __volatile__ ( "pause" )
+#else
+ #define _GLFW_SPIN_PAUSE() _glfwPlatformMemoryBarrier()
+#endif
+
+//========================================================================
+// Sleep while a futex word still has the given value
+//========================================================================
+
+static void FutexWait( volatile int *word, int value,
+                       const struct timespec *timeout )
+{
+    (void) syscall( SYS_futex, (int *) word, FUTEX_WAIT_PRIVATE, value,
+                    timeout, NULL, 0 );
+}
+
+
+//========================================================================
+// Wake up to count threads sleeping on a futex word
+//========================================================================
+
+static void FutexWake( volatile int *word, int count )
+{
+    (void) syscall( SYS_futex, (int *) word, FUTEX_WAKE_PRIVATE, count,
+                    NULL, NULL, 0 );
+}
+
+
+//========================================================================
+// Atomically replace an integer and return its previous value
+//========================================================================
+
+static int FutexExchange( volatile int *word, int value )
+{
+    int old;
+
+    do
+    {
+        old = *word;
+    }
+    while( !_glfwPlatformAtomicCompareAndSwap( word, old, value ) );
+
+    return old;
+}
+
+
+//========================================================================
+// Lock a futex mutex, spinning for a while before going to sleep when
+// the mutex is contended. The spin is bounded by an estimate of how long
+// earlier lock attempts had to spin, so that mutexes held for long
+// periods quickly stop wasting processor time
+//========================================================================
+
+static void LockFutexMutex( _GLFWsync *m )
+{
+    volatile int *state = &m->u.FutexMutex.State;
+    int i, limit;
+
+    // Uncontended case
+    if( _glfwPlatformAtomicCompareAndSwap( state, 0, 1 ) )
+    {
+        return;
+    }
+
+    limit = m->u.FutexMutex.Spin * 2 + 10;
+    if( limit > _glfwThrd.SpinLimit )
+    {
+        limit = _glfwThrd.SpinLimit;
+    }
+
+    for( i = 0; i < limit; i ++ )
+    {
+        _GLFW_SPIN_PAUSE();
+
+        if( *state == 0 && _glfwPlatformAtomicCompareAndSwap( state, 0, 1 ) )
+        {
+            m->u.FutexMutex.Spin += (i - m->u.FutexMutex.Spin) / 8;
+            return;
+        }
+    }
+
+    m->u.FutexMutex.Spin += (limit - m->u.FutexMutex.Spin) / 8;
+
+    // Mark the mutex as having waiters and sleep until it is released
+    while( FutexExchange( state, 2 ) != 0 )
+    {
+        FutexWait( state, 2, NULL );
+    }
+}
+
+
+//========================================================================
+// Unlock a futex mutex, waking one sleeping thread if there are any
+//========================================================================
+
+static void UnlockFutexMutex( _GLFWsync *m )
+{
+    if( _glfwPlatformAtomicAdd( &m->u.FutexMutex.State, -1 ) != 0 )
+    {
+        m->u.FutexMutex.State = 0;
+        FutexWake( &m->u.FutexMutex.State, 1 );
+    }
+}
+
+
+//========================================================================
+// Compute the time left until a deadline, or zero if it has passed
+//========================================================================
+
+static void GetTimeLeft( const struct timespec *deadline,
+                         struct timespec *left )
+{
+    GetCondClock( left );
+    left->tv_sec = deadline->tv_sec - left->tv_sec;
+    left->tv_nsec = deadline->tv_nsec - left->tv_nsec;
+    if( left->tv_nsec < 0 )
+    {
+        left->tv_nsec += 1000000000L;
+        left->tv_sec --;
+    }
+    if( left->tv_sec < 0 )
+    {
+        left->tv_sec = 0;
+        left->tv_nsec = 0;
+    }
+}
+
+
+//========================================================================
+// Wait on a futex condition variable until its sequence number changes
+// or the deadline passes. This only needs to release and reacquire the
+// mutex, so it works with both kinds of mutex
+//========================================================================
+
+static void WaitFutexCond( _GLFWsync *c, GLFWmutex mutex,
+                           const struct timespec *deadline )
+{
+    struct timespec wait;
+    int sequence;
+
+    _glfwPlatformAtomicAdd( &c->u.FutexCond.Waiters, 1 );
+    sequence = c->u.FutexCond.Sequence;
+
+    _glfwPlatformUnlockMutex( mutex );
+
+    if( !deadline )
+    {
+        FutexWait( &c->u.FutexCond.Sequence, sequence, NULL );
+    }
+    else
+    {
+        // Futex timeouts are relative to the time of the call
+        GetTimeLeft( deadline, &wait );
+        FutexWait( &c->u.FutexCond.Sequence, sequence, &wait );
+    }
+
+    _glfwPlatformAtomicAdd( &c->u.FutexCond.Waiters, -1 );
+
+    _glfwPlatformLockMutex( mutex );
+}
+
+
+//========================================================================
+// Wake up to count threads waiting on a futex condition variable
+//========================================================================
+
+static void WakeFutexCond( _GLFWsync *c, int count )
+{
+    _glfwPlatformAtomicAdd( &c->u.FutexCond.Sequence, 1 );
+
+    // Skip the system call when nobody is waiting
+    if( c->u.FutexCond.Waiters > 0 )
+    {
+        FutexWake( &c->u.FutexCond.Sequence, count );
+    }
+}
+
+
+//========================================================================
+// Give a new condition variable the backend of the first mutex it is
+// waited with, so that GLFW_FUTEX_SYNC selects the condition variables
+// used with its mutexes as well
+//========================================================================
+
+static void BindCond( _GLFWsync *c, _GLFWsync *m )
+{
+    ENTER_THREAD_CRITICAL_SECTION
+
+    if( c->Type == _GLFW_SYNC_NEW_COND )
+    {
+        if( m->Type == _GLFW_SYNC_FUTEX_MUTEX )
+        {
+            c->u.FutexCond.Sequence = 0;
+            c->u.FutexCond.Waiters = 0;
+        }
+        else
+        {
+            _glfwInitCond( &c->u.Cond );
+        }
+
+        // Signalling threads look at the type without locking
+        _glfwPlatformMemoryBarrier();
+        c->Type = m->Type == _GLFW_SYNC_FUTEX_MUTEX ?
+                  _GLFW_SYNC_FUTEX_COND : _GLFW_SYNC_COND;
+    }
+
+    LEAVE_THREAD_CRITICAL_SECTION
+}
+
+
+//========================================================================
+// Release a futex mutex for a short while, in place of waiting on a POSIX
+// condition variable (which can only release POSIX mutexes)
+//========================================================================
+
+static void SleepUnlocked( GLFWmutex mutex, const struct timespec *deadline )
+{
+    struct timespec wait;
+
+    wait.tv_sec = 0;
+    wait.tv_nsec = 1000000L;
+
+    if( deadline )
+    {
+        GetTimeLeft( deadline, &wait );
+        if( wait.tv_sec > 0 || wait.tv_nsec > 1000000L )
+        {
+            wait.tv_sec = 0;
+            wait.tv_nsec = 1000000L;
+        }
+    }
+
+    _glfwPlatformUnlockMutex( mutex );
+    nanosleep( &wait, NULL );
+    _glfwPlatformLockMutex( mutex );
+}
+
+#endif // _GLFW_HAS_FUTEX
+
+
+//========================================================================
+// Wait for a condition variable until the deadline (or forever, if the
+// deadline is NULL)
+//========================================================================
+
+static void WaitCond( _GLFWsync *c, _GLFWsync *m,
+                      const struct timespec *deadline )
+{
+#ifdef _GLFW_HAS_FUTEX
+    if( c->Type == _GLFW_SYNC_NEW_COND )
+    {
+        BindCond( c, m );
+    }
+
+    // A futex condition variable only needs to release and reacquire the
+    // mutex, so it works with both kinds of mutex
+    if( c->Type == _GLFW_SYNC_FUTEX_COND )
+    {
+        WaitFutexCond( c, (GLFWmutex) m, deadline );
+        return;
+    }
+
+    // A POSIX condition variable later waited with a futex mutex cannot
+    // block on it. Returning after a short sleep is a spurious wakeup,
+    // which callers have to handle anyway, and does not spin.
+    if( m->Type == _GLFW_SYNC_FUTEX_MUTEX )
+    {
+        SleepUnlocked( (GLFWmutex) m, deadline );
+        return;
+    }
+#endif // _GLFW_HAS_FUTEX
+
+    if( deadline )
+    {
+        (void) pthread_cond_timedwait( &c->u.Cond, &m->u.Mutex, deadline );
+    }
+    else
+    {
+        (void) pthread_cond_wait( &c->u.Cond, &m->u.Mutex );
+    }
+}
+
+#endif // _GLFW_HAS_PTHREAD
+
+
+//========================================================================
+// Initialize the mutex and condition variable object pool
+//========================================================================
+
+void _glfwInitSyncObjects( void )
+{
+    _glfwThrd.SyncChunks = NULL;
+    _glfwThrd.FreeSync = NULL;
+
+    // Timed waits use the monotonic clock when condition variables can
+    // be told to use it, so that changes to the system time do not
+    // affect them
+    _glfwThrd.CondMonotonic = GL_FALSE;
+#if defined( _POSIX_CLOCK_SELECTION ) && defined( _POSIX_MONOTONIC_CLOCK )
+    {
+        struct timespec ts;
+
+        if( clock_gettime( CLOCK_MONOTONIC, &ts ) == 0 )
+        {
+            _glfwThrd.CondMonotonic = GL_TRUE;
+        }
+    }
+#endif
+
+    // Spinning is pointless when the lock holder cannot run at the same
+    // time as the waiting thread
+    _glfwThrd.SpinLimit = 0;
+#ifdef _GLFW_HAS_FUTEX
+    if( _glfwPlatformGetNumberOfProcessors() > 1 )
+    {
+        _glfwThrd.SpinLimit = _GLFW_FUTEX_SPIN_LIMIT;
+    }
+#endif // _GLFW_HAS_FUTEX
+}
+
+
+//========================================================================
+// Free all mutex and condition variable objects
+//========================================================================
+
+void _glfwTerminateSyncObjects( void )
+{
+    _GLFWsyncchunk *chunk;
+
+    while( _glfwThrd.SyncChunks )
+    {
+        chunk = _glfwThrd.SyncChunks;
+        _glfwThrd.SyncChunks = chunk->Next;
+        free( chunk );
+    }
+
+    _glfwThrd.FreeSync = NULL;
+}
+
+
+#if defined( __linux__ )
+
+// Highest number of cache levels looked at per processor
+#define _GLFW_MAX_CACHE_INDEX 8
+
+//------------------------------------------------------------------------
+// Distinct processor groups found so far (a group is known by the lowest
+// processor in it)
+//------------------------------------------------------------------------
+typedef struct {
+    int          *Keys;
+    int          *Count;
+    unsigned int *Masks;
+} _GLFWcpugroups;
+
+
+//========================================================================
+// Read the first line of a small sysfs or procfs file
+//========================================================================
+
+static int ReadLine( const char *path, char *line, int size )
+{
+    FILE *file;
+    int  result;
+
+    file = fopen( path, "r" );
+    if( file == NULL )
+    {
+        return GL_FALSE;
+    }
+
+    result = fgets( line, size, file ) != NULL;
+    fclose( file );
+
+    if( result )
+    {
+        line[ strcspn( line, "\n" ) ] = '\0';
+    }
+
+    return result;
+}
+
+
+//========================================================================
+// Parse a processor list such as "0-3,8-11" into a mask of processors
+// 0-31. Returns the lowest processor in the list, or -1 if it is empty
+//========================================================================
+
+static int ParseCPUList( const char *list, unsigned int *mask )
+{
+    char *end;
+    int  i, first, last, lowest = -1;
+
+    *mask = 0;
+
+    for( ;; )
+    {
+        first = (int) strtol( list, &end, 10 );
+        if( end == list )
+        {
+            break;
+        }
+
+        last = first;
+        if( *end == '-' )
+        {
+            list = end + 1;
+            last = (int) strtol( list, &end, 10 );
+        }
+
+        for( i = first; i <= last && i < 32; i ++ )
+        {
+            *mask |= 1U << i;
+        }
+
+        if( lowest < 0 || first < lowest )
+        {
+            lowest = first;
+        }
+
+        if( *end != ',' )
+        {
+            break;
+        }
+        list = end + 1;
+    }
+
+    return lowest;
+}
+
+
+//========================================================================
+// Add the processors in a list to a group, unless the group is known
+//========================================================================
+
+static void AddCPUGroup( _GLFWcpugroups *groups, const char *list,
+                         unsigned int usable )
+{
+    unsigned int mask;
+    int          i, key;
+
+    key = ParseCPUList( list, &mask );
+    if( key < 0 )
+    {
+        return;
+    }
+
+    for( i = 0; i < *groups->Count; i ++ )
+    {
+        if( groups->Keys[ i ] == key )
+        {
+            return;
+        }
+    }
+
+    groups->Keys[ *groups->Count ] = key;
+    if( *groups->Count < GLFW_MAX_CPU_GROUPS )
+    {
+        groups->Masks[ *groups->Count ] = mask & usable;
+    }
+    (*groups->Count) ++;
+}
+
+
+//========================================================================
+// Read the first line of a file of a cgroup. A path that does not fit
+// the buffer is treated like a missing file
+//========================================================================
+
+static int ReadCgroupLine( const char *root, const char *path,
+                           const char *file, char *line, int size )
+{
+    char name[ 512 ];
+    int  length;
 
+    length = snprintf( name, sizeof( name ), "%s%s/%s", root, path, file );
+    if( length < 0 || length >= (int) sizeof( name ) )
+    {
+        return GL_FALSE;
+    }
 
-//************************************************************************
-//****                  GLFW internal functions                       ****
-//************************************************************************
+    return ReadLine( name, line, size );
+}
 
-#ifdef _GLFW_HAS_PTHREAD
 
 //========================================================================
-// This is simply a "wrapper" for calling the user thread function.
+// Return the number of processors that the CPU quota of a cgroup allows,
+// or zero if it has no quota
 //========================================================================
 
-void * _glfwNewThread( void * arg )
+static int GetCgroupQuota( const char *path )
 {
-    GLFWthreadfun threadfun;
-    _GLFWthread   *t;
-    pthread_t   posixID;
+    char line[ 64 ];
+    long quota, period;
+
+    // cgroup v2 has "max 100000" or "200000 100000" in cpu.max
+    if( ReadCgroupLine( "/sys/fs/cgroup", path, "cpu.max",
+                        line, sizeof( line ) ) )
+    {
+        if( sscanf( line, "%ld %ld", &quota, &period ) == 2 &&
+            quota > 0 && period > 0 )
+        {
+            return (int) ((quota + period - 1) / period);
+        }
+        return 0;
+    }
 
-    // Get current thread ID
-    posixID = pthread_self();
+    // cgroup v1 has the quota and period in separate files, with a quota
+    // of -1 meaning no quota
+    if( !ReadCgroupLine( "/sys/fs/cgroup/cpu", path, "cpu.cfs_quota_us",
+                         line, sizeof( line ) ) ||
+        sscanf( line, "%ld", &quota ) != 1 || quota <= 0 )
+    {
+        return 0;
+    }
 
-    // Enter critical section
-    ENTER_THREAD_CRITICAL_SECTION
+    if( !ReadCgroupLine( "/sys/fs/cgroup/cpu", path, "cpu.cfs_period_us",
+                         line, sizeof( line ) ) ||
+        sscanf( line, "%ld", &period ) != 1 || period <= 0 )
+    {
+        return 0;
+    }
+
+    return (int) ((quota + period - 1) / period);
+}
+
+
+//========================================================================
+// Return the number of processors that the CPU quotas of the cgroup of
+// this process and its parents allow, or zero if there is no quota
+//========================================================================
+
+static int GetCPUQuota( void )
+{
+    FILE *file;
+    char line[ 512 ], *path, *slash;
+    int  quota, result = 0;
+
+    file = fopen( "/proc/self/cgroup", "r" );
+    if( file == NULL )
+    {
+        return 0;
+    }
 
-    // Loop through entire list of threads to find the matching POSIX
-    // thread ID
-    for( t = &_glfwThrd.First; t != NULL; t = t->Next )
+    // Lines are "hierarchy:controllers:path", with the cgroup v2 line
+    // having hierarchy zero and no controllers
+    path = NULL;
+    while( fgets( line, sizeof( line ), file ) )
     {
-        if( t->PosixID == posixID )
+        line[ strcspn( line, "\n" ) ] = '\0';
+        if( strncmp( line, "0::", 3 ) == 0 ||
+            strstr( line, ":cpu,cpuacct:" ) || strstr( line, ":cpu:" ) )
         {
+            path = strchr( strchr( line, ':' ) + 1, ':' ) + 1;
             break;
         }
     }
-    if( t == NULL )
+    fclose( file );
+
+    if( path == NULL )
     {
-        LEAVE_THREAD_CRITICAL_SECTION
-        return NULL;
+        return 0;
     }
 
-    // Get user thread function pointer
-    threadfun = t->Function;
+    // The tightest quota on the way up to the root applies
+    for( ;; )
+    {
+        if( strcmp( path, "/" ) == 0 )
+        {
+            path[ 0 ] = '\0';
+        }
 
-    // Leave critical section
-    LEAVE_THREAD_CRITICAL_SECTION
+        quota = GetCgroupQuota( path );
+        if( quota > 0 && ( result == 0 || quota < result ) )
+        {
+            result = quota;
+        }
 
-    // Call the user thread function
-    threadfun( arg );
+        slash = strrchr( path, '/' );
+        if( slash == NULL )
+        {
+            break;
+        }
+        *slash = '\0';
+    }
 
-    // Remove thread from thread list
-    ENTER_THREAD_CRITICAL_SECTION
-    _glfwRemoveThread( t );
-    LEAVE_THREAD_CRITICAL_SECTION
+    return result;
+}
 
-    // When the thread function returns, the thread will die...
-    return NULL;
+
+#if defined( _GLFW_HAS_GETTID )
+
+//========================================================================
+// Read the context switch counts of a thread of this process from procfs
+//========================================================================
+
+static void GetContextSwitches( pid_t kernelID, GLFWthreadstats *stats )
+{
+    FILE *file;
+    char name[ 64 ], line[ 128 ];
+    long value;
+
+    sprintf( name, "/proc/self/task/%i/status", (int) kernelID );
+    file = fopen( name, "r" );
+    if( file == NULL )
+    {
+        return;
+    }
+
+    while( fgets( line, sizeof( line ), file ) )
+    {
+        if( sscanf( line, "voluntary_ctxt_switches: %ld", &value ) == 1 )
+        {
+            stats->VoluntarySwitches = value;
+        }
+        else if( sscanf( line, "nonvoluntary_ctxt_switches: %ld",
+                         &value ) == 1 )
+        {
+            stats->InvoluntarySwitches = value;
+        }
+    }
+
+    fclose( file );
 }
 
-#endif // _GLFW_HAS_PTHREAD
+#endif // _GLFW_HAS_GETTID
+
+#endif // __linux__
 
 
 
@@ -105,207 +914,453 @@ GLFWthread _glfwPlatformCreateThread( GLFWthreadfun fun, void *arg )
 
     GLFWthread  ID;
     _GLFWthread *t;
+    pthread_t   posixID;
     int         result;
 
-    // Enter critical section
+    // Allocate a thread record
     ENTER_THREAD_CRITICAL_SECTION
-
-    // Create a new thread information memory area
-    t = (_GLFWthread *) malloc( sizeof(_GLFWthread) );
+    t = _glfwAllocThread( fun, arg );
+#ifdef _GLFW_HAS_GETTID
+    if( t != NULL )
+    {
+        t->KernelID = 0;
+    }
+#endif
+    LEAVE_THREAD_CRITICAL_SECTION
     if( t == NULL )
     {
-        // Leave critical section
-        LEAVE_THREAD_CRITICAL_SECTION
         return -1;
     }
 
-    // Get a new unique thread id
-    ID = _glfwThrd.NextID ++;
-
-    // Store thread information in the thread list
-    t->Function = fun;
-    t->ID       = ID;
-
     // Create thread
     result = pthread_create(
-        &t->PosixID,      // Thread handle
+        &posixID,         // Thread handle
         NULL,             // Default thread attributes
         _glfwNewThread,   // Thread function (a wrapper function)
-        (void *)arg       // Argument to thread is user argument
+        (void *)t         // Argument to thread is the thread record
     );
 
+    ENTER_THREAD_CRITICAL_SECTION
+
     // Did the thread creation fail?
     if( result != 0 )
     {
-        free( (void *) t );
+        _glfwFreeThread( t );
+        LEAVE_THREAD_CRITICAL_SECTION
+        return -1;
+    }
+
+    // Make the thread visible to glfwWaitThread and glfwDestroyThread
+    t->PosixID = posixID;
+    ID = _glfwPublishThread( t );
+
+    LEAVE_THREAD_CRITICAL_SECTION
+
+    // Return the GLFW thread ID
+    return ID;
+
+#else
+
+    return -1;
+
+#endif // _GLFW_HAS_PTHREAD
+}
+
+
+//========================================================================
+// Kill a thread. NOTE: THIS IS A VERY DANGEROUS OPERATION, AND SHOULD NOT
+// BE USED EXCEPT IN EXTREME SITUATIONS!
+//========================================================================
+
+void _glfwPlatformDestroyThread( GLFWthread ID )
+{
+#ifdef _GLFW_HAS_PTHREAD
+
+    _GLFWthread *t;
+
+    // Enter critical section
+    ENTER_THREAD_CRITICAL_SECTION
+
+    // Get thread information pointer
+    t = _glfwGetThreadPointer( ID );
+    if( t == NULL )
+    {
+        LEAVE_THREAD_CRITICAL_SECTION
+        return;
+    }
+
+    // Simply murder the process, no mercy!
+    pthread_kill( t->PosixID, SIGKILL );
+
+    // Release the thread record
+    _glfwFreeThread( t );
+
+    // Leave critical section
+    LEAVE_THREAD_CRITICAL_SECTION
+
+#endif // _GLFW_HAS_PTHREAD
+}
+
+
+//========================================================================
+// Wait for a thread to die
+//========================================================================
+
+int _glfwPlatformWaitThread( GLFWthread ID, int waitmode )
+{
+#ifdef _GLFW_HAS_PTHREAD
+
+    pthread_t   thread;
+    _GLFWthread *t;
+
+    // Get thread information pointer
+    t = _glfwGetThreadPointer( ID );
+
+    // Is the thread already dead?
+    if( t == NULL )
+    {
+        return GL_TRUE;
+    }
+
+    // If got this far, the thread is alive => polling returns FALSE
+    if( waitmode == GLFW_NOWAIT )
+    {
+        return GL_FALSE;
+    }
+
+    // Get thread handle, and make sure the record was not reused for
+    // another thread while reading it
+    thread = t->PosixID;
+    _glfwPlatformMemoryBarrier();
+    if( t->ID != ID )
+    {
+        return GL_TRUE;
+    }
+
+    // Wait for thread to die
+    (void) pthread_join( thread, NULL );
+
+    return GL_TRUE;
+
+#else
+
+    return GL_TRUE;
+
+#endif // _GLFW_HAS_PTHREAD
+}
+
+
+//========================================================================
+// Return the thread ID for the current thread
+//========================================================================
+
+GLFWthread _glfwPlatformGetThreadID( void )
+{
+#ifdef _GLFW_HAS_PTHREAD
+
+    _GLFWthread *t;
+
+    // Get the thread record of this thread
+    t = (_GLFWthread *) pthread_getspecific( _glfwThrd.Key );
+    if( t == NULL )
+    {
+        return -1;
+    }
+
+    // The record may not have been published yet, so build the ID
+    return _GLFW_THREAD_ID( t->Slot, t->Generation );
+
+#else
+
+    return 0;
+
+#endif // _GLFW_HAS_PTHREAD
+}
+
+
+//========================================================================
+// Restrict a thread to the processors in a mask
+//========================================================================
+
+int _glfwPlatformSetThreadAffinity( GLFWthread ID, unsigned int mask )
+{
+#if defined( _GLFW_HAS_PTHREAD ) && defined( _GLFW_HAS_PTHREAD_SETAFFINITY )
+
+    _GLFWthread *t;
+    cpu_set_t   set;
+    int         i, result = GL_FALSE;
+
+    CPU_ZERO( &set );
+    for( i = 0; i < 32; i ++ )
+    {
+        if( mask & (1U << i) )
+        {
+            CPU_SET( i, &set );
+        }
+    }
+
+    ENTER_THREAD_CRITICAL_SECTION
+    t = GetThreadRecord( ID );
+    if( t != NULL &&
+        pthread_setaffinity_np( t->PosixID, sizeof( set ), &set ) == 0 )
+    {
+        result = GL_TRUE;
+    }
+    LEAVE_THREAD_CRITICAL_SECTION
+
+    return result;
+
+#else
+
+    return GL_FALSE;
+
+#endif
+}
+
+
+//========================================================================
+// Change the scheduling priority of a thread. The normal, low and high
+// priorities are nice values under the default policy, which needs the
+// kernel thread ID, while the realtime priority uses SCHED_RR. Raising
+// the priority fails unless the process is permitted to do so
+//========================================================================
+
+int _glfwPlatformSetThreadPriority( GLFWthread ID, int priority )
+{
+#ifdef _GLFW_HAS_PTHREAD
+
+    _GLFWthread        *t;
+    struct sched_param param;
+    int                policy = SCHED_OTHER, nice = 0, result = GL_FALSE;
+
+    memset( &param, 0, sizeof( param ) );
+
+    switch( priority )
+    {
+        case GLFW_THREAD_PRIORITY_LOW:
+            nice = 10;
+            break;
+        case GLFW_THREAD_PRIORITY_HIGH:
+            nice = -10;
+            break;
+        case GLFW_THREAD_PRIORITY_REALTIME:
+            policy = SCHED_RR;
+            param.sched_priority = (sched_get_priority_min( SCHED_RR ) +
+                                    sched_get_priority_max( SCHED_RR )) / 2;
+            break;
+        default:
+            break;
+    }
+
+#ifndef _GLFW_HAS_GETTID
+    // Without per-thread nice values, all we can do is use the static
+    // priority range of the default policy, which is empty on Linux
+    if( nice < 0 )
+    {
+        param.sched_priority = sched_get_priority_max( SCHED_OTHER );
+    }
+    else if( nice > 0 )
+    {
+        param.sched_priority = sched_get_priority_min( SCHED_OTHER );
+    }
+#endif
+
+    ENTER_THREAD_CRITICAL_SECTION
+
+#ifdef _GLFW_HAS_GETTID
+    // A thread that was just created may not have stored its kernel
+    // thread ID yet, so give it the chance to
+    for( ;; )
+    {
+        t = GetThreadRecord( ID );
+        if( t == NULL || t->KernelID != 0 )
+        {
+            break;
+        }
+
         LEAVE_THREAD_CRITICAL_SECTION
-        return -1;
+        _glfwPlatformSleep( 0.0 );
+        ENTER_THREAD_CRITICAL_SECTION
     }
+#else
+    t = GetThreadRecord( ID );
+#endif
 
-    // Append thread to thread list
-    _glfwAppendThread( t );
+    if( t != NULL &&
+        pthread_setschedparam( t->PosixID, policy, &param ) == 0 )
+    {
+        result = GL_TRUE;
+
+#ifdef _GLFW_HAS_GETTID
+        if( policy == SCHED_OTHER &&
+            setpriority( PRIO_PROCESS, (id_t) t->KernelID, nice ) != 0 )
+        {
+            result = GL_FALSE;
+        }
+#endif
+    }
 
-    // Leave critical section
     LEAVE_THREAD_CRITICAL_SECTION
 
-    // Return the GLFW thread ID
-    return ID;
+    return result;
 
 #else
 
-    return -1;
+    return GL_FALSE;
 
 #endif // _GLFW_HAS_PTHREAD
 }
 
 
 //========================================================================
-// Kill a thread. NOTE: THIS IS A VERY DANGEROUS OPERATION, AND SHOULD NOT
-// BE USED EXCEPT IN EXTREME SITUATIONS!
+// Name a thread for debuggers and tools such as top and perf. Linux
+// truncates names to 15 characters
 //========================================================================
 
-void _glfwPlatformDestroyThread( GLFWthread ID )
+int _glfwPlatformSetThreadName( GLFWthread ID, const char *name )
 {
-#ifdef _GLFW_HAS_PTHREAD
+#if defined( _GLFW_HAS_PTHREAD ) && defined( _GLFW_HAS_PTHREAD_SETNAME )
 
     _GLFWthread *t;
+    char        buffer[ 16 ];
+    int         result = GL_FALSE;
 
-    // Enter critical section
-    ENTER_THREAD_CRITICAL_SECTION
+    strncpy( buffer, name, sizeof( buffer ) - 1 );
+    buffer[ sizeof( buffer ) - 1 ] = '\0';
 
-    // Get thread information pointer
-    t = _glfwGetThreadPointer( ID );
-    if( t == NULL )
+    ENTER_THREAD_CRITICAL_SECTION
+    t = GetThreadRecord( ID );
+    if( t != NULL && pthread_setname_np( t->PosixID, buffer ) == 0 )
     {
-        LEAVE_THREAD_CRITICAL_SECTION
-        return;
+        result = GL_TRUE;
     }
+    LEAVE_THREAD_CRITICAL_SECTION
 
-    // Simply murder the process, no mercy!
-    pthread_kill( t->PosixID, SIGKILL );
+    return result;
 
-    // Remove thread from thread list
-    _glfwRemoveThread( t );
+#else
 
-    // Leave critical section
-    LEAVE_THREAD_CRITICAL_SECTION
+    return GL_FALSE;
 
-#endif // _GLFW_HAS_PTHREAD
+#endif
 }
 
 
 //========================================================================
-// Wait for a thread to die
+// Get the CPU time and context switch counts of a thread
 //========================================================================
 
-int _glfwPlatformWaitThread( GLFWthread ID, int waitmode )
+int _glfwPlatformGetThreadStats( GLFWthread ID, GLFWthreadstats *stats )
 {
 #ifdef _GLFW_HAS_PTHREAD
 
-    pthread_t   thread;
-    _GLFWthread *t;
+    _GLFWthread     *t;
+    int             self;
+#if defined( _GLFW_HAS_PTHREAD_GETCPUCLOCKID )
+    clockid_t       clock;
+    struct timespec ts;
+#endif
+#if defined( RUSAGE_THREAD )
+    struct rusage   usage;
+#endif
+#if defined( __linux__ ) && defined( _GLFW_HAS_GETTID )
+    pid_t           kernelID;
+#endif
 
-    // Enter critical section
     ENTER_THREAD_CRITICAL_SECTION
 
-    // Get thread information pointer
-    t = _glfwGetThreadPointer( ID );
-
-    // Is the thread already dead?
+    t = GetThreadRecord( ID );
     if( t == NULL )
     {
         LEAVE_THREAD_CRITICAL_SECTION
-        return GL_TRUE;
+        return GL_FALSE;
     }
 
-    // If got this far, the thread is alive => polling returns FALSE
-    if( waitmode == GLFW_NOWAIT )
+    // The POSIX ID of the calling thread may not have been stored yet
+    self = t == (_GLFWthread *) pthread_getspecific( _glfwThrd.Key );
+
+    stats->CreationTime = t->CreationTime;
+    stats->RunTime      = _glfwGetSteadyTime() - t->StartTime;
+
+#if defined( _GLFW_HAS_PTHREAD_GETCPUCLOCKID )
+    // The thread cannot exit while the critical section is held, as it
+    // has to enter it to release its record
+    if( pthread_getcpuclockid( self ? pthread_self() : t->PosixID,
+                               &clock ) == 0 &&
+        clock_gettime( clock, &ts ) == 0 )
     {
-        LEAVE_THREAD_CRITICAL_SECTION
-        return GL_FALSE;
+        stats->CPUTime = (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
     }
+#endif
 
-    // Get thread handle
-    thread = t->PosixID;
+#if defined( __linux__ ) && defined( _GLFW_HAS_GETTID )
+    kernelID = t->KernelID;
+#endif
 
-    // Leave critical section
     LEAVE_THREAD_CRITICAL_SECTION
 
-    // Wait for thread to die
-    (void) pthread_join( thread, NULL );
+#if defined( RUSAGE_THREAD )
+    if( self && getrusage( RUSAGE_THREAD, &usage ) == 0 )
+    {
+        stats->VoluntarySwitches   = usage.ru_nvcsw;
+        stats->InvoluntarySwitches = usage.ru_nivcsw;
+        return GL_TRUE;
+    }
+#endif
+
+#if defined( __linux__ ) && defined( _GLFW_HAS_GETTID )
+    // getrusage only knows about the calling thread, so the counts of
+    // other threads are read from procfs. If the thread has exited by
+    // now, they are left unknown
+    if( kernelID != 0 )
+    {
+        GetContextSwitches( kernelID, stats );
+    }
+#endif
 
     return GL_TRUE;
 
 #else
 
-    return GL_TRUE;
+    return GL_FALSE;
 
 #endif // _GLFW_HAS_PTHREAD
 }
 
 
 //========================================================================
-// Return the thread ID for the current thread
+// Create a mutual exclusion object
 //========================================================================
 
-GLFWthread _glfwPlatformGetThreadID( void )
+GLFWmutex _glfwPlatformCreateMutex( void )
 {
 #ifdef _GLFW_HAS_PTHREAD
 
-    _GLFWthread *t;
-    GLFWthread  ID = -1;
-    pthread_t   posixID;
-
-    // Get current thread ID
-    posixID = pthread_self();
-
-    // Enter critical section
-    ENTER_THREAD_CRITICAL_SECTION
+    _GLFWsync *mutex;
 
-    // Loop through entire list of threads to find the matching POSIX
-    // thread ID
-    for( t = &_glfwThrd.First; t != NULL; t = t->Next )
+#ifdef _GLFW_HAS_FUTEX
+    if( _glfwFutexSync )
     {
-        if( t->PosixID == posixID )
+        mutex = AllocSync( _GLFW_SYNC_FUTEX_MUTEX );
+        if( !mutex )
         {
-            ID = t->ID;
-            break;
+            return NULL;
         }
-    }
-
-    // Leave critical section
-    LEAVE_THREAD_CRITICAL_SECTION
-
-    // Return the found GLFW thread identifier
-    return ID;
-
-#else
-
-    return 0;
-
-#endif // _GLFW_HAS_PTHREAD
-}
-
-
-//========================================================================
-// Create a mutual exclusion object
-//========================================================================
-
-GLFWmutex _glfwPlatformCreateMutex( void )
-{
-#ifdef _GLFW_HAS_PTHREAD
 
-    pthread_mutex_t *mutex;
+        mutex->u.FutexMutex.State = 0;
+        mutex->u.FutexMutex.Spin = 0;
+        return (GLFWmutex) mutex;
+    }
+#endif // _GLFW_HAS_FUTEX
 
-    // Allocate memory for mutex
-    mutex = (pthread_mutex_t *) malloc( sizeof( pthread_mutex_t ) );
+    mutex = AllocSync( _GLFW_SYNC_MUTEX );
     if( !mutex )
     {
         return NULL;
     }
 
     // Initialise a mutex object
-    (void) pthread_mutex_init( mutex, NULL );
+    (void) pthread_mutex_init( &mutex->u.Mutex, NULL );
 
     // Cast to GLFWmutex and return
     return (GLFWmutex) mutex;
@@ -326,11 +1381,16 @@ void _glfwPlatformDestroyMutex( GLFWmutex mutex )
 {
 #ifdef _GLFW_HAS_PTHREAD
 
+    _GLFWsync *m = (_GLFWsync *) mutex;
+
     // Destroy the mutex object
-    pthread_mutex_destroy( (pthread_mutex_t *) mutex );
+    if( m->Type == _GLFW_SYNC_MUTEX )
+    {
+        pthread_mutex_destroy( &m->u.Mutex );
+    }
 
-    // Free memory for mutex object
-    free( (void *) mutex );
+    // Return the object to the free list
+    FreeSync( m );
 
 #endif // _GLFW_HAS_PTHREAD
 }
@@ -344,8 +1404,18 @@ void _glfwPlatformLockMutex( GLFWmutex mutex )
 {
 #ifdef _GLFW_HAS_PTHREAD
 
+    _GLFWsync *m = (_GLFWsync *) mutex;
+
+#ifdef _GLFW_HAS_FUTEX
+    if( m->Type == _GLFW_SYNC_FUTEX_MUTEX )
+    {
+        LockFutexMutex( m );
+        return;
+    }
+#endif // _GLFW_HAS_FUTEX
+
     // Wait for mutex to be released
-    (void) pthread_mutex_lock( (pthread_mutex_t *) mutex );
+    (void) pthread_mutex_lock( &m->u.Mutex );
 
 #endif // _GLFW_HAS_PTHREAD
 }
@@ -359,8 +1429,18 @@ void _glfwPlatformUnlockMutex( GLFWmutex mutex )
 {
 #ifdef _GLFW_HAS_PTHREAD
 
+    _GLFWsync *m = (_GLFWsync *) mutex;
+
+#ifdef _GLFW_HAS_FUTEX
+    if( m->Type == _GLFW_SYNC_FUTEX_MUTEX )
+    {
+        UnlockFutexMutex( m );
+        return;
+    }
+#endif // _GLFW_HAS_FUTEX
+
     // Release mutex
-    pthread_mutex_unlock( (pthread_mutex_t *) mutex );
+    pthread_mutex_unlock( &m->u.Mutex );
 
 #endif // _GLFW_HAS_PTHREAD
 }
@@ -374,17 +1454,26 @@ GLFWcond _glfwPlatformCreateCond( void )
 {
 #ifdef _GLFW_HAS_PTHREAD
 
-    pthread_cond_t *cond;
+    _GLFWsync *cond;
 
-    // Allocate memory for condition variable
-    cond = (pthread_cond_t *) malloc( sizeof(pthread_cond_t) );
+#ifdef _GLFW_HAS_FUTEX
+    // The backend is chosen when the condition variable is first waited
+    // on, to match the mutex (see BindCond)
+    cond = AllocSync( _GLFW_SYNC_NEW_COND );
+    if( !cond )
+    {
+        return NULL;
+    }
+#else
+    cond = AllocSync( _GLFW_SYNC_COND );
     if( !cond )
     {
         return NULL;
     }
 
     // Initialise condition variable
-    (void) pthread_cond_init( cond, NULL );
+    _glfwInitCond( &cond->u.Cond );
+#endif // _GLFW_HAS_FUTEX
 
     // Cast to GLFWcond and return
     return (GLFWcond) cond;
@@ -405,11 +1494,16 @@ void _glfwPlatformDestroyCond( GLFWcond cond )
 {
 #ifdef _GLFW_HAS_PTHREAD
 
+    _GLFWsync *c = (_GLFWsync *) cond;
+
     // Destroy the condition variable object
-    (void) pthread_cond_destroy( (pthread_cond_t *) cond );
+    if( c->Type == _GLFW_SYNC_COND )
+    {
+        (void) pthread_cond_destroy( &c->u.Cond );
+    }
 
-    // Free memory for condition variable object
-    free( (void *) cond );
+    // Return the object to the free list
+    FreeSync( c );
 
 #endif // _GLFW_HAS_PTHREAD
 }
@@ -424,34 +1518,42 @@ void _glfwPlatformWaitCond( GLFWcond cond, GLFWmutex mutex,
 {
 #ifdef _GLFW_HAS_PTHREAD
 
-    struct timeval  currenttime;
-    struct timespec wait;
-    long dt_sec, dt_usec;
+    struct timespec deadline;
 
     // Select infinite or timed wait
     if( timeout >= GLFW_INFINITY )
     {
-        // Wait for condition (infinite wait)
-        (void) pthread_cond_wait( (pthread_cond_t *) cond,
-                  (pthread_mutex_t *) mutex );
+        WaitCond( (_GLFWsync *) cond, (_GLFWsync *) mutex, NULL );
     }
     else
     {
-        // Set timeout time, relatvie to current time
-        gettimeofday( &currenttime, NULL );
-        dt_sec  = (long) timeout;
-        dt_usec = (long) ((timeout - (double)dt_sec) * 1000000.0);
-        wait.tv_nsec = (currenttime.tv_usec + dt_usec) * 1000L;
-        if( wait.tv_nsec > 1000000000L )
-        {
-            wait.tv_nsec -= 1000000000L;
-            dt_sec ++;
-        }
-        wait.tv_sec  = currenttime.tv_sec + dt_sec;
+        _glfwGetCondDeadline( timeout, &deadline );
+        WaitCond( (_GLFWsync *) cond, (_GLFWsync *) mutex, &deadline );
+    }
+
+#endif // _GLFW_HAS_PTHREAD
+}
+
+
+//========================================================================
+// Wait for a condition to be raised or the timer to reach a given value
+//========================================================================
+
+void _glfwPlatformWaitCondUntil( GLFWcond cond, GLFWmutex mutex,
+    double time )
+{
+#ifdef _GLFW_HAS_PTHREAD
 
-        // Wait for condition (timed wait)
-        (void) pthread_cond_timedwait( (pthread_cond_t *) cond,
-                   (pthread_mutex_t *) mutex, &wait );
+    struct timespec deadline;
+
+    if( time >= GLFW_INFINITY )
+    {
+        WaitCond( (_GLFWsync *) cond, (_GLFWsync *) mutex, NULL );
+    }
+    else
+    {
+        GetTimerDeadline( time, &deadline );
+        WaitCond( (_GLFWsync *) cond, (_GLFWsync *) mutex, &deadline );
     }
 
 #endif // _GLFW_HAS_PTHREAD
@@ -466,8 +1568,24 @@ void _glfwPlatformSignalCond( GLFWcond cond )
 {
 #ifdef _GLFW_HAS_PTHREAD
 
+    _GLFWsync *c = (_GLFWsync *) cond;
+
+#ifdef _GLFW_HAS_FUTEX
+    // Nobody can be waiting on a condition variable that has no backend
+    if( c->Type == _GLFW_SYNC_NEW_COND )
+    {
+        return;
+    }
+
+    if( c->Type == _GLFW_SYNC_FUTEX_COND )
+    {
+        WakeFutexCond( c, 1 );
+        return;
+    }
+#endif // _GLFW_HAS_FUTEX
+
     // Signal condition
-    (void) pthread_cond_signal( (pthread_cond_t *) cond );
+    (void) pthread_cond_signal( &c->u.Cond );
 
 #endif // _GLFW_HAS_PTHREAD
 }
@@ -481,8 +1599,24 @@ void _glfwPlatformBroadcastCond( GLFWcond cond )
 {
 #ifdef _GLFW_HAS_PTHREAD
 
+    _GLFWsync *c = (_GLFWsync *) cond;
+
+#ifdef _GLFW_HAS_FUTEX
+    // Nobody can be waiting on a condition variable that has no backend
+    if( c->Type == _GLFW_SYNC_NEW_COND )
+    {
+        return;
+    }
+
+    if( c->Type == _GLFW_SYNC_FUTEX_COND )
+    {
+        WakeFutexCond( c, INT_MAX );
+        return;
+    }
+#endif // _GLFW_HAS_FUTEX
+
     // Broadcast condition
-    (void) pthread_cond_broadcast( (pthread_cond_t *) cond );
+    (void) pthread_cond_broadcast( &c->u.Cond );
 
 #endif // _GLFW_HAS_PTHREAD
 }
@@ -501,3 +1635,238 @@ int _glfwPlatformGetNumberOfProcessors( void )
     return n;
 }
 
+
+//========================================================================
+// Describe the processors this process may use. On Linux the affinity
+// mask, the cgroup CPU quota and the sysfs processor topology are taken
+// into account
+//========================================================================
+
+int _glfwPlatformGetCPUTopology( GLFWcputopology *topology )
+{
+    int            i;
+#if defined( __linux__ )
+    _GLFWcpugroups groups[ 3 ];
+    char           name[ 128 ], line[ 512 ];
+    int            *keys, j, cpu, level, count, quota, *cpus;
+#if defined( _GLFW_HAS_PTHREAD_SETAFFINITY )
+    cpu_set_t      set;
+#endif
+#endif
+
+    // Assume that all processors are usable and are separate cores
+    topology->OnlineCount = _glfwPlatformGetNumberOfProcessors();
+    topology->UsableCount = topology->OnlineCount;
+    topology->CoreCount = topology->OnlineCount;
+    for( i = 0; i < topology->OnlineCount && i < 32; i ++ )
+    {
+        topology->UsableMask |= 1U << i;
+    }
+
+#if defined( __linux__ )
+
+    cpus = (int *) malloc( topology->OnlineCount * 4 * sizeof( int ) );
+    if( cpus == NULL )
+    {
+        return GL_FALSE;
+    }
+    keys = cpus + topology->OnlineCount;
+
+    // Find the processors in the affinity mask, or assume all of them
+    count = 0;
+#if defined( _GLFW_HAS_PTHREAD_SETAFFINITY )
+    if( sched_getaffinity( 0, sizeof( set ), &set ) == 0 )
+    {
+        for( cpu = 0; cpu < CPU_SETSIZE && count < topology->OnlineCount;
+             cpu ++ )
+        {
+            if( CPU_ISSET( cpu, &set ) )
+            {
+                cpus[ count ++ ] = cpu;
+            }
+        }
+    }
+#endif
+    if( count == 0 )
+    {
+        for( cpu = 0; cpu < topology->OnlineCount; cpu ++ )
+        {
+            cpus[ count ++ ] = cpu;
+        }
+    }
+
+    topology->UsableMask = 0;
+    for( i = 0; i < count; i ++ )
+    {
+        if( cpus[ i ] < 32 )
+        {
+            topology->UsableMask |= 1U << cpus[ i ];
+        }
+    }
+
+    topology->UsableCount = count;
+    quota = GetCPUQuota();
+    if( quota > 0 && quota < count )
+    {
+        topology->UsableCount = quota;
+    }
+
+    // Group the processors by core and by shared L2 and L3 caches
+    groups[ 0 ].Count = &topology->CoreCount;
+    groups[ 0 ].Masks = topology->CoreMasks;
+    groups[ 1 ].Count = &topology->L2GroupCount;
+    groups[ 1 ].Masks = topology->L2Masks;
+    groups[ 2 ].Count = &topology->L3GroupCount;
+    groups[ 2 ].Masks = topology->L3Masks;
+    for( i = 0; i < 3; i ++ )
+    {
+        *groups[ i ].Count = 0;
+        groups[ i ].Keys = keys + i * topology->OnlineCount;
+    }
+
+    for( i = 0; i < count; i ++ )
+    {
+        sprintf( name, "/sys/devices/system/cpu/cpu%i/topology/"
+                       "thread_siblings_list", cpus[ i ] );
+        if( ReadLine( name, line, sizeof( line ) ) )
+        {
+            AddCPUGroup( &groups[ 0 ], line, topology->UsableMask );
+        }
+
+        for( j = 0; j < _GLFW_MAX_CACHE_INDEX; j ++ )
+        {
+            sprintf( name, "/sys/devices/system/cpu/cpu%i/cache/index%i/level",
+                     cpus[ i ], j );
+            if( !ReadLine( name, line, sizeof( line ) ) )
+            {
+                break;
+            }
+
+            level = atoi( line );
+            if( level != 2 && level != 3 )
+            {
+                continue;
+            }
+
+            sprintf( name, "/sys/devices/system/cpu/cpu%i/cache/index%i/"
+                           "shared_cpu_list", cpus[ i ], j );
+            if( ReadLine( name, line, sizeof( line ) ) )
+            {
+                AddCPUGroup( &groups[ level - 1 ], line,
+                             topology->UsableMask );
+            }
+        }
+    }
+
+    // Without topology information, every processor is a core
+    if( topology->CoreCount == 0 )
+    {
+        topology->CoreCount = count;
+    }
+
+    free( cpus );
+
+#endif // __linux__
+
+    return GL_TRUE;
+}
+
+
+//========================================================================
+// Atomically add to an integer and return the new value
+//========================================================================
+
+int _glfwPlatformAtomicAdd( volatile int *value, int delta )
+{
+#if defined(__GNUC__)
+    return __sync_add_and_fetch( value, delta );
+#else
+    int result;
+
+    ENTER_THREAD_CRITICAL_SECTION
+    result = (*value += delta);
+    LEAVE_THREAD_CRITICAL_SECTION
+
+    return result;
+#endif
+}
+
+
+//========================================================================
+// Atomically replace an integer if it still has the expected value
+//========================================================================
+
+int _glfwPlatformAtomicCompareAndSwap( volatile int *value, int expected,
+                                       int desired )
+{
+#if defined(__GNUC__)
+    return __sync_bool_compare_and_swap( value, expected, desired ) ?
+           GL_TRUE : GL_FALSE;
+#else
+    int result = GL_FALSE;
+
+    ENTER_THREAD_CRITICAL_SECTION
+    if( *value == expected )
+    {
+        *value = desired;
+        result = GL_TRUE;
+    }
+    LEAVE_THREAD_CRITICAL_SECTION
+
+    return result;
+#endif
+}
+
+
+//========================================================================
+// Sleep while an integer still has the given value, for at most timeout
+// seconds. Returns GL_FALSE if waiting on addresses is not supported
+//========================================================================
+
+int _glfwPlatformWaitAddress( volatile int *address, int value,
+                              double timeout )
+{
+#if defined( _GLFW_HAS_PTHREAD ) && defined( _GLFW_HAS_FUTEX )
+    struct timespec wait;
+
+    if( timeout >= GLFW_INFINITY )
+    {
+        FutexWait( address, value, NULL );
+        return GL_TRUE;
+    }
+
+    if( timeout < 0.0 )
+    {
+        timeout = 0.0;
+    }
+
+    wait.tv_sec = (time_t) timeout;
+    wait.tv_nsec = (long) ((timeout - (double) wait.tv_sec) * 1e9);
+    if( wait.tv_nsec >= 1000000000L )
+    {
+        wait.tv_nsec -= 1000000000L;
+        wait.tv_sec ++;
+    }
+
+    FutexWait( address, value, &wait );
+    return GL_TRUE;
+#else
+    return GL_FALSE;
+#endif
+}
+
+
+//========================================================================
+// Wake up to count threads sleeping on an integer. Returns GL_FALSE if
+// waiting on addresses is not supported
+//========================================================================
+
+int _glfwPlatformWakeAddress( volatile int *address, int count )
+{
+#if defined( _GLFW_HAS_PTHREAD ) && defined( _GLFW_HAS_FUTEX )
+    FutexWake( address, count );
+    return GL_TRUE;
+#else
+    return GL_FALSE;
+#endif
+}
@@ -124,11 +124,9 @@ void _glfwPlatformSleep( double time )
 	return;
     }
 
-    struct timeval  currenttime;
     struct timespec wait;
     pthread_mutex_t mutex;
     pthread_cond_t  cond;
-    long dt_sec, dt_usec;
 
     // Not all pthread implementations have a pthread_sleep() function. We
     // do it the portable way, using a timed wait for a condition that we
@@ -136,21 +134,12 @@ void _glfwPlatformSleep( double time )
     // the entire PROCESS, not a signle thread, which is why we can not
     // use them to implement glfwSleep.
 
-    // Set timeout time, relatvie to current time
-    gettimeofday( &currenttime, NULL );
-    dt_sec  = (long) time;
-    dt_usec = (long) ((time - (double)dt_sec) * 1000000.0);
-    wait.tv_nsec = (currenttime.tv_usec + dt_usec) * 1000L;
-    if( wait.tv_nsec > 1000000000L )
-    {
-        wait.tv_nsec -= 1000000000L;
-        dt_sec++;
-    }
-    wait.tv_sec  = currenttime.tv_sec + dt_sec;
+    // Set timeout time, relative to current time
+    _glfwGetCondDeadline( time, &wait );
 
     // Initialize condition and mutex objects
     pthread_mutex_init( &mutex, NULL );
-    pthread_cond_init( &cond, NULL );
+    _glfwInitCond( &cond );
 
     // Do a timed wait
     pthread_mutex_lock( &mutex );
@@ -0,0 +1,148 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    X11/GLX
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+#include "internal.h"
+
+#ifdef _GLFW_HAS_INOTIFY
+#include <sys/inotify.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+// Changes that may mean a new version of a file is in place
+#define _GLFW_WATCH_EVENTS (IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_MODIFY)
+
+
+
+//************************************************************************
+//****               Platform implementation functions                ****
+//************************************************************************
+
+//========================================================================
+// Create a file system watcher (an inotify instance)
+//========================================================================
+
+int _glfwPlatformCreateWatcher( void )
+{
+#ifdef _GLFW_HAS_INOTIFY
+    int fd;
+
+    fd = inotify_init();
+    if( fd < 0 )
+    {
+        return -1;
+    }
+
+    fcntl( fd, F_SETFL, fcntl( fd, F_GETFL ) | O_NONBLOCK );
+    fcntl( fd, F_SETFD, FD_CLOEXEC );
+
+    return fd;
+#else
+    return -1;
+#endif
+}
+
+
+//========================================================================
+// Destroy a file system watcher
+//========================================================================
+
+void _glfwPlatformDestroyWatcher( int watcher )
+{
+#ifdef _GLFW_HAS_INOTIFY
+    close( watcher );
+#endif
+}
+
+
+//========================================================================
+// Watch a directory for changed files. Returns the directory handle,
+// which is the same for every watch on a directory, or -1.
+//========================================================================
+
+int _glfwPlatformWatchDirectory( int watcher, const char *path )
+{
+#ifdef _GLFW_HAS_INOTIFY
+    return inotify_add_watch( watcher, path, _GLFW_WATCH_EVENTS );
+#else
+    return -1;
+#endif
+}
+
+
+//========================================================================
+// Wait for changes and report them. Returns the number of changes, or -1
+// if the watcher is not usable.
+//========================================================================
+
+int _glfwPlatformWaitWatcher( int watcher, double timeout, _GLFWwatchfun fun )
+{
+#ifdef _GLFW_HAS_INOTIFY
+    struct pollfd pfd;
+    struct inotify_event *event;
+    char buffer[ 4096 ];
+    long size, offset;
+    int count;
+
+    pfd.fd = watcher;
+    pfd.events = POLLIN;
+    if( poll( &pfd, 1, (int) (timeout * 1000.0) ) <= 0 )
+    {
+        return 0;
+    }
+
+    count = 0;
+    for( ;; )
+    {
+        size = (long) read( watcher, buffer, sizeof(buffer) );
+        if( size <= 0 )
+        {
+            break;
+        }
+
+        for( offset = 0;  offset < size;
+             offset += (long) sizeof(struct inotify_event) + event->len )
+        {
+            event = (struct inotify_event *) (buffer + offset);
+            if( event->len > 0 )
+            {
+                fun( event->wd, event->name );
+                count ++;
+            }
+        }
+    }
+
+    return count;
+#else
+    return -1;
+#endif
+}
@@ -0,0 +1,241 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    POSIX
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+//========================================================================
+// Description:
+//
+// Reader for the shared memory frame export (see GL/glfwexport.h). This
+// file does not depend on the GLFW library and can be compiled into any
+// program that wants to consume frames from a GLFW application, e.g.:
+//
+//   cc -I../../include myencoder.c glfwexport.c -lrt
+//
+// Frames are not copied: glfwAcquireExportFrame returns a pointer into
+// the shared memory, and glfwReleaseExportFrame tells whether the
+// producer overwrote the frame while it was being used.
+//
+//========================================================================
+
+#include <GL/glfwexport.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+//========================================================================
+// Reader state
+//========================================================================
+
+struct _GLFWexportreader {
+    unsigned char               *Data;
+    size_t                      Size;
+    const GLFWexportheader      *Header;
+    const GLFWexportslot        *Slot;
+    unsigned int                Sequence;
+};
+
+
+//========================================================================
+// Order memory accesses with respect to the producer
+//========================================================================
+
+static void Barrier( void )
+{
+#if defined(__GNUC__)
+    __sync_synchronize();
+#endif
+}
+
+
+//========================================================================
+// Map the frame ring published under the given name. Returns NULL if
+// there is no such ring (yet).
+//========================================================================
+
+GLFWexportreader *glfwOpenExportReader( const char *name )
+{
+    GLFWexportreader *reader;
+    struct stat st;
+    char *path;
+    void *data;
+    int fd;
+
+    path = (char *) malloc( strlen( name ) + 2 );
+    if( path == NULL )
+    {
+        return NULL;
+    }
+    path[ 0 ] = '/';
+    strcpy( path + 1, name[ 0 ] == '/' ? name + 1 : name );
+
+    fd = shm_open( path, O_RDONLY, 0 );
+    free( path );
+    if( fd < 0 )
+    {
+        return NULL;
+    }
+
+    if( fstat( fd, &st ) != 0 || st.st_size < (off_t) sizeof(GLFWexportheader) )
+    {
+        close( fd );
+        return NULL;
+    }
+
+    data = mmap( NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+    close( fd );
+    if( data == MAP_FAILED )
+    {
+        return NULL;
+    }
+
+    reader = (GLFWexportreader *) malloc( sizeof(GLFWexportreader) );
+    if( reader == NULL )
+    {
+        munmap( data, (size_t) st.st_size );
+        return NULL;
+    }
+
+    reader->Data   = (unsigned char *) data;
+    reader->Size   = (size_t) st.st_size;
+    reader->Header = (const GLFWexportheader *) data;
+    reader->Slot   = NULL;
+
+    // The producer writes the magic last
+    Barrier();
+    if( memcmp( reader->Header->Magic, GLFW_EXPORT_MAGIC, 8 ) != 0 ||
+        reader->Header->Version != GLFW_EXPORT_VERSION ||
+        reader->Header->SlotCount == 0 ||
+        reader->Header->HeaderSize + (size_t) reader->Header->SlotCount *
+            reader->Header->SlotSize > reader->Size )
+    {
+        glfwCloseExportReader( reader );
+        return NULL;
+    }
+
+    return reader;
+}
+
+
+//========================================================================
+// Unmap the frame ring
+//========================================================================
+
+void glfwCloseExportReader( GLFWexportreader *reader )
+{
+    if( reader == NULL )
+    {
+        return;
+    }
+
+    munmap( reader->Data, reader->Size );
+    free( reader );
+}
+
+
+//========================================================================
+// Return non-zero once the producer has stopped exporting
+//========================================================================
+
+int glfwExportClosed( GLFWexportreader *reader )
+{
+    Barrier();
+    return reader->Header->Closed != 0;
+}
+
+
+//========================================================================
+// Get the newest complete frame. Returns a pointer to its pixels and
+// fills in info, or returns NULL if no frame is available right now.
+//========================================================================
+
+const unsigned char *glfwAcquireExportFrame( GLFWexportreader *reader,
+    GLFWexportslot *info )
+{
+    const GLFWexportheader *header = reader->Header;
+    const GLFWexportslot *slot;
+    unsigned int latest;
+
+    reader->Slot = NULL;
+
+    Barrier();
+    latest = header->Latest;
+    if( latest == 0 )
+    {
+        return NULL;
+    }
+
+    slot = (const GLFWexportslot *) (reader->Data + header->HeaderSize +
+               (size_t) ((latest - 1) % header->SlotCount) * header->SlotSize);
+
+    // An odd sequence number means the producer is writing the slot
+    reader->Sequence = slot->Sequence;
+    if( reader->Sequence & 1 )
+    {
+        return NULL;
+    }
+    Barrier();
+
+    info->Sequence  = reader->Sequence;
+    info->Frame     = slot->Frame;
+    info->Width     = slot->Width;
+    info->Height    = slot->Height;
+    info->Format    = slot->Format;
+    info->RowStride = slot->RowStride;
+    info->Time      = slot->Time;
+
+    reader->Slot = slot;
+
+    return (const unsigned char *) (slot + 1);
+}
+
+
+//========================================================================
+// Finish using the frame returned by glfwAcquireExportFrame. Returns zero
+// if the producer reused the slot in the meantime, in which case the
+// pixels read may be torn.
+//========================================================================
+
+int glfwReleaseExportFrame( GLFWexportreader *reader )
+{
+    const GLFWexportslot *slot = reader->Slot;
+
+    if( slot == NULL )
+    {
+        return 0;
+    }
+    reader->Slot = NULL;
+
+    Barrier();
+    return slot->Sequence == reader->Sequence;
+}
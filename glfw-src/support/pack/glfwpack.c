@@ -0,0 +1,343 @@
+//========================================================================
+// GLFW - An OpenGL framework
+// Platform:    Any (command line tool)
+// API version: 2.7
+// WWW:         http://www.glfw.org/
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2010 Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+//========================================================================
+// Description:
+//
+// Writes a GLFW pack file (see lib/pack.c for the layout) from a list of
+// files. Entries are named by their paths as given on the command line,
+// with backslashes turned into slashes and any leading "./" removed, so
+// that they match the names later passed to glfwReadImage.
+//
+// Usage:   glfwpack output.pak file1.tga file2.tga ...
+// Build:   cc -o glfwpack glfwpack.c
+//
+//========================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define HEADER_SIZE 64
+#define ENTRY_SIZE  16
+#define ALIGNMENT   64
+
+
+//========================================================================
+// Entry being packed
+//========================================================================
+
+typedef struct {
+    const char    *Path;
+    char          *Name;
+    unsigned long Hash;
+    unsigned long NameOffset;
+    unsigned long Offset;
+    unsigned long Size;
+} Entry;
+
+
+//========================================================================
+// Store a little endian integer
+//========================================================================
+
+static void PutUint32( unsigned char *p, unsigned long x )
+{
+    p[0] = (unsigned char) (x & 255);
+    p[1] = (unsigned char) ((x >> 8) & 255);
+    p[2] = (unsigned char) ((x >> 16) & 255);
+    p[3] = (unsigned char) ((x >> 24) & 255);
+}
+
+
+//========================================================================
+// Hash a name (32-bit FNV-1a)
+//========================================================================
+
+static unsigned long HashName( const char *name )
+{
+    unsigned long hash = 2166136261UL;
+
+    while( *name )
+    {
+        hash = ((hash ^ (unsigned char) *name++) * 16777619UL) & 0xffffffffUL;
+    }
+
+    return hash;
+}
+
+
+//========================================================================
+// Make an entry name from a path
+//========================================================================
+
+static char *MakeName( const char *path )
+{
+    char *name, *p;
+
+    while( path[0] == '.' && (path[1] == '/' || path[1] == '\\') )
+    {
+        path += 2;
+    }
+
+    name = (char *) malloc( strlen( path ) + 1 );
+    if( name == NULL )
+    {
+        return NULL;
+    }
+    strcpy( name, path );
+
+    for( p = name; *p; p ++ )
+    {
+        if( *p == '\\' )
+        {
+            *p = '/';
+        }
+    }
+
+    return name;
+}
+
+
+//========================================================================
+// Index order: by hash, then by name
+//========================================================================
+
+static int CompareEntries( const void *a, const void *b )
+{
+    const Entry *ea = (const Entry *) a;
+    const Entry *eb = (const Entry *) b;
+
+    if( ea->Hash != eb->Hash )
+    {
+        return ea->Hash < eb->Hash ? -1 : 1;
+    }
+
+    return strcmp( ea->Name, eb->Name );
+}
+
+
+//========================================================================
+// Write zeros up to the next multiple of the alignment
+//========================================================================
+
+static int Pad( FILE *out, unsigned long *offset, unsigned long alignment )
+{
+    static const unsigned char zeros[ ALIGNMENT ];
+    unsigned long count;
+
+    count = (alignment - *offset % alignment) % alignment;
+    if( count && fwrite( zeros, 1, count, out ) != count )
+    {
+        return 0;
+    }
+
+    *offset += count;
+    return 1;
+}
+
+
+//========================================================================
+// Copy a file into the pack
+//========================================================================
+
+static int AppendFile( FILE *out, Entry *entry, unsigned long *offset )
+{
+    unsigned char buffer[ 65536 ];
+    size_t count;
+    FILE *in;
+
+    in = fopen( entry->Path, "rb" );
+    if( in == NULL )
+    {
+        fprintf( stderr, "glfwpack: cannot open %s\n", entry->Path );
+        return 0;
+    }
+
+    entry->Offset = *offset;
+    entry->Size = 0;
+
+    while( (count = fread( buffer, 1, sizeof(buffer), in )) > 0 )
+    {
+        if( fwrite( buffer, 1, count, out ) != count )
+        {
+            fclose( in );
+            return 0;
+        }
+        entry->Size += (unsigned long) count;
+    }
+
+    if( ferror( in ) )
+    {
+        fprintf( stderr, "glfwpack: cannot read %s\n", entry->Path );
+        fclose( in );
+        return 0;
+    }
+
+    fclose( in );
+    *offset += entry->Size;
+
+    return 1;
+}
+
+
+//========================================================================
+// main()
+//========================================================================
+
+int main( int argc, char **argv )
+{
+    unsigned char header[ HEADER_SIZE ], record[ ENTRY_SIZE ];
+    unsigned long offset, namesOffset, namesSize, indexOffset;
+    Entry *entries;
+    FILE *out;
+    int count, i;
+
+    if( argc < 3 )
+    {
+        fprintf( stderr, "Usage: glfwpack output.pak file ...\n" );
+        return 1;
+    }
+
+    count = argc - 2;
+    entries = (Entry *) calloc( count, sizeof(Entry) );
+    if( entries == NULL )
+    {
+        return 1;
+    }
+
+    for( i = 0; i < count; i ++ )
+    {
+        entries[ i ].Path = argv[ i + 2 ];
+        entries[ i ].Name = MakeName( argv[ i + 2 ] );
+        if( entries[ i ].Name == NULL )
+        {
+            return 1;
+        }
+        entries[ i ].Hash = HashName( entries[ i ].Name );
+    }
+
+    qsort( entries, count, sizeof(Entry), CompareEntries );
+
+    for( i = 1; i < count; i ++ )
+    {
+        if( CompareEntries( &entries[ i - 1 ], &entries[ i ] ) == 0 )
+        {
+            fprintf( stderr, "glfwpack: %s given twice\n", entries[ i ].Name );
+            return 1;
+        }
+    }
+
+    out = fopen( argv[1], "wb" );
+    if( out == NULL )
+    {
+        fprintf( stderr, "glfwpack: cannot create %s\n", argv[1] );
+        return 1;
+    }
+
+    // The header is written last, once the offsets are known
+    memset( header, 0, HEADER_SIZE );
+    if( fwrite( header, 1, HEADER_SIZE, out ) != HEADER_SIZE )
+    {
+        goto error;
+    }
+    offset = HEADER_SIZE;
+
+    // Entry data, each entry aligned
+    for( i = 0; i < count; i ++ )
+    {
+        if( !Pad( out, &offset, ALIGNMENT ) ||
+            !AppendFile( out, &entries[ i ], &offset ) )
+        {
+            goto error;
+        }
+    }
+
+    // Name table
+    namesOffset = offset;
+    for( i = 0; i < count; i ++ )
+    {
+        entries[ i ].NameOffset = offset - namesOffset;
+        if( fwrite( entries[ i ].Name, 1, strlen( entries[ i ].Name ) + 1,
+                    out ) != strlen( entries[ i ].Name ) + 1 )
+        {
+            goto error;
+        }
+        offset += (unsigned long) strlen( entries[ i ].Name ) + 1;
+    }
+    namesSize = offset - namesOffset;
+
+    // Index
+    if( !Pad( out, &offset, 4 ) )
+    {
+        goto error;
+    }
+    indexOffset = offset;
+    for( i = 0; i < count; i ++ )
+    {
+        PutUint32( record, entries[ i ].Hash );
+        PutUint32( record + 4, entries[ i ].NameOffset );
+        PutUint32( record + 8, entries[ i ].Offset );
+        PutUint32( record + 12, entries[ i ].Size );
+        if( fwrite( record, 1, ENTRY_SIZE, out ) != ENTRY_SIZE )
+        {
+            goto error;
+        }
+    }
+
+    memcpy( header, "GLFWPAK1", 8 );
+    PutUint32( header + 8, (unsigned long) count );
+    PutUint32( header + 12, indexOffset );
+    PutUint32( header + 16, namesOffset );
+    PutUint32( header + 20, namesSize );
+    if( fseek( out, 0, SEEK_SET ) != 0 ||
+        fwrite( header, 1, HEADER_SIZE, out ) != HEADER_SIZE )
+    {
+        goto error;
+    }
+
+    if( fclose( out ) != 0 )
+    {
+        remove( argv[1] );
+        fprintf( stderr, "glfwpack: cannot write %s\n", argv[1] );
+        return 1;
+    }
+
+    printf( "%d files packed into %s (%lu bytes)\n", count, argv[1],
+            offset + (unsigned long) count * ENTRY_SIZE );
+    return 0;
+
+error:
+    fclose( out );
+    remove( argv[1] );
+    fprintf( stderr, "glfwpack: cannot write %s\n", argv[1] );
+    return 1;
+}
@@ -226,11 +226,20 @@ const
   GLFW_SYSTEM_KEYS          = $00030004;
   GLFW_KEY_REPEAT           = $00030005;
   GLFW_AUTO_POLL_EVENTS     = $00030006;
+  GLFW_TEXTURE_ACCOUNTING   = $00030007;
+  GLFW_TEXTURE_HOT_RELOAD   = $00030008;
+  GLFW_FUTEX_SYNC           = $00030009;
 
   // glfwWaitThread wait modes
   GLFW_WAIT                 = $00040001;
   GLFW_NOWAIT               = $00040002;
 
+  // glfwSetThreadPriority priorities
+  GLFW_THREAD_PRIORITY_LOW      = $00070001;
+  GLFW_THREAD_PRIORITY_NORMAL   = $00070002;
+  GLFW_THREAD_PRIORITY_HIGH     = $00070003;
+  GLFW_THREAD_PRIORITY_REALTIME = $00070004;
+
   // glfwGetJoystickParam tokens
   GLFW_PRESENT              = $00050001;
   GLFW_AXES                 = $00050002;
@@ -241,6 +250,25 @@ const
   GLFW_ORIGIN_UL_BIT        = $00000002;
   GLFW_BUILD_MIPMAPS_BIT    = $00000004; // Only for glfwLoadTexture2D
   GLFW_ALPHA_MAP_BIT        = $00000008;
+  GLFW_PREMULTIPLY_ALPHA_BIT = $00000010;
+  GLFW_EXPAND_RGBA_BIT      = $00000020;
+  GLFW_ALIGN_ROWS_BIT       = $00000040;
+  GLFW_RESCALE_NEAREST_POT_BIT = $00000080;
+  GLFW_INDEXED_BIT          = $00000100;
+  GLFW_INDEX_TEXTURE_BIT    = $00000200;
+  GLFW_TEXTURE_ATLAS_BIT    = $00000400;
+
+  // glfwResizeImage filters
+  GLFW_BOX_FILTER           = $00060001;
+  GLFW_TRIANGLE_FILTER      = $00060002;
+  GLFW_LANCZOS_FILTER       = $00060003;
+
+  // glfwStartRecording flags
+  GLFW_RECORD_DELTA_BIT     = $00000001;
+  GLFW_RECORD_DROP_FRAMES_BIT = $00000002;
+
+  // Most processor groups reported per kind by glfwGetCPUTopology
+  GLFW_MAX_CPU_GROUPS       = 32;
 
   // Time spans longer than this (seconds) are considered to be infinity
   GLFW_INFINITY             = 100000.0;
@@ -265,11 +293,33 @@ type
     Format       : Integer;
     BytesPerPixel: Integer;
     Data         : PChar;
+    RowStride    : Integer;
+    Palette      : PChar;
+    PaletteSize  : Integer;
+    PaletteFormat: Integer;
   end;
   PGLFWimage = ^GLFWimage;
 
+  // Processor topology information used by glfwGetCPUTopology()
+  GLFWcputopology = packed record
+    OnlineCount, UsableCount   : Integer;
+    CoreCount                  : Integer;
+    L2GroupCount, L3GroupCount : Integer;
+    UsableMask                 : Cardinal;
+    CoreMasks                  : array[0..GLFW_MAX_CPU_GROUPS-1] of Cardinal;
+    L2Masks                    : array[0..GLFW_MAX_CPU_GROUPS-1] of Cardinal;
+    L3Masks                    : array[0..GLFW_MAX_CPU_GROUPS-1] of Cardinal;
+  end;
+
+  // Thread statistics used by glfwGetThreadStats()
+  GLFWthreadstats = packed record
+    CreationTime, RunTime, CPUTime           : Double;
+    VoluntarySwitches, InvoluntarySwitches   : LongInt;
+  end;
+
   // Thread ID
   GLFWthread = Integer;
+  PGLFWthread = ^GLFWthread;
 
   // Mutex object
   GLFWmutex = Pointer;
@@ -277,6 +327,21 @@ type
   // Condition variable object
   GLFWcond = Pointer;
 
+  // Thread pool object
+  GLFWpool = Pointer;
+
+  // Task graph object
+  GLFWtaskgraph = Pointer;
+
+  // Single producer, single consumer ring buffer object
+  GLFWring = Pointer;
+
+  // Barrier, reader-writer lock, semaphore and event objects
+  GLFWbarrier = Pointer;
+  GLFWrwlock = Pointer;
+  GLFWsemaphore = Pointer;
+  GLFWthreadevent = Pointer;
+
   // Function pointer types
   GLFWwindowsizefun    = procedure(Width, Height: Integer); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF}
   GLFWwindowclosefun   = function: Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF}
@@ -287,6 +352,9 @@ type
   GLFWkeyfun           = procedure(Key, Action: Integer); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF}
   GLFWcharfun          = procedure(Character, Action: Integer); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF}
   GLFWthreadfun        = procedure(Arg: Pointer); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF}
+  GLFWtextureevictfun  = procedure(Texture: Cardinal; Bytes: LongInt); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF}
+  GLFWcapturefun       = procedure(Image: PGLFWimage); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF}
+  GLFWforfun           = procedure(First, Last: Integer; Arg: Pointer); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF}
 
 
 //========================================================================
@@ -368,6 +436,11 @@ function  glfwCreateThread(fun: GLFWthreadfun; arg: Pointer): GLFWthread; {$IFDE
 procedure glfwDestroyThread(Id: GLFWthread); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 function  glfwWaitThread(Id: GLFWthread; waitmode: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 function  glfwGetThreadID: GLFWthread; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwSetThreadAffinity(Id: GLFWthread; mask: Cardinal): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwSetThreadPriority(Id: GLFWthread; priority: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwSetThreadName(Id: GLFWthread; name: PChar): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwGetThreadStats(Id: GLFWthread; var stats: GLFWthreadstats): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwGetThreads(list: PGLFWthread; maxcount: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 function  glfwCreateMutex: GLFWmutex; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 procedure glfwDestroyMutex( mutex: GLFWmutex); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 procedure glfwLockMutex(mutex: GLFWmutex); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
@@ -375,9 +448,54 @@ procedure glfwUnlockMutex(mutex: GLFWmutex); {$IFDEF WIN32} stdcall; {$ELSE} cde
 function  glfwCreateCond: GLFWcond; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 procedure glfwDestroyCond(cond: GLFWcond); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 procedure glfwWaitCond(cond: GLFWcond; mutex: GLFWmutex; timeout: Double); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwWaitCondUntil(cond: GLFWcond; mutex: GLFWmutex; time: Double); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 procedure glfwSignalCond(cond: GLFWcond); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 procedure glfwBroadcastCond(cond: GLFWcond); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 function  glfwGetNumberOfProcessors: Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwGetCPUTopology(var topology: GLFWcputopology): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+
+// Thread pools
+function  glfwCreateThreadPool(threads: Integer): GLFWpool; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwDestroyThreadPool(pool: GLFWpool); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwSubmitJob(pool: GLFWpool; fun: GLFWthreadfun; arg: Pointer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwWaitThreadPool(pool: GLFWpool); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwParallelFor(pool: GLFWpool; first, last, grain: Integer; fun: GLFWforfun; arg: Pointer); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+
+// Task graphs
+function  glfwCreateTaskGraph(pool: GLFWpool): GLFWtaskgraph; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwDestroyTaskGraph(graph: GLFWtaskgraph); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwAddTask(graph: GLFWtaskgraph; fun: GLFWthreadfun; arg: Pointer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwAddTaskDependency(graph: GLFWtaskgraph; task, dependency: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwRunTaskGraph(graph: GLFWtaskgraph): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+
+// Ring buffers
+function  glfwCreateRing(size, capacity: Integer): GLFWring; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwDestroyRing(ring: GLFWring); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwTryPushRing(ring: GLFWring; element: Pointer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwTryPopRing(ring: GLFWring; element: Pointer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwPushRingBatch(ring: GLFWring; elements: Pointer; count: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwPopRingBatch(ring: GLFWring; elements: Pointer; count: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwPushRing(ring: GLFWring; element: Pointer; timeout: Double): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwPopRing(ring: GLFWring; element: Pointer; timeout: Double): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+
+// Barriers, reader-writer locks, semaphores and events
+function  glfwCreateBarrier(count: Integer): GLFWbarrier; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwDestroyBarrier(barrier: GLFWbarrier); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwWaitBarrier(barrier: GLFWbarrier; timeout: Double): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwCreateRWLock: GLFWrwlock; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwDestroyRWLock(lock: GLFWrwlock); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwReadLockRWLock(lock: GLFWrwlock; timeout: Double): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwWriteLockRWLock(lock: GLFWrwlock; timeout: Double): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwUnlockRWLock(lock: GLFWrwlock); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwCreateSemaphore(count: Integer): GLFWsemaphore; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwDestroySemaphore(semaphore: GLFWsemaphore); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwWaitSemaphore(semaphore: GLFWsemaphore; timeout: Double): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwPostSemaphore(semaphore: GLFWsemaphore; count: Integer); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwCreateThreadEvent(manualreset, signaled: Integer): GLFWthreadevent; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwDestroyThreadEvent(event: GLFWthreadevent); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwWaitThreadEvent(event: GLFWthreadevent; timeout: Double): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwSetThreadEvent(event: GLFWthreadevent); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwResetThreadEvent(event: GLFWthreadevent); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 
 // Enable/disable functions
 procedure glfwEnable(token: Integer); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
@@ -387,9 +505,53 @@ procedure glfwDisable(token: Integer); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$
 function  glfwReadImage(name: PChar; image: PGLFWimage; flags: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 function  glfwReadMemoryImage(data: Pointer; size: LongInt; img: PGLFWimage; flags: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 procedure glfwFreeImage(img: PGLFWimage);  {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwWriteImage(name: PChar; img: PGLFWimage; flags: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwResizeImage(src: PGLFWimage; dst: PGLFWimage; width, height, filter: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 function  glfwLoadTexture2D(name: PChar; flags: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 function  glfwLoadMemoryTexture2D(data: Pointer; size: LongInt; flags: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 function  glfwLoadTextureImage2D(img: PGLFWimage; flags: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwLoadPaletteTexture2D(img: PGLFWimage): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwUpdateTextureRegion(img: PGLFWimage; srcX, srcY, width, height, dstX, dstY, flags: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwLoadTextureArray(layers: PGLFWimage; count, flags: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwLoadTextureArrayFiles(names: PPChar; count, flags: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+
+// Texture streaming
+function  glfwStreamTextureImage2D(img: PGLFWimage; flags: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwUpdateTextureStreams(budget: Integer): LongInt; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwGetTextureStreamProgress(texture: Cardinal): Double; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwCancelTextureStream(texture: Cardinal); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+
+// Texture memory accounting
+procedure glfwSetTextureBudget(bytes: LongInt); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwSetTextureEvictCallback(cbfun: GLFWtextureevictfun); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwTouchTexture(texture: Cardinal); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwForgetTexture(texture: Cardinal); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwGetTextureMemory(texture: Cardinal; var format: Integer; var compressed: Integer): LongInt; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwGetLeastRecentTextures(list: PCardinal; maxcount: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwGetTextureMemoryStats(var used: LongInt; var budget: LongInt; var count: Integer; var evictions: LongInt); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+
+// Asynchronous frame capture
+function  glfwCaptureFrameAsync(name: PChar; cbfun: GLFWcapturefun): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwWaitCaptures; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+
+// Frame recording
+function  glfwStartRecording(name: PChar; flags: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwStopRecording; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwGetRecordingStats(var recorded: Integer; var written: Integer; var dropped: Integer); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+
+// Shared memory frame export
+function  glfwStartExport(name: PChar; slots: Integer): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwStopExport; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwGetExportStats(var exported: Integer; var skipped: Integer); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+
+// Pack files
+function  glfwMountPack(path: PChar): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwUnmountPack(path: PChar): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+
+// Texture hot reloading
+function  glfwPollImageReload(img: PGLFWimage; var name: PChar; var texture: Cardinal): Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+function  glfwReloadTextures: Integer; {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
+procedure glfwUnwatchImage(name: PChar); {$IFDEF WIN32} stdcall; {$ELSE} cdecl; {$ENDIF} external {$IFDEF LINK_DYNAMIC} DLLNAME {$ENDIF};
 
 implementation
 
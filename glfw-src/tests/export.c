@@ -0,0 +1,110 @@
+//========================================================================
+// Shared memory frame export test
+// Copyright (c) Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test publishes its frames in a shared memory ring, to be picked up
+// by the exportread test. The red channel of the background encodes the
+// frame number, so the reader can verify what it receives
+//
+// Usage: export [name] [frame count]
+//
+//========================================================================
+
+#include <GL/glfw.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+static void GLFWCALL window_size_callback(int width, int height)
+{
+    glViewport(0, 0, width, height);
+}
+
+int main(int argc, char** argv)
+{
+    const char* name = "glfw-export";
+    int frame, count = 0, exported, skipped;
+    float position;
+
+    if (argc > 1)
+        name = argv[1];
+    if (argc > 2)
+        count = atoi(argv[2]);
+
+    if (!glfwInit())
+    {
+        fprintf(stderr, "Failed to initialize GLFW\n");
+        exit(1);
+    }
+
+    if (!glfwOpenWindow(320, 240, 0, 0, 0, 0, 0, 0, GLFW_WINDOW))
+    {
+        glfwTerminate();
+
+        fprintf(stderr, "Failed to open GLFW window\n");
+        exit(1);
+    }
+
+    glfwSetWindowTitle("Frame Export");
+    glfwSetWindowSizeCallback(window_size_callback);
+    glfwSwapInterval(1);
+
+    if (!glfwStartExport(name, 4))
+    {
+        glfwTerminate();
+
+        fprintf(stderr, "Failed to create shared memory ring %s\n", name);
+        exit(1);
+    }
+
+    printf("Exporting frames as %s\n", name);
+
+    glColor3f(1.f, 1.f, 1.f);
+
+    glMatrixMode(GL_PROJECTION);
+    glOrtho(-1.f, 1.f, -1.f, 1.f, 1.f, -1.f);
+    glMatrixMode(GL_MODELVIEW);
+
+    for (frame = 0;  count == 0 || frame < count;  frame++)
+    {
+        if (glfwGetWindowParam(GLFW_OPENED) != GL_TRUE)
+            break;
+
+        glClearColor((frame & 255) / 255.f, 0.f, 0.f, 0.f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        position = cosf(glfwGetTime() * 4.f) * 0.5f + 0.25f;
+        glRectf(position - 0.25f, -1.f, position + 0.25f, 1.f);
+
+        glfwSwapBuffers();
+    }
+
+    glfwStopExport();
+    glfwGetExportStats(&exported, &skipped);
+    printf("%i frames exported, %i skipped\n", exported, skipped);
+
+    glfwTerminate();
+    exit(0);
+}
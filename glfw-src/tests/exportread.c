@@ -0,0 +1,95 @@
+//========================================================================
+// Shared memory frame export reader test
+// Copyright (c) Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test reads the frames published by the export test, using only
+// the reader in support/export (not the GLFW library). It checks that the
+// background colour matches each frame number and reports missed frames
+//
+// Usage: exportread [name]
+//
+//========================================================================
+
+#include <GL/glfwexport.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define GL_BGRA 0x80E1
+
+int main(int argc, char** argv)
+{
+    const char* name = "glfw-export";
+    GLFWexportreader* reader;
+    GLFWexportslot info;
+    const unsigned char* pixels;
+    int red, received = 0, missed = 0, torn = 0, wrong = 0;
+    unsigned int last = 0;
+
+    if (argc > 1)
+        name = argv[1];
+
+    // Wait for the producer to start
+    while (!(reader = glfwOpenExportReader(name)))
+        usleep(10000);
+
+    printf("Reading frames from %s\n", name);
+
+    while (!glfwExportClosed(reader))
+    {
+        pixels = glfwAcquireExportFrame(reader, &info);
+        if (!pixels || (received && info.Frame == last))
+        {
+            glfwReleaseExportFrame(reader);
+            usleep(1000);
+            continue;
+        }
+
+        // The bottom left pixel has the background colour
+        red = pixels[info.Format == GL_BGRA ? 2 : 0];
+
+        if (!glfwReleaseExportFrame(reader))
+        {
+            torn++;
+            continue;
+        }
+
+        if (red != (int) (info.Frame & 255))
+            wrong++;
+
+        if (received && info.Frame > last + 1)
+            missed += info.Frame - last - 1;
+
+        last = info.Frame;
+        received++;
+    }
+
+    glfwCloseExportReader(reader);
+
+    printf("%i frames received, %i missed, %i torn, %i wrong\n",
+           received, missed, torn, wrong);
+
+    exit(wrong ? 1 : 0);
+}
@@ -0,0 +1,501 @@
+//========================================================================
+// Thread pool benchmark and correctness test
+// Copyright (c) Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This program runs a particle system update for a number of frames in
+// four ways and reports the time per frame of each:
+//
+//   pingpong     one thread per slice, started and collected every frame
+//                with a mutex and two condition variables, in the style
+//                of the particles example
+//   submit       one glfwSubmitJob per slice, then glfwWaitThreadPool
+//   parallelfor  glfwParallelFor over all particles
+//   taskgraph    a task graph built once and run every frame, with an
+//                update task and a dependent culling task per slice and
+//                a final task that depends on all culling tasks
+//
+// The main thread does its share of the work in all cases but submit.
+// With -u the cost per particle is uneven, so that fixed slices leave
+// some threads idle while others are still working.
+//
+// All four must produce exactly the same particles, and the task graph
+// must count the same number of visible particles as a serial pass; the
+// exit status is non-zero if they do not. Finally, the run time, CPU time
+// and context switches of every thread are listed, which shows how busy
+// the pool workers were.
+//
+//========================================================================
+
+#include <GL/glfw.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "getopt.h"
+
+typedef struct
+{
+    float x, y, z;
+    float vx, vy, vz;
+} Particle;
+
+static Particle* particles;
+static int count = 200000;
+static int frames = 200;
+static int uneven = GL_FALSE;
+
+// Number of threads besides the main thread
+static int threads = 0;
+
+// Task graph slices and their visible particle counts
+#define GRAPH_SLICES 32
+static int visible[GRAPH_SLICES];
+static int total_visible;
+
+// Ping-pong synchronization
+static struct
+{
+    GLFWmutex lock;
+    GLFWcond  go;
+    GLFWcond  done;
+    int       frame;
+    int       pending;
+    int       quit;
+} pingpong;
+
+static void usage(void)
+{
+    printf("poolbench [-h] [-u] [-n PARTICLES] [-f FRAMES] [-t THREADS] [-g GRAIN]\n");
+}
+
+static void reset_particles(void)
+{
+    int i;
+
+    for (i = 0;  i < count;  i++)
+    {
+        particles[i].x = (float) (i % 97) * 0.1f;
+        particles[i].y = (float) (i % 89) * 0.1f;
+        particles[i].z = (float) (i % 83) * 0.1f;
+        particles[i].vx = (float) ((i * 7) % 31) * 0.01f - 0.15f;
+        particles[i].vy = (float) ((i * 11) % 29) * 0.05f;
+        particles[i].vz = (float) ((i * 13) % 37) * 0.01f - 0.18f;
+    }
+}
+
+static void update_particles(int first, int last)
+{
+    int i, j, steps;
+    const float dt = 0.01f;
+
+    for (i = first;  i < last;  i++)
+    {
+        Particle* p = particles + i;
+
+        // With uneven costs, the first tenth of the particles does most of
+        // the work
+        steps = 4;
+        if (uneven && i < count / 10)
+            steps = 64;
+
+        for (j = 0;  j < steps;  j++)
+        {
+            p->vy -= 9.81f * dt / steps;
+            p->vx *= 0.999f;
+            p->vz *= 0.999f;
+
+            p->x += p->vx * dt / steps;
+            p->y += p->vy * dt / steps;
+            p->z += p->vz * dt / steps;
+
+            if (p->y < 0.f)
+            {
+                p->y = -p->y;
+                p->vy = -p->vy * 0.8f;
+            }
+        }
+
+        p->x += sinf(p->z) * 0.0001f;
+    }
+}
+
+static void slice_range(int slice, int slices, int* first, int* last)
+{
+    *first = (int) ((double) count * slice / slices);
+    *last = (int) ((double) count * (slice + 1) / slices);
+}
+
+static void GLFWCALL pingpong_thread(void* arg)
+{
+    int slice = (int) (long) arg;
+    int first, last, quit, frame = 0;
+
+    slice_range(slice, threads + 1, &first, &last);
+
+    for (;;)
+    {
+        glfwLockMutex(pingpong.lock);
+        while (pingpong.frame == frame && !pingpong.quit)
+            glfwWaitCond(pingpong.go, pingpong.lock, GLFW_INFINITY);
+        frame = pingpong.frame;
+        quit = pingpong.quit;
+        glfwUnlockMutex(pingpong.lock);
+
+        if (quit)
+            break;
+
+        update_particles(first, last);
+
+        glfwLockMutex(pingpong.lock);
+        if (--pingpong.pending == 0)
+            glfwSignalCond(pingpong.done);
+        glfwUnlockMutex(pingpong.lock);
+    }
+}
+
+static double run_pingpong(void)
+{
+    GLFWthread* ids;
+    double start, elapsed;
+    int i, first, last;
+
+    pingpong.lock = glfwCreateMutex();
+    pingpong.go = glfwCreateCond();
+    pingpong.done = glfwCreateCond();
+    pingpong.frame = 0;
+    pingpong.quit = GL_FALSE;
+
+    ids = (GLFWthread*) malloc(threads * sizeof(GLFWthread));
+    for (i = 0;  i < threads;  i++)
+        ids[i] = glfwCreateThread(pingpong_thread, (void*) (long) (i + 1));
+
+    slice_range(0, threads + 1, &first, &last);
+
+    start = glfwGetTime();
+
+    for (i = 0;  i < frames;  i++)
+    {
+        glfwLockMutex(pingpong.lock);
+        pingpong.pending = threads;
+        pingpong.frame++;
+        glfwBroadcastCond(pingpong.go);
+        glfwUnlockMutex(pingpong.lock);
+
+        update_particles(first, last);
+
+        glfwLockMutex(pingpong.lock);
+        while (pingpong.pending > 0)
+            glfwWaitCond(pingpong.done, pingpong.lock, GLFW_INFINITY);
+        glfwUnlockMutex(pingpong.lock);
+    }
+
+    elapsed = glfwGetTime() - start;
+
+    glfwLockMutex(pingpong.lock);
+    pingpong.quit = GL_TRUE;
+    glfwBroadcastCond(pingpong.go);
+    glfwUnlockMutex(pingpong.lock);
+
+    for (i = 0;  i < threads;  i++)
+        glfwWaitThread(ids[i], GLFW_WAIT);
+
+    free(ids);
+    glfwDestroyCond(pingpong.go);
+    glfwDestroyCond(pingpong.done);
+    glfwDestroyMutex(pingpong.lock);
+
+    return elapsed;
+}
+
+static void GLFWCALL submit_job(void* arg)
+{
+    int first, last;
+
+    slice_range((int) (long) arg, threads + 1, &first, &last);
+    update_particles(first, last);
+}
+
+static double run_submit(GLFWpool pool)
+{
+    double start;
+    int i, j;
+
+    start = glfwGetTime();
+
+    for (i = 0;  i < frames;  i++)
+    {
+        for (j = 0;  j <= threads;  j++)
+            glfwSubmitJob(pool, submit_job, (void*) (long) j);
+
+        glfwWaitThreadPool(pool);
+    }
+
+    return glfwGetTime() - start;
+}
+
+static void GLFWCALL parallel_for_range(int first, int last, void* arg)
+{
+    update_particles(first, last);
+}
+
+static double run_parallel_for(GLFWpool pool, int grain)
+{
+    double start;
+    int i;
+
+    start = glfwGetTime();
+
+    for (i = 0;  i < frames;  i++)
+        glfwParallelFor(pool, 0, count, grain, parallel_for_range, NULL);
+
+    return glfwGetTime() - start;
+}
+
+static int count_visible(int first, int last)
+{
+    int i, result = 0;
+
+    for (i = first;  i < last;  i++)
+    {
+        if (particles[i].y < 1.f)
+            result++;
+    }
+
+    return result;
+}
+
+static void GLFWCALL update_task(void* arg)
+{
+    int first, last;
+
+    slice_range((int) (long) arg, GRAPH_SLICES, &first, &last);
+    update_particles(first, last);
+}
+
+static void GLFWCALL cull_task(void* arg)
+{
+    int slice = (int) (long) arg;
+    int first, last;
+
+    slice_range(slice, GRAPH_SLICES, &first, &last);
+    visible[slice] = count_visible(first, last);
+}
+
+static void GLFWCALL sum_task(void* arg)
+{
+    int i;
+
+    total_visible = 0;
+    for (i = 0;  i < GRAPH_SLICES;  i++)
+        total_visible += visible[i];
+}
+
+static double run_task_graph(GLFWpool pool)
+{
+    GLFWtaskgraph graph;
+    double start;
+    int i, update, cull, sum;
+
+    graph = glfwCreateTaskGraph(pool);
+    sum = glfwAddTask(graph, sum_task, NULL);
+
+    for (i = 0;  i < GRAPH_SLICES;  i++)
+    {
+        update = glfwAddTask(graph, update_task, (void*) (long) i);
+        cull = glfwAddTask(graph, cull_task, (void*) (long) i);
+        glfwAddTaskDependency(graph, cull, update);
+        glfwAddTaskDependency(graph, sum, cull);
+    }
+
+    start = glfwGetTime();
+
+    for (i = 0;  i < frames;  i++)
+        glfwRunTaskGraph(graph);
+
+    start = glfwGetTime() - start;
+
+    glfwDestroyTaskGraph(graph);
+    return start;
+}
+
+static void report_threads(void)
+{
+    GLFWthread ids[64];
+    GLFWthreadstats stats;
+    int i, count;
+
+    printf("\n%-8s %10s %10s %10s %10s\n",
+           "thread", "run s", "cpu s", "voluntary", "preempted");
+
+    count = glfwGetThreads(ids, 64);
+    for (i = 0;  i < count;  i++)
+    {
+        if (!glfwGetThreadStats(ids[i], &stats))
+            continue;
+
+        printf("%-8i %10.3f %10.3f %10li %10li\n",
+               ids[i], stats.RunTime, stats.CPUTime,
+               stats.VoluntarySwitches, stats.InvoluntarySwitches);
+    }
+}
+
+static void report(const char* name, double elapsed)
+{
+    printf("%-12s %10.3f ms/frame %10.1f Mparticles/s\n",
+           name,
+           elapsed * 1000.0 / frames,
+           (double) count * frames / elapsed / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, grain = 0, failures = 0;
+    Particle* expected;
+    GLFWcputopology topology;
+    GLFWpool pool;
+    double elapsed;
+
+    while ((ch = getopt(argc, argv, "hun:f:t:g:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(0);
+
+            case 'u':
+                uneven = GL_TRUE;
+                break;
+
+            case 'n':
+                count = atoi(optarg);
+                break;
+
+            case 'f':
+                frames = atoi(optarg);
+                break;
+
+            case 't':
+                threads = atoi(optarg);
+                break;
+
+            case 'g':
+                grain = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                exit(1);
+        }
+    }
+
+    if (count < 1 || frames < 1)
+    {
+        usage();
+        exit(1);
+    }
+
+    if (!glfwInit())
+    {
+        fprintf(stderr, "Failed to initialize GLFW\n");
+        exit(1);
+    }
+
+    if (threads <= 0)
+    {
+        glfwGetCPUTopology(&topology);
+        threads = topology.UsableCount - 1;
+    }
+    if (threads < 1)
+        threads = 1;
+
+    glfwGetCPUTopology(&topology);
+    printf("%i processors, %i usable, %i cores, %i L2 and %i L3 groups\n",
+           topology.OnlineCount, topology.UsableCount, topology.CoreCount,
+           topology.L2GroupCount, topology.L3GroupCount);
+    printf("%i threads plus the main thread\n", threads);
+    printf("%i particles, %i frames, %s cost per particle\n\n",
+           count, frames, uneven ? "uneven" : "even");
+
+    particles = (Particle*) malloc(count * sizeof(Particle));
+    expected = (Particle*) malloc(count * sizeof(Particle));
+
+    pool = glfwCreateThreadPool(threads);
+    if (!particles || !expected || !pool)
+    {
+        fprintf(stderr, "Failed to create thread pool\n");
+        exit(1);
+    }
+
+    reset_particles();
+    elapsed = run_pingpong();
+    report("pingpong", elapsed);
+    memcpy(expected, particles, count * sizeof(Particle));
+
+    reset_particles();
+    elapsed = run_submit(pool);
+    report("submit", elapsed);
+    if (memcmp(expected, particles, count * sizeof(Particle)) != 0)
+    {
+        fprintf(stderr, "submit: particles differ from pingpong\n");
+        failures++;
+    }
+
+    reset_particles();
+    elapsed = run_parallel_for(pool, grain);
+    report("parallelfor", elapsed);
+    if (memcmp(expected, particles, count * sizeof(Particle)) != 0)
+    {
+        fprintf(stderr, "parallelfor: particles differ from pingpong\n");
+        failures++;
+    }
+
+    reset_particles();
+    elapsed = run_task_graph(pool);
+    report("taskgraph", elapsed);
+    if (memcmp(expected, particles, count * sizeof(Particle)) != 0)
+    {
+        fprintf(stderr, "taskgraph: particles differ from pingpong\n");
+        failures++;
+    }
+    if (total_visible != count_visible(0, count))
+    {
+        fprintf(stderr, "taskgraph: visible count is %i, expected %i\n",
+                total_visible, count_visible(0, count));
+        failures++;
+    }
+
+    report_threads();
+
+    glfwDestroyThreadPool(pool);
+
+    free(particles);
+    free(expected);
+
+    glfwTerminate();
+    exit(failures ? 1 : 0);
+}
+
@@ -0,0 +1,297 @@
+//========================================================================
+// Ring buffer benchmark and correctness test
+// Copyright (c) Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//========================================================================
+//
+// This program passes a sequence of integers from a producer thread to
+// the main thread and reports the time per element for:
+//
+//   queue        a bounded queue protected by a mutex, with condition
+//                variables for full and empty, in the usual style
+//   ring         glfwPushRing and glfwPopRing, one element at a time
+//   batch        glfwPushRingBatch and glfwPopRingBatch, falling back to
+//                the blocking calls when the ring is full or empty
+//
+// The consumer checks that every element arrives exactly once and in
+// order; the exit status is non-zero if any does not.
+//
+//========================================================================
+
+#include <GL/glfw.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static int count = 1000000;
+static int capacity = 1024;
+static int batch = 64;
+
+// Mutex protected queue
+static struct
+{
+    GLFWmutex lock;
+    GLFWcond  notfull;
+    GLFWcond  notempty;
+    int*      elements;
+    int       head;
+    int       size;
+} queue;
+
+static GLFWring ring;
+
+static void usage(void)
+{
+    printf("ringbench [-h] [-n ELEMENTS] [-c CAPACITY] [-b BATCH]\n");
+}
+
+static void GLFWCALL queue_producer(void* arg)
+{
+    int i;
+
+    for (i = 0;  i < count;  i++)
+    {
+        glfwLockMutex(queue.lock);
+        while (queue.size == capacity)
+            glfwWaitCond(queue.notfull, queue.lock, GLFW_INFINITY);
+        queue.elements[(queue.head + queue.size) % capacity] = i;
+        queue.size++;
+        glfwUnlockMutex(queue.lock);
+        glfwSignalCond(queue.notempty);
+    }
+}
+
+static int run_queue(void)
+{
+    GLFWthread producer;
+    int i, value, errors = 0;
+
+    queue.lock = glfwCreateMutex();
+    queue.notfull = glfwCreateCond();
+    queue.notempty = glfwCreateCond();
+    queue.elements = (int*) malloc(capacity * sizeof(int));
+    queue.head = queue.size = 0;
+
+    producer = glfwCreateThread(queue_producer, NULL);
+
+    for (i = 0;  i < count;  i++)
+    {
+        glfwLockMutex(queue.lock);
+        while (queue.size == 0)
+            glfwWaitCond(queue.notempty, queue.lock, GLFW_INFINITY);
+        value = queue.elements[queue.head];
+        queue.head = (queue.head + 1) % capacity;
+        queue.size--;
+        glfwUnlockMutex(queue.lock);
+        glfwSignalCond(queue.notfull);
+
+        if (value != i)
+            errors++;
+    }
+
+    glfwWaitThread(producer, GLFW_WAIT);
+
+    free(queue.elements);
+    glfwDestroyCond(queue.notfull);
+    glfwDestroyCond(queue.notempty);
+    glfwDestroyMutex(queue.lock);
+
+    return errors;
+}
+
+static void GLFWCALL ring_producer(void* arg)
+{
+    int i;
+
+    for (i = 0;  i < count;  i++)
+        glfwPushRing(ring, &i, GLFW_INFINITY);
+}
+
+static int run_ring(void)
+{
+    GLFWthread producer;
+    int i, value, errors = 0;
+
+    producer = glfwCreateThread(ring_producer, NULL);
+
+    for (i = 0;  i < count;  i++)
+    {
+        glfwPopRing(ring, &value, GLFW_INFINITY);
+        if (value != i)
+            errors++;
+    }
+
+    glfwWaitThread(producer, GLFW_WAIT);
+    return errors;
+}
+
+static void GLFWCALL batch_producer(void* arg)
+{
+    int* values = (int*) malloc(batch * sizeof(int));
+    int i, j, n, pushed;
+
+    for (i = 0;  i < count;  i += n)
+    {
+        n = count - i;
+        if (n > batch)
+            n = batch;
+
+        for (j = 0;  j < n;  j++)
+            values[j] = i + j;
+
+        for (pushed = 0;  pushed < n;  )
+        {
+            j = glfwPushRingBatch(ring, values + pushed, n - pushed);
+            if (j == 0)
+            {
+                glfwPushRing(ring, values + pushed, GLFW_INFINITY);
+                j = 1;
+            }
+
+            pushed += j;
+        }
+    }
+
+    free(values);
+}
+
+static int run_batch(void)
+{
+    GLFWthread producer;
+    int* values = (int*) malloc(batch * sizeof(int));
+    int i, j, n, expected = 0, errors = 0;
+
+    producer = glfwCreateThread(batch_producer, NULL);
+
+    while (expected < count)
+    {
+        n = glfwPopRingBatch(ring, values, batch);
+        if (n == 0)
+        {
+            glfwPopRing(ring, values, GLFW_INFINITY);
+            n = 1;
+        }
+
+        for (j = 0;  j < n;  j++)
+        {
+            if (values[j] != expected + j)
+                errors++;
+        }
+
+        expected += n;
+    }
+
+    glfwWaitThread(producer, GLFW_WAIT);
+
+    // Nothing must be left over
+    if (glfwTryPopRing(ring, &i))
+        errors++;
+
+    free(values);
+    return errors;
+}
+
+static int report(const char* name, int (*run)(void))
+{
+    double start, elapsed;
+    int errors;
+
+    start = glfwGetTime();
+    errors = run();
+    elapsed = glfwGetTime() - start;
+
+    printf("%-8s %10.1f ns/element %10.2f Melements/s\n",
+           name,
+           elapsed * 1e9 / count,
+           count / elapsed / 1e6);
+
+    if (errors)
+        fprintf(stderr, "%s: %i elements out of order\n", name, errors);
+
+    return errors;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, failures = 0;
+
+    while ((ch = getopt(argc, argv, "hn:c:b:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(0);
+
+            case 'n':
+                count = atoi(optarg);
+                break;
+
+            case 'c':
+                capacity = atoi(optarg);
+                break;
+
+            case 'b':
+                batch = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                exit(1);
+        }
+    }
+
+    if (count < 1 || capacity < 1 || batch < 1)
+    {
+        usage();
+        exit(1);
+    }
+
+    if (!glfwInit())
+    {
+        fprintf(stderr, "Failed to initialize GLFW\n");
+        exit(1);
+    }
+
+    ring = glfwCreateRing(sizeof(int), capacity);
+    if (!ring)
+    {
+        fprintf(stderr, "Failed to create ring buffer\n");
+        exit(1);
+    }
+
+    printf("%i elements, capacity %i, batches of %i\n\n",
+           count, capacity, batch);
+
+    failures += report("queue", run_queue);
+    failures += report("ring", run_ring);
+    failures += report("batch", run_batch);
+
+    glfwDestroyRing(ring);
+
+    glfwTerminate();
+    exit(failures ? 1 : 0);
+}
+
@@ -0,0 +1,685 @@
+//========================================================================
+// TGA decoder benchmark and correctness test
+// Copyright (c) Camilla Berglund <elmindreda@elmindreda.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This program generates synthetic TGA files for every path through the
+// TGA reader (raw and RLE; gray, true color and color mapped; 8, 24 and
+// 32 bits per pixel; all four origins) in a range of sizes. It checks
+// that each decodes to the pixels it was generated from, and measures
+// the time spent in each stage of the image pipeline:
+//
+//   decode   glfwReadMemoryImage with GLFW_NO_RESCALE_BIT
+//   rescale  glfwReadMemoryImage without it, minus decode
+//   upload   glfwLoadTextureImage2D
+//   mipmaps  glfwLoadTextureImage2D with GLFW_BUILD_MIPMAPS_BIT, minus upload
+//   total    glfwLoadMemoryTexture2D with GLFW_BUILD_MIPMAPS_BIT
+//
+// Throughput is given in MB of decoded pixels per second. The results are
+// written as JSON, so that runs before and after a change can be compared.
+//
+// The texture stages need an OpenGL context. Without a display (or with
+// -g) only the decoding stages are run; use xvfb-run to run all of them
+// on a headless machine. The exit status is non-zero if any image was
+// decoded or uploaded incorrectly.
+//
+//========================================================================
+
+#include <GL/glfw.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "getopt.h"
+
+#define PALETTE_SIZE 251
+
+typedef struct
+{
+    const char* name;
+    int type;           // TGA image type, without the RLE bit
+    int bits;           // Bits per stored pixel
+    int cmapbits;       // Bits per color map entry, or zero
+} Format;
+
+static const Format formats[] =
+{
+    { "gray8", 3, 8, 0 },
+    { "rgb24", 2, 24, 0 },
+    { "rgba32", 2, 32, 0 },
+    { "cmap24", 1, 8, 24 },
+    { "cmap32", 1, 8, 32 }
+};
+
+// Origins, in the order of the TGA descriptor bits
+static const char* origins[] = { "bl", "br", "ul", "ur" };
+
+static const int sizes[][2] =
+{
+    { 64, 64 },
+    { 333, 200 },
+    { 1024, 1024 }
+};
+
+typedef struct
+{
+    int width, height, bpp;
+    unsigned char* pixels;      // Expected pixels, bottom row first
+    unsigned char* file;
+    long size;
+} Case;
+
+typedef struct
+{
+    double seconds;             // Per iteration
+    int iterations;
+} Stage;
+
+static double min_time = 0.05;
+static int use_timer = GL_FALSE;
+static int failures = 0;
+
+static void usage(void)
+{
+    printf("tgabench [-h] [-g] [-t SECONDS] [-o FILE]\n");
+}
+
+static double get_time(void)
+{
+    if (use_timer)
+        return glfwGetTime();
+
+    return (double) clock() / CLOCKS_PER_SEC;
+}
+
+static unsigned int hash(unsigned int x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352d;
+    x ^= x >> 15;
+    x *= 0x846ca68b;
+    x ^= x >> 16;
+    return x;
+}
+
+// Flat blocks become RLE runs, while noisy blocks become raw packets
+static unsigned int pattern(int x, int y)
+{
+    if (((x >> 3) + (y >> 3)) & 1)
+        return hash((unsigned int) (y >> 3) * 977u + (unsigned int) (x >> 3));
+
+    return hash((unsigned int) y * 65537u + (unsigned int) x);
+}
+
+//========================================================================
+// Encode a scanline using TGA run-length packets
+//========================================================================
+
+static unsigned char* encode_rle(unsigned char* dst,
+                                 const unsigned char* src,
+                                 int count, int bpp)
+{
+    int i = 0, run, raw;
+
+    while (i < count)
+    {
+        run = 1;
+        while (i + run < count && run < 128 &&
+               memcmp(src + i * bpp, src + (i + run) * bpp, bpp) == 0)
+        {
+            run++;
+        }
+
+        if (run > 1)
+        {
+            *dst++ = (unsigned char) (0x80 | (run - 1));
+            memcpy(dst, src + i * bpp, bpp);
+            dst += bpp;
+            i += run;
+            continue;
+        }
+
+        raw = 1;
+        while (i + raw < count && raw < 128 &&
+               (i + raw + 1 >= count ||
+                memcmp(src + (i + raw) * bpp,
+                       src + (i + raw + 1) * bpp, bpp) != 0))
+        {
+            raw++;
+        }
+
+        *dst++ = (unsigned char) (raw - 1);
+        memcpy(dst, src + i * bpp, raw * bpp);
+        dst += raw * bpp;
+        i += raw;
+    }
+
+    return dst;
+}
+
+//========================================================================
+// Generate a TGA file along with the pixels it should decode to
+//========================================================================
+
+static int generate(Case* c, const Format* format, int rle, int origin,
+                    int width, int height)
+{
+    unsigned char palette[PALETTE_SIZE * 4];
+    unsigned char *stored, *p, *dst;
+    int x, y, k, sx, sy, sbpp, cbpp;
+    unsigned int v;
+
+    sbpp = format->bits / 8;
+    cbpp = format->cmapbits / 8;
+
+    c->width = width;
+    c->height = height;
+    c->bpp = cbpp ? cbpp : sbpp;
+    c->pixels = malloc(width * height * c->bpp);
+    stored = malloc(width * height * sbpp);
+
+    // Worst case RLE output is one header byte per pixel
+    c->file = malloc(18 + PALETTE_SIZE * 4 + width * height * (sbpp + 1));
+
+    if (!c->pixels || !stored || !c->file)
+    {
+        free(stored);
+        return GL_FALSE;
+    }
+
+    for (k = 0;  k < PALETTE_SIZE;  k++)
+    {
+        v = hash(k + 12345);
+        palette[k * 4 + 0] = v & 255;
+        palette[k * 4 + 1] = (v >> 8) & 255;
+        palette[k * 4 + 2] = (v >> 16) & 255;
+        palette[k * 4 + 3] = (v >> 24) & 255;
+    }
+
+    // Expected pixels are in RGB(A) order with the bottom row first, and
+    // the stored pixels are laid out according to the origin
+    for (y = 0;  y < height;  y++)
+    {
+        for (x = 0;  x < width;  x++)
+        {
+            v = pattern(x, y);
+            p = c->pixels + (y * width + x) * c->bpp;
+
+            sx = (origin & 1) ? width - 1 - x : x;
+            sy = (origin & 2) ? height - 1 - y : y;
+            dst = stored + (sy * width + sx) * sbpp;
+
+            if (cbpp)
+            {
+                *dst = (unsigned char) (v % PALETTE_SIZE);
+                memcpy(p, palette + *dst * 4, cbpp);
+            }
+            else
+            {
+                for (k = 0;  k < sbpp;  k++)
+                    p[k] = (v >> (k * 8)) & 255;
+
+                memcpy(dst, p, sbpp);
+                if (sbpp >= 3)
+                {
+                    dst[0] = p[2];
+                    dst[2] = p[0];
+                }
+            }
+        }
+    }
+
+    p = c->file;
+    memset(p, 0, 18);
+    p[1] = cbpp ? 1 : 0;
+    p[2] = (unsigned char) (format->type | (rle ? 8 : 0));
+    if (cbpp)
+    {
+        p[5] = PALETTE_SIZE & 255;
+        p[6] = PALETTE_SIZE >> 8;
+        p[7] = (unsigned char) format->cmapbits;
+    }
+    p[12] = width & 255;
+    p[13] = width >> 8;
+    p[14] = height & 255;
+    p[15] = height >> 8;
+    p[16] = (unsigned char) format->bits;
+    p[17] = (unsigned char) ((origin << 4) | (sbpp == 4 ? 8 : 0));
+    p += 18;
+
+    if (cbpp)
+    {
+        for (k = 0;  k < PALETTE_SIZE;  k++)
+        {
+            *p++ = palette[k * 4 + 2];
+            *p++ = palette[k * 4 + 1];
+            *p++ = palette[k * 4 + 0];
+            if (cbpp == 4)
+                *p++ = palette[k * 4 + 3];
+        }
+    }
+
+    if (rle)
+    {
+        for (y = 0;  y < height;  y++)
+            p = encode_rle(p, stored + y * width * sbpp, width, sbpp);
+    }
+    else
+    {
+        memcpy(p, stored, width * height * sbpp);
+        p += width * height * sbpp;
+    }
+
+    c->size = (long) (p - c->file);
+    free(stored);
+    return GL_TRUE;
+}
+
+//========================================================================
+// Compare a decoded image with the expected pixels
+//========================================================================
+
+static int check_image(const Case* c, const GLFWimage* img, int flipped)
+{
+    int y, row;
+
+    if (img->Width != c->width || img->Height != c->height ||
+        img->BytesPerPixel != c->bpp)
+    {
+        return GL_FALSE;
+    }
+
+    for (y = 0;  y < c->height;  y++)
+    {
+        row = flipped ? c->height - 1 - y : y;
+        if (memcmp(img->Data + y * img->RowStride,
+                   c->pixels + row * c->width * c->bpp,
+                   c->width * c->bpp) != 0)
+        {
+            return GL_FALSE;
+        }
+    }
+
+    return GL_TRUE;
+}
+
+//========================================================================
+// Compare the bound texture with the image it was uploaded from
+//========================================================================
+
+static int check_texture(const GLFWimage* img)
+{
+    unsigned char* data;
+    GLint width, height;
+    int y, ok = GL_TRUE;
+
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+    if (width != img->Width || height != img->Height)
+        return GL_FALSE;
+
+    data = malloc(img->Width * img->Height * img->BytesPerPixel);
+    if (!data)
+        return GL_FALSE;
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glGetTexImage(GL_TEXTURE_2D, 0, img->Format, GL_UNSIGNED_BYTE, data);
+
+    for (y = 0;  y < img->Height;  y++)
+    {
+        if (memcmp(data + y * img->Width * img->BytesPerPixel,
+                   img->Data + y * img->RowStride,
+                   img->Width * img->BytesPerPixel) != 0)
+        {
+            ok = GL_FALSE;
+            break;
+        }
+    }
+
+    free(data);
+    return ok;
+}
+
+//========================================================================
+// Time repeated reads of a file
+//========================================================================
+
+static int time_read(Stage* stage, const Case* c, int flags)
+{
+    GLFWimage img;
+    double start = get_time(), elapsed;
+
+    stage->iterations = 0;
+    do
+    {
+        if (!glfwReadMemoryImage(c->file, c->size, &img, flags))
+            return GL_FALSE;
+
+        glfwFreeImage(&img);
+
+        stage->iterations++;
+        elapsed = get_time() - start;
+    }
+    while (elapsed < min_time);
+
+    stage->seconds = elapsed / stage->iterations;
+    return GL_TRUE;
+}
+
+//========================================================================
+// Time repeated uploads of an image (uploads may halve the image, so
+// each one is given a fresh copy)
+//========================================================================
+
+static int time_upload(Stage* stage, const GLFWimage* img, int flags)
+{
+    GLFWimage copy;
+    long size = (long) img->Height * img->RowStride;
+    double start, elapsed = 0.0;
+
+    copy.Data = malloc(size);
+    if (!copy.Data)
+        return GL_FALSE;
+
+    stage->iterations = 0;
+    do
+    {
+        unsigned char* data = copy.Data;
+
+        copy = *img;
+        copy.Data = data;
+        memcpy(copy.Data, img->Data, size);
+
+        start = get_time();
+        if (!glfwLoadTextureImage2D(&copy, flags))
+        {
+            free(copy.Data);
+            return GL_FALSE;
+        }
+        glFinish();
+        elapsed += get_time() - start;
+
+        stage->iterations++;
+    }
+    while (elapsed < min_time);
+
+    free(copy.Data);
+    stage->seconds = elapsed / stage->iterations;
+    return GL_TRUE;
+}
+
+//========================================================================
+// Time repeated full loads of a file
+//========================================================================
+
+static int time_load(Stage* stage, const Case* c)
+{
+    double start = get_time(), elapsed;
+
+    stage->iterations = 0;
+    do
+    {
+        if (!glfwLoadMemoryTexture2D(c->file, c->size, GLFW_BUILD_MIPMAPS_BIT))
+            return GL_FALSE;
+
+        glFinish();
+
+        stage->iterations++;
+        elapsed = get_time() - start;
+    }
+    while (elapsed < min_time);
+
+    stage->seconds = elapsed / stage->iterations;
+    return GL_TRUE;
+}
+
+static void print_stage(FILE* file, const char* name, double seconds,
+                        int iterations, long bytes)
+{
+    double mbps = 0.0;
+
+    if (seconds < 0.0)
+        seconds = 0.0;
+    if (seconds > 0.0)
+        mbps = bytes / seconds / 1e6;
+
+    fprintf(file, ",\n      \"%s\": { \"ms\": %.6f, \"mbps\": %.1f, "
+                  "\"iterations\": %i }",
+            name, seconds * 1e3, mbps, iterations);
+}
+
+static void print_string(FILE* file, const char* string)
+{
+    fputc('"', file);
+    for (;  *string;  string++)
+    {
+        if (*string == '"' || *string == '\\')
+            fputc('\\', file);
+        if ((unsigned char) *string >= ' ')
+            fputc(*string, file);
+    }
+    fputc('"', file);
+}
+
+//========================================================================
+// Run all stages for one case and print its results
+//========================================================================
+
+static void run_case(FILE* file, const Format* format, int rle, int origin,
+                     int width, int height, int gl, int first)
+{
+    Case c;
+    GLFWimage img, scaled;
+    Stage decode, read, upload, mipmaps, total;
+    int correct = GL_TRUE;
+    long bytes, scaledBytes = 0;
+
+    if (!generate(&c, format, rle, origin, width, height))
+    {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+
+    // Check the decoded pixels in both row orders
+    if (glfwReadMemoryImage(c.file, c.size, &img, GLFW_NO_RESCALE_BIT))
+    {
+        correct = check_image(&c, &img, GL_FALSE);
+        glfwFreeImage(&img);
+    }
+    else
+        correct = GL_FALSE;
+
+    if (glfwReadMemoryImage(c.file, c.size, &img,
+                            GLFW_NO_RESCALE_BIT | GLFW_ORIGIN_UL_BIT))
+    {
+        correct = correct && check_image(&c, &img, GL_TRUE);
+        glfwFreeImage(&img);
+    }
+    else
+        correct = GL_FALSE;
+
+    if (!time_read(&decode, &c, GLFW_NO_RESCALE_BIT) ||
+        !time_read(&read, &c, 0) ||
+        !glfwReadMemoryImage(c.file, c.size, &scaled, 0))
+    {
+        correct = GL_FALSE;
+        gl = GL_FALSE;
+    }
+    else
+        scaledBytes = (long) scaled.Width * scaled.Height * scaled.BytesPerPixel;
+
+    if (gl)
+    {
+        if (!time_upload(&upload, &scaled, 0) || !check_texture(&scaled) ||
+            !time_upload(&mipmaps, &scaled, GLFW_BUILD_MIPMAPS_BIT) ||
+            !time_load(&total, &c))
+        {
+            correct = GL_FALSE;
+            gl = GL_FALSE;
+        }
+    }
+
+    if (!correct)
+    {
+        fprintf(stderr, "%s %s %s %ix%i: incorrect result\n",
+                format->name, rle ? "rle" : "raw", origins[origin],
+                width, height);
+        failures++;
+    }
+
+    bytes = (long) width * height * c.bpp;
+
+    fprintf(file, "%s\n    {\n", first ? "" : ",");
+    fprintf(file, "      \"format\": \"%s\", \"rle\": %s, \"origin\": \"%s\", "
+                  "\"width\": %i, \"height\": %i, \"file_bytes\": %li, "
+                  "\"correct\": %s",
+            format->name, rle ? "true" : "false", origins[origin],
+            width, height, c.size, correct ? "true" : "false");
+
+    if (scaledBytes)
+    {
+        print_stage(file, "decode", decode.seconds, decode.iterations, bytes);
+        print_stage(file, "rescale", read.seconds - decode.seconds,
+                    read.iterations, bytes);
+    }
+    if (gl)
+    {
+        print_stage(file, "upload", upload.seconds, upload.iterations,
+                    scaledBytes);
+        print_stage(file, "mipmaps", mipmaps.seconds - upload.seconds,
+                    mipmaps.iterations, scaledBytes);
+        print_stage(file, "total", total.seconds, total.iterations, bytes);
+    }
+
+    fprintf(file, "\n    }");
+
+    if (scaledBytes)
+        glfwFreeImage(&scaled);
+
+    free(c.pixels);
+    free(c.file);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, f, rle, origin, s, gl = GL_TRUE, first = GL_TRUE;
+    int major, minor, rev;
+    GLuint texture;
+    FILE* file = stdout;
+
+    while ((ch = getopt(argc, argv, "ght:o:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(0);
+
+            case 'g':
+                gl = GL_FALSE;
+                break;
+
+            case 't':
+                min_time = atof(optarg);
+                break;
+
+            case 'o':
+                file = fopen(optarg, "w");
+                if (!file)
+                {
+                    fprintf(stderr, "Failed to open %s\n", optarg);
+                    exit(1);
+                }
+                break;
+
+            default:
+                usage();
+                exit(1);
+        }
+    }
+
+    // Image functions work without glfwInit, so a missing display only
+    // rules out the texture stages
+    use_timer = glfwInit();
+    if (!use_timer)
+    {
+        fprintf(stderr, "Failed to initialize GLFW, skipping texture stages\n");
+        gl = GL_FALSE;
+    }
+
+    if (gl && !glfwOpenWindow(64, 64, 8, 8, 8, 8, 0, 0, GLFW_WINDOW))
+    {
+        fprintf(stderr, "Failed to open GLFW window, skipping texture stages\n");
+        gl = GL_FALSE;
+    }
+
+    glfwGetVersion(&major, &minor, &rev);
+
+    fprintf(file, "{\n  \"glfw\": \"%i.%i.%i\",\n  \"min_time\": %g,\n",
+            major, minor, rev, min_time);
+
+    if (gl)
+    {
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+
+        fprintf(file, "  \"renderer\": ");
+        print_string(file, (const char*) glGetString(GL_RENDERER));
+        fprintf(file, ",\n  \"auto_mipmaps\": %s,\n",
+                glfwExtensionSupported("GL_SGIS_generate_mipmap") ?
+                "true" : "false");
+    }
+    else
+        fprintf(file, "  \"renderer\": null,\n");
+
+    fprintf(file, "  \"cases\": [");
+
+    for (s = 0;  s < (int) (sizeof(sizes) / sizeof(sizes[0]));  s++)
+    {
+        for (f = 0;  f < (int) (sizeof(formats) / sizeof(formats[0]));  f++)
+        {
+            for (rle = 0;  rle < 2;  rle++)
+            {
+                for (origin = 0;  origin < 4;  origin++)
+                {
+                    run_case(file, formats + f, rle, origin,
+                             sizes[s][0], sizes[s][1], gl, first);
+                    first = GL_FALSE;
+                }
+            }
+        }
+    }
+
+    fprintf(file, "\n  ],\n  \"failures\": %i\n}\n", failures);
+
+    if (file != stdout)
+        fclose(file);
+
+    if (gl)
+        glDeleteTextures(1, &texture);
+
+    glfwTerminate();
+    exit(failures ? 1 : 0);
+}